@@ -10,8 +10,9 @@
 #ifndef ROTE_HPP
 #define ROTE_HPP
 
-#include "rote/builtin.hpp"
+// config.h defines HAVE_OPENMP, which builtin.hpp keys its OpenMP macros on
 #include "rote/config.h"
+#include "rote/builtin.hpp"
 #include "rote/types.hpp"
 #include "rote/forward_decl.hpp"
 #include "rote/core.hpp"
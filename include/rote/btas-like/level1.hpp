@@ -10,6 +10,9 @@
 #ifndef ROTE_BTAS_LEVEL1_HPP
 #define ROTE_BTAS_LEVEL1_HPP
 
+#include "level1/LoopNest.hpp"
+#include "level1/Elemwise.hpp"
+#include "level1/Transpose.hpp"
 #include "level1/Zero.hpp"
 #include "level1/Diff.hpp"
 #include "level1/Elemscal.hpp"
@@ -0,0 +1,307 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#pragma once
+#ifndef ROTE_BTAS_ELEMWISE_HPP
+#define ROTE_BTAS_ELEMWISE_HPP
+
+namespace rote{
+
+// Expression templates for fused elementwise updates of local tensors, e.g.
+//
+//   ElemAssign(Z, alpha*Elem(X) + beta*Elem(Y, permYToZ) - Elem(W));
+//
+// evaluates the whole right-hand side in one pass over Z.  Modes every
+// operand traverses contiguously are merged (as in LoopNestApply), the
+// innermost loop is vectorized when every operand has unit stride there,
+// and large nests are split across OpenMP threads.  Each element of the
+// destination is read before it is written, so the destination may appear
+// in its own expression.
+
+////////////////////////////////////
+// Expression nodes
+////////////////////////////////////
+
+template<typename E>
+struct ElemExpr{
+    const E& Self() const { return static_cast<const E&>(*this); }
+};
+
+// A strided operand, its strides given in the destination's mode order
+template<typename T>
+struct ElemOperand : public ElemExpr<ElemOperand<T> >{
+    typedef T value_type;
+
+    ElemOperand(const T * const buf_, const std::vector<Unsigned>& strides_)
+    : buf(buf_), strides(strides_) { }
+
+    // Reads the operand through the merged loop strides
+    struct Kernel{
+        const T* buf;
+        const Unsigned* strides;
+
+        T operator()(Unsigned i) const { return buf[i * strides[0]]; }
+        T Unit(Unsigned i) const { return buf[i]; }
+        Kernel Shift(Unsigned mode, Unsigned i) const {
+            Kernel k = {&(buf[i * strides[mode]]), strides};
+            return k;
+        }
+    };
+
+    void Strides(std::vector<const std::vector<Unsigned>*>& all) const { all.push_back(&strides); }
+
+    Kernel Bind(const Unsigned * const * const loopStrides, Unsigned& operand) const {
+        Kernel k = {buf, loopStrides[operand++]};
+        return k;
+    }
+
+    const T* buf;
+    std::vector<Unsigned> strides;
+};
+
+template<typename T>
+struct ElemConstant : public ElemExpr<ElemConstant<T> >{
+    typedef T value_type;
+
+    explicit ElemConstant(T val_)
+    : val(val_) { }
+
+    struct Kernel{
+        T val;
+
+        T operator()(Unsigned) const { return val; }
+        T Unit(Unsigned) const { return val; }
+        Kernel Shift(Unsigned, Unsigned) const { return *this; }
+    };
+
+    void Strides(std::vector<const std::vector<Unsigned>*>&) const { }
+
+    Kernel Bind(const Unsigned * const * const, Unsigned&) const {
+        Kernel k = {val};
+        return k;
+    }
+
+    T val;
+};
+
+struct ElemAdd{
+    template<typename T>
+    static inline T Apply(const T& a, const T& b){ return a + b; }
+};
+
+struct ElemSub{
+    template<typename T>
+    static inline T Apply(const T& a, const T& b){ return a - b; }
+};
+
+struct ElemMul{
+    template<typename T>
+    static inline T Apply(const T& a, const T& b){ return a * b; }
+};
+
+template<typename Op, typename L, typename R>
+struct ElemBinary : public ElemExpr<ElemBinary<Op, L, R> >{
+    typedef typename L::value_type value_type;
+
+    ElemBinary(const L& l_, const R& r_)
+    : l(l_), r(r_) { }
+
+    struct Kernel{
+        typename L::Kernel l;
+        typename R::Kernel r;
+
+        value_type operator()(Unsigned i) const { return Op::Apply(l(i), r(i)); }
+        value_type Unit(Unsigned i) const { return Op::Apply(l.Unit(i), r.Unit(i)); }
+        Kernel Shift(Unsigned mode, Unsigned i) const {
+            Kernel k = {l.Shift(mode, i), r.Shift(mode, i)};
+            return k;
+        }
+    };
+
+    void Strides(std::vector<const std::vector<Unsigned>*>& all) const {
+        l.Strides(all);
+        r.Strides(all);
+    }
+
+    //NOTE: Braced initializers are evaluated in order, so operands are
+    //bound in the order Strides() lists them
+    Kernel Bind(const Unsigned * const * const loopStrides, Unsigned& operand) const {
+        Kernel k = {l.Bind(loopStrides, operand), r.Bind(loopStrides, operand)};
+        return k;
+    }
+
+    L l;
+    R r;
+};
+
+template<typename L, typename R>
+inline ElemBinary<ElemAdd, L, R>
+operator+(const ElemExpr<L>& l, const ElemExpr<R>& r){
+    return ElemBinary<ElemAdd, L, R>(l.Self(), r.Self());
+}
+
+template<typename L, typename R>
+inline ElemBinary<ElemSub, L, R>
+operator-(const ElemExpr<L>& l, const ElemExpr<R>& r){
+    return ElemBinary<ElemSub, L, R>(l.Self(), r.Self());
+}
+
+template<typename L, typename R>
+inline ElemBinary<ElemMul, L, R>
+operator*(const ElemExpr<L>& l, const ElemExpr<R>& r){
+    return ElemBinary<ElemMul, L, R>(l.Self(), r.Self());
+}
+
+template<typename E>
+inline ElemBinary<ElemMul, ElemConstant<typename E::value_type>, E>
+operator*(typename E::value_type alpha, const ElemExpr<E>& e){
+    return ElemBinary<ElemMul, ElemConstant<typename E::value_type>, E>(ElemConstant<typename E::value_type>(alpha), e.Self());
+}
+
+template<typename T>
+inline ElemOperand<T>
+Elem(const T * const buf, const std::vector<Unsigned>& strides){
+    return ElemOperand<T>(buf, strides);
+}
+
+// X read in its own mode order
+template<typename T>
+inline ElemOperand<T>
+Elem(const Tensor<T>& X){
+    return ElemOperand<T>(X.LockedBuffer(), X.Strides());
+}
+
+// X read in the destination's mode order
+template<typename T>
+inline ElemOperand<T>
+Elem(const Tensor<T>& X, const Permutation& permXToY){
+    return ElemOperand<T>(X.LockedBuffer(), permXToY.applyTo(X.Strides()));
+}
+
+////////////////////////////////////
+// Workhorse routines
+////////////////////////////////////
+
+// Order-N nest, mode 0 innermost
+template<Unsigned N>
+struct ElemNest{
+    template<typename T, typename K>
+    static inline void
+    Run(const Unsigned * const shape, const Unsigned * const dstStrides, T * const dst, const K& kernel, bool unit){
+        const Unsigned n = shape[N-1];
+        const Unsigned dstStride = dstStrides[N-1];
+        for(Unsigned i = 0; i < n; i++)
+            ElemNest<N-1>::Run(shape, dstStrides, &(dst[i * dstStride]), kernel.Shift(N-1, i), unit);
+    }
+};
+
+template<>
+struct ElemNest<1>{
+    template<typename T, typename K>
+    static inline void
+    Run(const Unsigned * const shape, const Unsigned * const dstStrides, T * const dst, const K& kernel, bool unit){
+        const Unsigned n = shape[0];
+        if(unit){
+            SIMD_FOR
+            for(Unsigned i = 0; i < n; i++)
+                dst[i] = kernel.Unit(i);
+        }else{
+            const Unsigned dstStride = dstStrides[0];
+            for(Unsigned i = 0; i < n; i++)
+                dst[i * dstStride] = kernel(i);
+        }
+    }
+};
+
+// Runs a merged nest of any order, peeling modes beyond
+// MaxUnrolledLoopOrder
+template<typename T, typename K>
+void RunElemNest(const Unsigned order, const Unsigned * const shape, const Unsigned * const dstStrides,
+                 T * const dst, const K& kernel, bool unit){
+    switch(order){
+        case 0: dst[0] = kernel.Unit(0); break;
+        case 1: ElemNest<1>::Run(shape, dstStrides, dst, kernel, unit); break;
+        case 2: ElemNest<2>::Run(shape, dstStrides, dst, kernel, unit); break;
+        case 3: ElemNest<3>::Run(shape, dstStrides, dst, kernel, unit); break;
+        case 4: ElemNest<4>::Run(shape, dstStrides, dst, kernel, unit); break;
+        case 5: ElemNest<5>::Run(shape, dstStrides, dst, kernel, unit); break;
+        case 6: ElemNest<6>::Run(shape, dstStrides, dst, kernel, unit); break;
+        case 7: ElemNest<7>::Run(shape, dstStrides, dst, kernel, unit); break;
+        case 8: ElemNest<8>::Run(shape, dstStrides, dst, kernel, unit); break;
+        default:
+            for(Unsigned i = 0; i < shape[order-1]; i++)
+                RunElemNest(order - 1, shape, dstStrides, &(dst[i * dstStrides[order-1]]), kernel.Shift(order-1, i), unit);
+    }
+}
+
+// Runs the part of a merged nest SplitLoopNest hands out
+template<typename T, typename K>
+struct ElemNestBody{
+    Unsigned order;
+    const Unsigned * dstStrides;
+    T * dst;
+    const K * kernel;
+    bool unit;
+
+    void operator()(const Unsigned subOrder, const Unsigned * const subShape, const Unsigned i, const Unsigned j) const {
+        K k = *kernel;
+        Unsigned dstOff = 0;
+        if(order >= 1){
+            k = k.Shift(order-1, i);
+            dstOff += i * dstStrides[order-1];
+        }
+        if(order >= 2){
+            k = k.Shift(order-2, j);
+            dstOff += j * dstStrides[order-2];
+        }
+        RunElemNest(subOrder, subShape, dstStrides, &(dst[dstOff]), k, unit);
+    }
+};
+
+// dst := expr over a strided loop nest (mode 0 innermost).  An empty
+// loopShape means a single element.  Large nests are split across OpenMP
+// threads by SplitLoopNest, as in LoopNestApply.
+template<typename T, typename E>
+void ElemAssign(const ObjShape& loopShape, const std::vector<Unsigned>& dstStrides, T * const dst, const ElemExpr<E>& expr){
+    if(AnyZeroElem(loopShape))
+        return;
+    const E& e = expr.Self();
+
+    std::vector<const std::vector<Unsigned>*> strides(1, &dstStrides);
+    e.Strides(strides);
+    const Unsigned maxOrder = std::max<Unsigned>(1, loopShape.size());
+    ObjShape mShape(maxOrder);
+    std::vector<std::vector<Unsigned> > mStrides(strides.size(), std::vector<Unsigned>(maxOrder));
+    std::vector<Unsigned*> mStridePtrs(strides.size());
+    for(Unsigned k = 0; k < strides.size(); k++)
+        mStridePtrs[k] = &(mStrides[k][0]);
+    const Unsigned order = MergeLoopModes(loopShape, &(strides[0]), strides.size(), maxOrder, &(mShape[0]), &(mStridePtrs[0]));
+
+    //Bind the kernel to the merged strides (the destination's come first)
+    std::vector<const Unsigned*> loopStrides(strides.size(), (const Unsigned*)0);
+    bool unit = true;
+    for(Unsigned k = 0; k < strides.size() && order > 0; k++){
+        loopStrides[k] = &(mStrides[k][0]);
+        unit &= mStrides[k][0] == 1;
+    }
+    Unsigned operand = 1;
+    const typename E::Kernel kernel = e.Bind(&(loopStrides[0]), operand);
+
+    const ElemNestBody<T, typename E::Kernel> body = {order, loopStrides[0], dst, &kernel, unit};
+    SplitLoopNest(order, &(mShape[0]), loopStrides[0], prod(loopShape), body);
+}
+
+template<typename T, typename E>
+inline void
+ElemAssign(Tensor<T>& Y, const ElemExpr<E>& expr){
+    ElemAssign(Y.Shape(), Y.Strides(), Y.Buffer(), expr);
+}
+
+} // namespace rote
+
+#endif // ifndef ROTE_BTAS_ELEMWISE_HPP
@@ -0,0 +1,245 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#pragma once
+#ifndef ROTE_BTAS_LOOPNEST_HPP
+#define ROTE_BTAS_LOOPNEST_HPP
+
+namespace rote{
+
+// Deepest (merged) loop nest with a compile-time specialized kernel.
+// Deeper nests run through the generic odometer loop.
+const Unsigned MaxUnrolledLoopOrder = 8;
+
+// Smallest loop nest (in elements) split across OpenMP threads
+const Unsigned ThreadedLoopMinElems = 32768;
+
+////////////////////////////////////
+// Workhorse routines
+////////////////////////////////////
+
+// Drops unit-extent modes and merges each mode into the previous one when
+// all nStrides stride arrays are contiguous across them.  The merged shape
+// and strides go to mShape and mStrides[k], which hold maxOrder entries.
+// Returns the merged order, or maxOrder + 1 if the nest does not fit.
+inline Unsigned
+MergeLoopModes(const ObjShape& shape, const std::vector<Unsigned> * const * const strides, const Unsigned nStrides,
+               const Unsigned maxOrder, Unsigned * const mShape, Unsigned * const * const mStrides){
+    Unsigned i, k;
+    Unsigned order = 0;
+    for(i = 0; i < shape.size(); i++){
+        if(shape[i] == 1)
+            continue;
+        bool merge = order > 0;
+        for(k = 0; k < nStrides && merge; k++)
+            merge = (*strides[k])[i] == mStrides[k][order-1] * mShape[order-1];
+        if(merge){
+            mShape[order-1] *= shape[i];
+            continue;
+        }
+        if(order == maxOrder)
+            return order + 1;
+        mShape[order] = shape[i];
+        for(k = 0; k < nStrides; k++)
+            mStrides[k][order] = (*strides[k])[i];
+        order++;
+    }
+    return order;
+}
+
+// Source/destination form, for nests of at most MaxUnrolledLoopOrder
+inline Unsigned
+MergeLoopModes(const ObjShape& shape, const std::vector<Unsigned>& srcStrides, const std::vector<Unsigned>& dstStrides,
+               Unsigned * const mShape, Unsigned * const mSrcStrides, Unsigned * const mDstStrides){
+    const std::vector<Unsigned> * const strides[2] = {&srcStrides, &dstStrides};
+    Unsigned * const mStrides[2] = {mSrcStrides, mDstStrides};
+    return MergeLoopModes(shape, strides, 2, MaxUnrolledLoopOrder, mShape, mStrides);
+}
+
+// Runs a merged nest of nElems elements (mode 0 innermost) as calls
+// body(subOrder, subShape, i, j), each running the innermost subOrder modes
+// of subShape offset by i along mode order-1 and by j along mode order-2.
+//
+// In OpenMP builds, large nests outside a parallel region are split across
+// threads along the outermost merged mode (and the one below it when the
+// outermost is too short to balance the threads).  A single merged mode is
+// cut into one contiguous block per thread.  Modes the destination does not
+// advance along (stride 0, as for the reduced modes of LocalReduce) are never
+// split, since threads would update the same elements; nests whose outermost
+// merged mode is such a mode run serially.
+template<typename Body>
+void SplitLoopNest(const Unsigned order, const Unsigned * const shape, const Unsigned * const dstStrides,
+                   const Unsigned nElems, const Body& body){
+#ifdef HAVE_OPENMP
+    const Unsigned nThreads = omp_get_max_threads();
+    if(order >= 1 && nThreads > 1 && !omp_in_parallel() && nElems >= ThreadedLoopMinElems && dstStrides[order-1] != 0){
+        const Unsigned outer = order - 1;
+        if(order == 1){
+            //One contiguous block per thread
+            const Unsigned blkSize = IntCeil(shape[0], nThreads);
+            PARALLEL_FOR
+            for(Unsigned t = 0; t < nThreads; t++){
+                const Unsigned start = std::min(t * blkSize, shape[0]);
+                const Unsigned blkShape[1] = {std::min(blkSize, shape[0] - start)};
+                body(1, blkShape, start, 0);
+            }
+        }else if(order >= 3 && shape[outer] < 4 * nThreads && dstStrides[outer-1] != 0){
+            const Unsigned inner = outer - 1;
+            const Unsigned nTasks = shape[outer] * shape[inner];
+            PARALLEL_FOR
+            for(Unsigned task = 0; task < nTasks; task++)
+                body(inner, shape, task / shape[inner], task % shape[inner]);
+        }else{
+            PARALLEL_FOR
+            for(Unsigned i = 0; i < shape[outer]; i++)
+                body(outer, shape, i, 0);
+        }
+        return;
+    }
+#endif
+
+    body(order, shape, 0, 0);
+}
+
+// Order-N loop nest over fixed-size shape/stride arrays, mode 0 innermost.
+// The innermost loop has a unit-stride variant and a constant-stride one,
+// both of which the compiler can vectorize.
+template<Unsigned N>
+struct LoopNest{
+    template<typename S, typename D, typename Op>
+    static inline void
+    Run(const Unsigned * const shape, const Unsigned * const srcStrides, const Unsigned * const dstStrides,
+        S * const src, D * const dst, const Op& op){
+        const Unsigned n = shape[N-1];
+        const Unsigned srcStride = srcStrides[N-1];
+        const Unsigned dstStride = dstStrides[N-1];
+        for(Unsigned i = 0; i < n; i++)
+            LoopNest<N-1>::Run(shape, srcStrides, dstStrides, &(src[i * srcStride]), &(dst[i * dstStride]), op);
+    }
+};
+
+template<>
+struct LoopNest<1>{
+    template<typename S, typename D, typename Op>
+    static inline void
+    Run(const Unsigned * const shape, const Unsigned * const srcStrides, const Unsigned * const dstStrides,
+        S * const src, D * const dst, const Op& op){
+        const Unsigned n = shape[0];
+        if(srcStrides[0] == 1 && dstStrides[0] == 1){
+            for(Unsigned i = 0; i < n; i++)
+                op(dst[i], src[i]);
+        }else{
+            const Unsigned srcStride = srcStrides[0];
+            const Unsigned dstStride = dstStrides[0];
+            for(Unsigned i = 0; i < n; i++)
+                op(dst[i * dstStride], src[i * srcStride]);
+        }
+    }
+};
+
+// Odometer loop for nests deeper than MaxUnrolledLoopOrder
+template<typename S, typename D, typename Op>
+void LoopNestGeneric(const ObjShape& loopEnd, const std::vector<Unsigned>& srcBufStrides, const std::vector<Unsigned>& dstBufStrides,
+                     S * const srcBuf, D * const dstBuf, const Op& op){
+    const Unsigned order = loopEnd.size();
+    Location curLoc(order, 0);
+    Unsigned srcBufPtr = 0;
+    Unsigned dstBufPtr = 0;
+    Unsigned ptr = 0;
+
+    while(true){
+        op(dstBuf[dstBufPtr], srcBuf[srcBufPtr]);
+        //Update
+        curLoc[ptr]++;
+        dstBufPtr += dstBufStrides[ptr];
+        srcBufPtr += srcBufStrides[ptr];
+        while(curLoc[ptr] >= loopEnd[ptr]){
+            curLoc[ptr] = 0;
+
+            dstBufPtr -= dstBufStrides[ptr] * loopEnd[ptr];
+            srcBufPtr -= srcBufStrides[ptr] * loopEnd[ptr];
+            ptr++;
+            if(ptr >= order)
+                return;
+            curLoc[ptr]++;
+            dstBufPtr += dstBufStrides[ptr];
+            srcBufPtr += srcBufStrides[ptr];
+        }
+        ptr = 0;
+    }
+}
+
+// Runs a merged nest of order at most MaxUnrolledLoopOrder
+template<typename S, typename D, typename Op>
+inline void
+RunLoopNest(const Unsigned order, const Unsigned * const shape, const Unsigned * const srcStrides, const Unsigned * const dstStrides,
+            S * const src, D * const dst, const Op& op){
+    switch(order){
+        case 0: op(dst[0], src[0]); break;
+        case 1: LoopNest<1>::Run(shape, srcStrides, dstStrides, src, dst, op); break;
+        case 2: LoopNest<2>::Run(shape, srcStrides, dstStrides, src, dst, op); break;
+        case 3: LoopNest<3>::Run(shape, srcStrides, dstStrides, src, dst, op); break;
+        case 4: LoopNest<4>::Run(shape, srcStrides, dstStrides, src, dst, op); break;
+        case 5: LoopNest<5>::Run(shape, srcStrides, dstStrides, src, dst, op); break;
+        case 6: LoopNest<6>::Run(shape, srcStrides, dstStrides, src, dst, op); break;
+        case 7: LoopNest<7>::Run(shape, srcStrides, dstStrides, src, dst, op); break;
+        default: LoopNest<8>::Run(shape, srcStrides, dstStrides, src, dst, op);
+    }
+}
+
+// Runs the part of a merged source/destination nest SplitLoopNest hands out
+template<typename S, typename D, typename Op>
+struct LoopNestBody{
+    Unsigned order;
+    const Unsigned * srcStrides;
+    const Unsigned * dstStrides;
+    S * src;
+    D * dst;
+    const Op * op;
+
+    void operator()(const Unsigned subOrder, const Unsigned * const subShape, const Unsigned i, const Unsigned j) const {
+        Unsigned srcOff = 0;
+        Unsigned dstOff = 0;
+        if(order >= 1){
+            srcOff += i * srcStrides[order-1];
+            dstOff += i * dstStrides[order-1];
+        }
+        if(order >= 2){
+            srcOff += j * srcStrides[order-2];
+            dstOff += j * dstStrides[order-2];
+        }
+        RunLoopNest(subOrder, subShape, srcStrides, dstStrides, &(src[srcOff]), &(dst[dstOff]), *op);
+    }
+};
+
+// Applies op(dstElem, srcElem) to every element of a strided loop nest
+// (mode 0 innermost).  An empty loopShape means a single element.  Unary
+// kernels pass the destination as the source as well.  Large nests are
+// split across OpenMP threads by SplitLoopNest.
+template<typename S, typename D, typename Op>
+void LoopNestApply(const ObjShape& loopShape, const std::vector<Unsigned>& srcStrides, const std::vector<Unsigned>& dstStrides,
+                   S * const src, D * const dst, const Op& op){
+    if(AnyZeroElem(loopShape))
+        return;
+
+    Unsigned shape[MaxUnrolledLoopOrder];
+    Unsigned srcStr[MaxUnrolledLoopOrder];
+    Unsigned dstStr[MaxUnrolledLoopOrder];
+    const Unsigned order = MergeLoopModes(loopShape, srcStrides, dstStrides, shape, srcStr, dstStr);
+    if(order > MaxUnrolledLoopOrder){
+        LoopNestGeneric(loopShape, srcStrides, dstStrides, src, dst, op);
+        return;
+    }
+
+    const LoopNestBody<S, D, Op> body = {order, srcStr, dstStr, src, dst, &op};
+    SplitLoopNest(order, shape, dstStr, prod(loopShape), body);
+}
+
+} // namespace rote
+
+#endif // ifndef ROTE_BTAS_LOOPNEST_HPP
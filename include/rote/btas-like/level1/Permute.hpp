@@ -18,126 +18,17 @@ namespace rote{
 
 template<typename T>
 void PackCommHelper_fast(const PackData& packData, T const * const srcBuf, T * const dstBuf){
-    if(packData.loopShape.size() == 0){
-        dstBuf[0] = srcBuf[0];
+    //Element-wise copies would store (or load) with a stride here
+    if(BlockedTranspose(packData, srcBuf, dstBuf))
         return;
-    }
-
-    const std::vector<Unsigned> loopEnd = packData.loopShape;
-    const std::vector<Unsigned> dstBufStrides = packData.dstBufStrides;
-    const std::vector<Unsigned> srcBufStrides = packData.srcBufStrides;
-    Unsigned order = loopEnd.size();
-    Location curLoc(order,0);
-    Unsigned dstBufPtr = 0;
-    Unsigned srcBufPtr = 0;
-    Unsigned ptr = 0;
-
-    if(loopEnd.size() == 0){
-        dstBuf[0] = srcBuf[0];
-        return;
-    }
-
-    bool done = !ElemwiseLessThan(curLoc, loopEnd);
-
-    if (srcBufStrides[0] == 1 && dstBufStrides[0] == 1) {
-        while (!done) {
-            MemCopy(&(dstBuf[dstBufPtr]), &(srcBuf[srcBufPtr]), loopEnd[0]);
-            curLoc[0] += loopEnd[0];
-            srcBufPtr += srcBufStrides[0] * (loopEnd[0]);
-            dstBufPtr += dstBufStrides[0] * (loopEnd[0]);
-
-            while (ptr < order && curLoc[ptr] >= loopEnd[ptr]) {
-                curLoc[ptr] = 0;
-
-                dstBufPtr -= dstBufStrides[ptr] * loopEnd[ptr];
-                srcBufPtr -= srcBufStrides[ptr] * loopEnd[ptr];
-                ptr++;
-                if (ptr >= order) {
-                    done = true;
-                    break;
-                } else {
-                    curLoc[ptr]++;
-                    dstBufPtr += dstBufStrides[ptr];
-                    srcBufPtr += srcBufStrides[ptr];
-                }
-            }
-            if (done)
-                break;
-            ptr = 0;
-        }
-    } else {
-        while (!done) {
-            dstBuf[dstBufPtr] = srcBuf[srcBufPtr];
-            //Update
-            curLoc[0]++;
-            dstBufPtr += dstBufStrides[0];
-            srcBufPtr += srcBufStrides[0];
-
-            while (ptr < order && curLoc[ptr] >= loopEnd[ptr]) {
-                curLoc[ptr] = 0;
-
-                dstBufPtr -= dstBufStrides[ptr] * loopEnd[ptr];
-                srcBufPtr -= srcBufStrides[ptr] * loopEnd[ptr];
-                ptr++;
-                if (ptr >= order) {
-                    done = true;
-                    break;
-                } else {
-                    curLoc[ptr]++;
-                    dstBufPtr += dstBufStrides[ptr];
-                    srcBufPtr += srcBufStrides[ptr];
-                }
-            }
-            if (done)
-                break;
-            ptr = 0;
-        }
-    }
+    LoopNestApply(packData.loopShape, packData.srcBufStrides, packData.dstBufStrides, srcBuf, dstBuf,
+                  [](T& dst, const T& src){ dst = src; });
 }
 
+//NOTE: Mode merging happens in LoopNestApply
 template<typename T>
 void PackCommHelper(const PackData& packData, T const * const srcBuf, T * const dstBuf){
-//    PROFILE_SECTION("Pack");
-    PackData modifiedData = packData;
-    modifiedData.loopShape = packData.loopShape;
-
-
-    //Attempt to merge modes
-    PackData newData;
-    Unsigned i;
-    Unsigned oldOrder = packData.loopShape.size();
-
-    if(oldOrder == 0){
-        newData = modifiedData;
-    }else{
-        newData.loopShape.push_back(modifiedData.loopShape[0]);
-        newData.srcBufStrides.push_back(modifiedData.srcBufStrides[0]);
-        newData.dstBufStrides.push_back(modifiedData.dstBufStrides[0]);
-        Unsigned srcStrideToMatch = modifiedData.srcBufStrides[0] * modifiedData.loopShape[0];
-        Unsigned dstStrideToMatch = modifiedData.dstBufStrides[0] * modifiedData.loopShape[0];
-
-        Unsigned mergeMode = 0;
-        for(i = 1; i < oldOrder; i++){
-            if(modifiedData.srcBufStrides[i] == srcStrideToMatch &&
-               modifiedData.dstBufStrides[i] == dstStrideToMatch){
-                newData.loopShape[mergeMode] *= modifiedData.loopShape[i];
-                srcStrideToMatch *= modifiedData.loopShape[i];
-                dstStrideToMatch *= modifiedData.loopShape[i];
-            }else{
-                newData.loopShape.push_back(modifiedData.loopShape[i]);
-                newData.srcBufStrides.push_back(modifiedData.srcBufStrides[i]);
-                newData.dstBufStrides.push_back(modifiedData.dstBufStrides[i]);
-                srcStrideToMatch = modifiedData.srcBufStrides[i] * modifiedData.loopShape[i];
-                dstStrideToMatch = modifiedData.dstBufStrides[i] * modifiedData.loopShape[i];
-                mergeMode++;
-            }
-        }
-    }
-
-//    PrintPackData(newData, "packData");
-    PackCommHelper_fast(newData, srcBuf, dstBuf);
-
-//    PROFILE_STOP;
+    PackCommHelper_fast(packData, srcBuf, dstBuf);
 }
 
 ////////////////////////////////////
@@ -18,42 +18,8 @@ namespace rote{
 
 template <typename T>
 void LocalReduceElemSelect_merged(const T alpha, const ObjShape& sB, T const * const a, const std::vector<Unsigned>& stA, T * const b, const std::vector<Unsigned>& stB){
-  Unsigned o = sB.size();
-  Location l(o, 0);
-  Unsigned p = 0;
-  Unsigned pA = 0;
-  Unsigned pB = 0;
-
-  if(o == 0){
-      b[0] += alpha * a[0];
-      return;
-  }
-
-  while(p < o){
-    b[pB] += alpha * a[pA];
-
-    //Update
-    l[p]++;
-    pA += stA[p];
-    pB += stB[p];
-    while(l[p] >= sB[p]){
-      l[p] = 0;
-      pA -= stA[p] * sB[p];
-      pB -= stB[p] * sB[p];
-
-      p++;
-      if(p >= o){
-        break;
-      }
-      l[p]++;
-      pA += stA[p];
-      pB += stB[p];
-    }
-    if (p == o) {
-      break;
-    }
-    p = 0;
-  }
+  LoopNestApply(sB, stA, stB, a, b,
+                [alpha](T& dst, const T& src){ dst += alpha * src; });
 }
 
 ////////////////////////////////////
@@ -19,48 +19,11 @@ namespace rote {
 template<typename T>
 inline void
 Scal_fast(T alpha, T * srcBuf, const ScalData& data ){
-    const std::vector<Unsigned> loopEnd = data.loopShape;
-    const std::vector<Unsigned> srcBufStrides = data.srcStrides;
-    Unsigned srcBufPtr = 0;
-    Unsigned order = loopEnd.size();
-    Location curLoc(order, 0);
-    Unsigned ptr = 0;
-
     if(alpha == T(0)){
-        Zero_fast(loopEnd, srcBufStrides, srcBuf);
+        Zero_fast(data.loopShape, data.srcStrides, srcBuf);
     }else if(alpha == T(1)){
-
     }else{
-        if(order == 0){
-            srcBuf[0] *= alpha;
-            return;
-        }
-
-        bool done = !ElemwiseLessThan(curLoc, loopEnd);
-
-        while(!done){
-
-            srcBuf[srcBufPtr] *= alpha;
-            //Update
-            curLoc[ptr]++;
-            srcBufPtr += srcBufStrides[ptr];
-            while(ptr < order && curLoc[ptr] >= loopEnd[ptr]){
-                curLoc[ptr] = 0;
-
-                srcBufPtr -= srcBufStrides[ptr] * (loopEnd[ptr]);
-                ptr++;
-                if(ptr >= order){
-                    done = true;
-                    break;
-                }else{
-                    curLoc[ptr]++;
-                    srcBufPtr += srcBufStrides[ptr];
-                }
-            }
-            if(done)
-                break;
-            ptr = 0;
-        }
+        ElemAssign(data.loopShape, data.srcStrides, srcBuf, alpha*Elem(srcBuf, data.srcStrides));
     }
 }
 
@@ -18,42 +18,7 @@ namespace rote {
 
 template<typename T>
 void SetAllVal_fast(const ObjShape& shape, const std::vector<Unsigned>& strides, T * const buf, T val){
-    const std::vector<Unsigned> loopEnd = shape;
-    const std::vector<Unsigned> bufStrides = strides;
-    Unsigned bufPtr = 0;
-    Unsigned order = loopEnd.size();
-    Location curLoc(order, 0);
-    Unsigned ptr = 0;
-
-    if(loopEnd.size() == 0){
-        buf[0] = val;
-        return;
-    }
-
-    bool done = !ElemwiseLessThan(curLoc, loopEnd);
-
-    while(!done){
-        buf[bufPtr] = val;
-        //Update
-        curLoc[ptr]++;
-        bufPtr += bufStrides[ptr];
-        while(ptr < order && curLoc[ptr] >= loopEnd[ptr]){
-            curLoc[ptr] = 0;
-
-            bufPtr -= bufStrides[ptr] * (loopEnd[ptr]);
-            ptr++;
-            if(ptr >= order){
-                done = true;
-                break;
-            }else{
-                curLoc[ptr]++;
-                bufPtr += bufStrides[ptr];
-            }
-        }
-        if(done)
-            break;
-        ptr = 0;
-    }
+    ElemAssign(shape, strides, buf, ElemConstant<T>(val));
 }
 
 ////////////////////////////////////
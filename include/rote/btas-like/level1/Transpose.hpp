@@ -0,0 +1,134 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#pragma once
+#ifndef ROTE_BTAS_TRANSPOSE_HPP
+#define ROTE_BTAS_TRANSPOSE_HPP
+
+namespace rote{
+
+// Edge (in elements) of the cache tiles of a blocked transposition, and of
+// the micro-tiles staged through a local array inside them
+const Unsigned TransposeTileSize = 64;
+const Unsigned TransposeMicroSize = 8;
+// Below this stride (in bytes) between consecutive elements of the strided
+// side, the element-wise loops stay within a few pages and are as fast
+const std::size_t TransposeMinStrideBytes = 4096;
+
+////////////////////////////////////
+// Workhorse routines
+////////////////////////////////////
+
+// Copies an m x n tile that is unit stride along m in src and along n in
+// dst.  Full micro-tiles are read along m and written along n through a
+// local array the compiler can keep in registers.
+template<typename T>
+inline void
+TransposeTile(T const * const src, const Unsigned srcStride, T * const dst, const Unsigned dstStride, const Unsigned m, const Unsigned n){
+    const Unsigned b = TransposeMicroSize;
+    Unsigned j = 0;
+    for(; j + b <= n; j += b){
+        Unsigned i = 0;
+        for(; i + b <= m; i += b){
+            T tile[b][b];
+            for(Unsigned jj = 0; jj < b; jj++)
+                for(Unsigned ii = 0; ii < b; ii++)
+                    tile[ii][jj] = src[(i + ii) + (j + jj) * srcStride];
+            for(Unsigned ii = 0; ii < b; ii++)
+                for(Unsigned jj = 0; jj < b; jj++)
+                    dst[(i + ii) * dstStride + (j + jj)] = tile[ii][jj];
+        }
+        for(; i < m; i++)
+            for(Unsigned jj = 0; jj < b; jj++)
+                dst[i * dstStride + (j + jj)] = src[i + (j + jj) * srcStride];
+    }
+    for(; j < n; j++)
+        for(Unsigned i = 0; i < m; i++)
+            dst[i * dstStride + j] = src[i + j * srcStride];
+}
+
+// Copies a strided loop nest whose source and destination are unit stride
+// along different modes, tiling those two modes and spreading the tiles and
+// the remaining (outer) modes over threads.  Returns false, copying
+// nothing, when the nest is not such a transposition, the transposed modes
+// are too short to tile or neither side strides across pages.
+template<typename T>
+bool BlockedTranspose(const PackData& packData, T const * const srcBuf, T * const dstBuf){
+    if(AnyZeroElem(packData.loopShape))
+        return false;
+
+    Unsigned shape[MaxUnrolledLoopOrder];
+    Unsigned srcStrides[MaxUnrolledLoopOrder];
+    Unsigned dstStrides[MaxUnrolledLoopOrder];
+    const Unsigned order = MergeLoopModes(packData.loopShape, packData.srcBufStrides, packData.dstBufStrides, shape, srcStrides, dstStrides);
+    if(order < 2 || order > MaxUnrolledLoopOrder)
+        return false;
+
+    Unsigned srcUnitMode = order;
+    Unsigned dstUnitMode = order;
+    for(Unsigned k = 0; k < order; k++){
+        if(srcStrides[k] == 1 && srcUnitMode == order)
+            srcUnitMode = k;
+        if(dstStrides[k] == 1 && dstUnitMode == order)
+            dstUnitMode = k;
+    }
+    if(srcUnitMode == order || dstUnitMode == order || srcUnitMode == dstUnitMode)
+        return false;
+
+    const Unsigned m = shape[srcUnitMode];
+    const Unsigned n = shape[dstUnitMode];
+    if(m < TransposeMicroSize || n < TransposeMicroSize)
+        return false;
+    const Unsigned srcStride = srcStrides[dstUnitMode];
+    const Unsigned dstStride = dstStrides[srcUnitMode];
+    if(std::max(srcStride, dstStride) * sizeof(T) < TransposeMinStrideBytes)
+        return false;
+
+    Unsigned outerShape[MaxUnrolledLoopOrder];
+    Unsigned outerSrcStrides[MaxUnrolledLoopOrder];
+    Unsigned outerDstStrides[MaxUnrolledLoopOrder];
+    Unsigned nOuter = 0;
+    Unsigned nOuterElems = 1;
+    for(Unsigned k = 0; k < order; k++){
+        if(k == srcUnitMode || k == dstUnitMode)
+            continue;
+        outerShape[nOuter] = shape[k];
+        outerSrcStrides[nOuter] = srcStrides[k];
+        outerDstStrides[nOuter] = dstStrides[k];
+        nOuterElems *= shape[k];
+        nOuter++;
+    }
+
+    //One task per column of tiles (along n) of each outer index
+    const Unsigned nTileCols = IntCeil(n, TransposeTileSize);
+    const Unsigned nTasks = nOuterElems * nTileCols;
+
+    PARALLEL_FOR
+    for(Unsigned task = 0; task < nTasks; task++){
+        Unsigned outer = task / nTileCols;
+        const Unsigned j = (task % nTileCols) * TransposeTileSize;
+        const Unsigned nj = std::min(TransposeTileSize, n - j);
+
+        Unsigned srcOffset = j * srcStride;
+        Unsigned dstOffset = j;
+        for(Unsigned k = 0; k < nOuter; k++){
+            const Unsigned idx = outer % outerShape[k];
+            outer /= outerShape[k];
+            srcOffset += idx * outerSrcStrides[k];
+            dstOffset += idx * outerDstStrides[k];
+        }
+
+        for(Unsigned i = 0; i < m; i += TransposeTileSize)
+            TransposeTile(&(srcBuf[srcOffset + i]), srcStride, &(dstBuf[dstOffset + i * dstStride]), dstStride, std::min(TransposeTileSize, m - i), nj);
+    }
+    return true;
+}
+
+} // namespace rote
+
+#endif // ifndef ROTE_BTAS_TRANSPOSE_HPP
@@ -10,7 +10,11 @@
 #ifndef ROTE_BTAS_LEVELT_HPP
 #define ROTE_BTAS_LEVELT_HPP
 
+#include "levelT/Gett.hpp"
+#include "levelT/ContractTuning.hpp"
 #include "levelT/Contract.hpp"
+#include "levelT/ContractSum.hpp"
+#include "levelT/ExprGraph.hpp"
 #include "levelT/Contract-deprecate.hpp"
 #include "levelT/Hadamard.hpp"
 #include "levelT/HadamardScal.hpp"
@@ -12,10 +12,35 @@
 
 namespace rote{
 
+// Number of ContractVariant values
+const Unsigned NumContractVariants = 4;
+
+// A tensor and its indices, one operand of a multi-operand Contract
+template<typename T>
+struct ContractOperand
+{
+	ContractOperand(const DistTensor<T>& A, const std::string& indicesA)
+	: tensor(A), indices(indicesA) { }
+
+	const DistTensor<T>& tensor;
+	std::string indices;
+};
+
+template<typename T>
+class ContractSum;
+
+template<typename T>
+class ExprGraph;
+
 template<typename T>
 class Contract {
+	friend class ContractSum<T>;
+	friend class ExprGraph<T>;
 public:
-	// Main interface
+	// Main interface.  Without block sizes, runs the tuned variant (see
+	// ContractAutotuning()) or the one the cost model favors.  Block sizes
+	// given are for the free indices of C, so only StatA and StatB, which
+	// partition those, are considered.
 	static void run(
 		T alpha,
 		const DistTensor<T>& A, const std::string& indicesA,
@@ -25,7 +50,116 @@ public:
     const std::vector<Unsigned>& blkSizes
 	);
 
+	// D := alpha * (product of the operands) + beta * D, where every index
+	// appears in exactly two of the operands and D.  The operands are
+	// contracted pairwise in the order path() picks.
+	static void run(
+		T alpha,
+		const std::vector<ContractOperand<T> >& operands,
+		T beta,
+		      DistTensor<T>& D, const std::string& indicesD
+	);
+
+	static void run(
+		T alpha,
+		const ContractOperand<T>& A,
+		const ContractOperand<T>& B,
+		const ContractOperand<T>& C,
+		T beta,
+		      DistTensor<T>& D, const std::string& indicesD
+	);
+
+	// The pairwise order (and distributions of the intermediates) the cost
+	// model favors, weighing redistributions, flops (see ContractFlopTime())
+	// and intermediate sizes.  Orders whose intermediates exceed
+	// ContractMemoryLimit() are only chosen if none fits.  The search is
+	// exhaustive, so meant for a handful of operands.
+	static ContractPath path(
+		const std::vector<ContractOperand<T> >& operands,
+		const DistTensor<T>& D, const std::string& indicesD
+	);
+
+	// Modeled cost of each variant with the given block sizes (32 if none)
+	// and, when measure is set, the time each takes on a copy of C
+	static std::vector<ContractCost> costs(
+		T alpha,
+		const DistTensor<T>& A, const std::string& indicesA,
+		const DistTensor<T>& B, const std::string& indicesB,
+		T beta,
+		const DistTensor<T>& C, const std::string& indicesC,
+		const std::vector<Unsigned>& blkSizes, bool measure
+	);
+
 private:
+	// Double-buffered intermediates for the pipelined blocked loop.  The
+	// redistribution of block k+1 is posted into one slot while block k is
+	// contracted out of the other.
+	struct PipelineSlot
+	{
+		PipelineSlot(const BlkContractStatCInfo& contractInfo, const TensorDistribution& distC, const Grid& g);
+
+		DistTensor<T> intA;
+		DistTensor<T> intB;
+		DistTensor<T> outC;
+		ObjShape shapeT;
+		RedistRequest<T> reqA;
+		RedistRequest<T> reqB;
+		RedistRequest<T> reqC;
+		T beta;
+		bool pending;
+	};
+
+	struct Pipeline
+	{
+		Pipeline(const BlkContractStatCInfo& contractInfo, const TensorDistribution& distC, const Grid& g);
+		PipelineSlot& Slot(Unsigned i){ return i == 0 ? slot0 : slot1; }
+
+		PipelineSlot slot0;
+		PipelineSlot slot1;
+		DistTensor<T> intT;
+		Unsigned next;
+	};
+
+	// Variant interface
+	static void runVariant(
+		ContractVariant variant,
+		T alpha,
+		const DistTensor<T>& A, const IndexArray& indicesA,
+		const DistTensor<T>& B, const IndexArray& indicesB,
+		T beta,
+		      DistTensor<T>& C, const IndexArray& indicesC,
+		const std::vector<Unsigned>& blkSizes
+	);
+
+	// Cost model of one variant
+	static ContractCost predictCost(
+		ContractVariant variant,
+		const DistTensor<T>& A, const IndexArray& indicesA,
+		const DistTensor<T>& B, const IndexArray& indicesB,
+		const DistTensor<T>& C, const IndexArray& indicesC,
+		const std::vector<Unsigned>& blkSizes
+	);
+
+	// Seconds (slowest process) one variant takes on a copy of C
+	static double timeVariant(
+		ContractVariant variant,
+		T alpha,
+		const DistTensor<T>& A, const IndexArray& indicesA,
+		const DistTensor<T>& B, const IndexArray& indicesB,
+		T beta,
+		const DistTensor<T>& C, const IndexArray& indicesC,
+		const std::vector<Unsigned>& blkSizes
+	);
+
+	// Times each variant with candidate block sizes (on a copy of C)
+	static ContractTuning tune(
+		T alpha,
+		const DistTensor<T>& A, const IndexArray& indicesA,
+		const DistTensor<T>& B, const IndexArray& indicesB,
+		T beta,
+		const DistTensor<T>& C, const IndexArray& indicesC
+	);
+
 	//Struct interface
 	static void setContractInfo(
 		const DistTensor<T>& A, const IndexArray& indicesA,
@@ -35,14 +169,27 @@ private:
           BlkContractStatCInfo& contractInfo
   );
 
+	// Stationary C with the longest contracted index of the intermediates
+	// (and a trailing copy of C per replica) distributed over the grid modes
+	// C is replicated on
+	static void setContract25DInfo(
+		const DistTensor<T>& A, const IndexArray& indicesA,
+		const DistTensor<T>& B, const IndexArray& indicesB,
+		const DistTensor<T>& C, const IndexArray& indicesC,
+		const std::vector<Unsigned>& blkSizes,
+		      BlkContractStatCInfo& contractInfo
+	);
+
 	// Partition helpers
+	// A null pipeline runs each block to completion before the next
 	static void runHelperPartitionAB(
 		Unsigned depth, BlkContractStatCInfo& contractInfo,
 		T alpha,
 		const DistTensor<T>& A, const IndexArray& indicesA,
 		const DistTensor<T>& B, const IndexArray& indicesB,
 		T beta,
-					DistTensor<T>& C, const IndexArray& indicesC
+					DistTensor<T>& C, const IndexArray& indicesC,
+		Pipeline* pipeline
 	);
 
 	static void runHelperPartitionBC(
@@ -51,7 +198,27 @@ private:
 		const DistTensor<T>& A, const IndexArray& indicesA,
 		const DistTensor<T>& B, const IndexArray& indicesB,
 		T beta,
-					DistTensor<T>& C, const IndexArray& indicesC
+					DistTensor<T>& C, const IndexArray& indicesC,
+		Pipeline* pipeline
+	);
+
+	// Pipeline helpers
+	static void flushPipelineSlotAB(
+		BlkContractStatCInfo& contractInfo,
+		T alpha,
+		const IndexArray& indicesA, const IndexArray& indicesB,
+					DistTensor<T>& C, const IndexArray& indicesC,
+		PipelineSlot& slot
+	);
+
+	static void flushPipelineSlotBC(
+		BlkContractStatCInfo& contractInfo,
+		T alpha,
+		const DistTensor<T>& A, const IndexArray& indicesA,
+		const IndexArray& indicesB,
+		T beta,
+		const IndexArray& indicesC,
+		Pipeline& pipeline, PipelineSlot& slot
 	);
 
 	// Internal interface
@@ -65,6 +232,18 @@ private:
 		bool isStatC
 	);
 
+	// Each process layer along the grid modes C is replicated on contracts
+	// its share of the contracted index into its own copy of C, and the
+	// copies are summed into C at the end
+	static void run25D(
+		T alpha,
+		const DistTensor<T>& A, const IndexArray& indicesA,
+		const DistTensor<T>& B, const IndexArray& indicesB,
+		T beta,
+		      DistTensor<T>& C, const IndexArray& indicesC,
+		const std::vector<Unsigned>& blkSizes
+	);
+
 	// Local interface
 	static void run(
 		T alpha,
@@ -0,0 +1,70 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#pragma once
+#ifndef ROTE_BTAS_CONTRACTSUM_HPP
+#define ROTE_BTAS_CONTRACTSUM_HPP
+
+namespace rote{
+
+template<typename T>
+class ExprGraph;
+
+// Accumulates C := beta C + sum_i alpha_i A_i B_i.  Each term keeps one
+// operand stationary and contracts into an intermediate covering all of C;
+// terms whose intermediates share a distribution (and alignment) share one,
+// so they are reduced into C together by a single redistribution.  Terms
+// whose intermediates would exceed ContractMemoryLimit() are instead
+// contracted into C directly by the blocked Contract.
+//
+// Finish() must be called (by every process) before C is used.
+template<typename T>
+class ContractSum {
+	friend class ExprGraph<T>;
+public:
+  ContractSum(T beta, DistTensor<T>& C, const std::string& indicesC);
+
+  void Add(
+    T alpha,
+    const DistTensor<T>& A, const std::string& indicesA,
+    const DistTensor<T>& B, const std::string& indicesB
+  );
+
+  // Reduces the accumulated terms into C
+  void Finish();
+
+private:
+  void addStationaryA(
+    T alpha,
+    const DistTensor<T>& A, const IndexArray& indicesA,
+    const DistTensor<T>& B, const IndexArray& indicesB
+  );
+
+  // Contracts the stationary A with B already redistributed to
+  // contractInfo.distIntB (aligned with A) into a matching intermediate
+  void accumulate(
+    T alpha,
+    const DistTensor<T>& A, const IndexArray& indicesA,
+    const DistTensor<T>& intB, const IndexArray& indicesB,
+    const BlkContractStatCInfo& contractInfo
+  );
+
+  T beta_;
+  DistTensor<T>& C_;
+  IndexArray indicesC_;
+  bool finished_;
+  // Whether a direct term has already scaled C by beta
+  bool scaled_;
+
+  std::vector<std::shared_ptr<DistTensor<T> > > accums_;
+  std::vector<ModeArray> reduceModes_;
+};
+
+} // namespace rote
+
+#endif // ifndef ROTE_BTAS_CONTRACTSUM_HPP
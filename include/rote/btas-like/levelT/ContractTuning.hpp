@@ -0,0 +1,44 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#pragma once
+#ifndef ROTE_BTAS_CONTRACTTUNING_HPP
+#define ROTE_BTAS_CONTRACTTUNING_HPP
+
+namespace rote{
+
+// Smallest block size tried when tuning a contraction.  Candidates double
+// from it up to a single block per partitioned mode.
+const Unsigned ContractTuningMinBlkSize = 8;
+
+// Identifies a contraction signature in the tuning database
+std::string ContractTuningKey(
+  const IndexArray& indicesA, const ObjShape& shapeA, const TensorDistribution& distA,
+  const IndexArray& indicesB, const ObjShape& shapeB, const TensorDistribution& distB,
+  const IndexArray& indicesC, const ObjShape& shapeC, const TensorDistribution& distC,
+  const Grid& g, const Unsigned elemSize
+);
+
+// Looks a signature up, loading the tuning file (broadcast from the first
+// process of the grid) on first use.  Returns false if it was never tuned.
+bool FindContractTuning(const std::string& key, const Grid& g, ContractTuning& tuning);
+
+// Records a tuned signature, appending it to the tuning file if one is set
+void StoreContractTuning(const std::string& key, const Grid& g, const ContractTuning& tuning);
+
+// The modeled fastest variant among those whose intermediates fit in
+// ContractMemoryLimit(), or the one needing the least memory if none fits.
+// Ties go to the earlier variant.
+ContractVariant SelectContractVariant(const std::vector<ContractCost>& costs);
+
+// Drops every loaded entry (the tuning file is reread on the next lookup)
+void ClearContractTuning();
+
+} // namespace rote
+
+#endif // ifndef ROTE_BTAS_CONTRACTTUNING_HPP
@@ -0,0 +1,99 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#pragma once
+#ifndef ROTE_BTAS_EXPRGRAPH_HPP
+#define ROTE_BTAS_EXPRGRAPH_HPP
+
+namespace rote{
+
+// Records GenContract, YAxpBy, ZAxpBy and GenYAxpPx calls instead of running
+// them.  Evaluate() runs them in the order recorded after planning the
+// unblocked contractions together: an operand every term redistributes the
+// same way is redistributed once (and freed after its last use), each term
+// keeps stationary the operand that is cheapest given the redistributions
+// already shared, and consecutive terms updating the same output are reduced
+// into it together (see ContractSum).  Contractions given block sizes, or
+// whose unblocked intermediates exceed ContractMemoryLimit(), run as in
+// GenContract.
+//
+// Recorded tensors must outlive Evaluate(), which every process must call.
+template<typename T>
+class ExprGraph {
+public:
+  ExprGraph();
+
+  // A tensor owned by the graph, freed after the last operation using it
+  DistTensor<T>& Temporary(const ObjShape& shape, const TensorDistribution& dist, const Grid& g);
+
+  void GenContract(
+    T alpha,
+    const DistTensor<T>& A, const std::string& indicesA,
+    const DistTensor<T>& B, const std::string& indicesB,
+    T beta,
+          DistTensor<T>& C, const std::string& indicesC,
+    const std::vector<Unsigned>& blkSizes = std::vector<Unsigned>(0)
+  );
+
+  void YAxpBy(T alpha, const DistTensor<T>& X, T beta, DistTensor<T>& Y);
+
+  void ZAxpBy(T alpha, const DistTensor<T>& X, T beta, const DistTensor<T>& Y, DistTensor<T>& Z);
+
+  void GenYAxpPx(T alpha, const DistTensor<T>& X, T beta, const Permutation& perm, DistTensor<T>& Y);
+
+  // Runs and forgets everything recorded so far
+  void Evaluate();
+
+private:
+  enum ExprOp {ContractOp, YAxpByOp, ZAxpByOp, GenYAxpPxOp};
+
+  struct Node
+  {
+    ExprOp op;
+    T alpha;
+    T beta;
+    const DistTensor<T>* A;
+    const DistTensor<T>* B;
+    DistTensor<T>* C;
+    IndexArray indicesA;
+    IndexArray indicesB;
+    IndexArray indicesC;
+    std::vector<Unsigned> blkSizes;
+    Permutation perm;
+
+    // Set by plan(): the operand kept stationary (A or B), the shared
+    // redistribution of the other one (-1 if the node runs on its own)
+    bool statB;
+    Int operand;
+    BlkContractStatCInfo contractInfo;
+  };
+
+  // A redistribution of src (as of version) shared by several nodes
+  struct Operand
+  {
+    const DistTensor<T>* src;
+    Unsigned version;
+    std::shared_ptr<DistTensor<T> > tensor;
+    Unsigned uses;
+    bool ready;
+  };
+
+  Node& record(ExprOp op, T alpha, T beta, const DistTensor<T>* A, const DistTensor<T>* B, DistTensor<T>* C);
+
+  // Picks the stationary operand and shared redistribution of each
+  // unblocked contraction
+  void plan();
+
+  std::vector<Node> nodes_;
+  std::vector<Operand> operands_;
+  std::vector<std::shared_ptr<DistTensor<T> > > temps_;
+};
+
+} // namespace rote
+
+#endif // ifndef ROTE_BTAS_EXPRGRAPH_HPP
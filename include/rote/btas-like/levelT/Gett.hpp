@@ -0,0 +1,35 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#pragma once
+#ifndef ROTE_BTAS_GETT_HPP
+#define ROTE_BTAS_GETT_HPP
+
+namespace rote{
+
+// Panel sizes (in elements along M, N and K) of the blocked contraction
+const Unsigned GettBlockM = 128;
+const Unsigned GettBlockN = 1024;
+const Unsigned GettBlockK = 256;
+
+////////////////////////////////////
+// Workhorse routines
+////////////////////////////////////
+
+// C := alpha A B + beta C, where A, B and C are strided tensors whose modes
+// are grouped into the M, N and K dimensions of a matrix product, one
+// product per index of the batch (L) modes they all share.  Blocks
+// of A and B are packed straight from their strided layouts into
+// contiguous panels that Gemm multiplies, and each product is added into C
+// in place, so no tensor is ever permuted as a whole.
+template<typename T>
+void Gett(T alpha, T const * const A, T const * const B, T beta, T * const C, const GettData& data);
+
+} // namespace rote
+
+#endif // ifndef ROTE_BTAS_GETT_HPP
@@ -19,8 +19,22 @@
 #  define COLLAPSE(N)
 # endif
 # define PARALLEL_FOR _Pragma("omp parallel for")
+# if _OPENMP >= 201307
+#  define SIMD_FOR _Pragma("omp simd")
+# else
+#  define SIMD_FOR
+# endif
+# define ROTE_PRAGMA(x) _Pragma(#x)
+// Per-peer pack/unpack loops: peers (whose slabs can differ in size) are
+// handed out dynamically when there are enough of them to occupy every
+// thread; otherwise the loop runs serially and each peer's pack kernel
+// spreads its own slab over the threads
+# define PEER_PARALLEL_FOR(nPeers) \
+  ROTE_PRAGMA(omp parallel for schedule(dynamic) if((nPeers) >= (Unsigned)omp_get_max_threads()))
 #else
 # define PARALLEL_FOR
+# define SIMD_FOR
+# define PEER_PARALLEL_FOR(nPeers)
 # define COLLAPSE(N)
 #endif
 
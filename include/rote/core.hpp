@@ -42,6 +42,9 @@
 #include "core/structs.hpp"
 #include "core/grid.hpp"
 #include "core/grid_view.hpp"
+#include "core/node_comm.hpp"
+#include "core/redist_cache.hpp"
+#include "core/comm_model.hpp"
 // TODO: Fix view headers
 #include "core/view.hpp"
 #include "core/random.hpp"
@@ -0,0 +1,45 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#pragma once
+#ifndef ROTE_CORE_COMMMODEL_HPP
+#define ROTE_CORE_COMMMODEL_HPP
+
+namespace rote {
+
+// File written by CalibrateCommModel(g): $ROTE_COMM_MODEL if it is set,
+// else rote_comm_model.txt.
+std::string CommModelFilename();
+
+// Initialize loads a saved model only through this, i.e. only when
+// ROTE_COMM_MODEL is set; otherwise call LoadCommModel explicitly.
+bool LoadCommModelFromEnv();
+
+// Times AllToAll, AllGather, ReduceScatter, SendRecv and AllReduce over every
+// grid-mode sub-communicator of g for a range of message sizes, fits a
+// latency and bandwidth for each communicator and collective, and saves the
+// result (written by rank 0).  Must be called by every process of g.  The
+// send and receive buffers are capped at 64 MiB each, so on large grids the
+// biggest message sizes are skipped.  A nonzero maxCount also skips sizes
+// above maxCount elements per process (the two smallest are always timed).
+void CalibrateCommModel(const Grid& g);
+void CalibrateCommModel(const Grid& g, const std::string& filename, const Unsigned maxCount=0);
+
+// Reads a saved model on rank 0 of mpi::COMM_WORLD and broadcasts it, so all
+// processes plan with the same costs.  Returns false if there is no file.
+bool LoadCommModel(const std::string& filename);
+void SaveCommModel(const std::string& filename);
+
+// Fitted cost of one redistribution collective (AG, A2A, RS, AR, or Perm for
+// SendRecv) over the grid modes commModes of a grid shaped gridShape.
+// Returns false if that communicator has not been calibrated.
+bool FindCommFit(const ObjShape& gridShape, const ModeArray& commModes, const RedistType type, CommFit& fit);
+
+} // namespace rote
+
+#endif // ifndef ROTE_CORE_COMMMODEL_HPP
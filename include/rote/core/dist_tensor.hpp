@@ -23,5 +23,7 @@
 // New
 #include "dist_tensor/redist_tensor.hpp"
 #include "dist_tensor/dist_tensor.hpp"
+#include "dist_tensor/redist_handle.hpp"
+#include "dist_tensor/redist_request.hpp"
 
 #endif // ifndef ROTE_CORE_DISTTENSOR_HPP
@@ -102,13 +102,16 @@ public:
     virtual ~DistTensorBase();
 
 #ifndef SWIG
-    // Move constructor
-    //DistTensor( DistTensor<T>&& A );
-    // Move assignment
-    //DistTensor<T>& operator=( DistTensor<T>&& A );
+    // Take over A's local data (A is left empty)
+    DistTensorBase( DistTensorBase<T>&& A );
 #endif
 
     const DistTensorBase<T>& operator=( const DistTensorBase<T>& A );
+#ifndef SWIG
+    // Takes over A's local data when both own it on the same grid,
+    // otherwise copies
+    const DistTensorBase<T>& operator=( DistTensorBase<T>&& A );
+#endif
 
 
     Unsigned Order() const;
@@ -196,6 +199,17 @@ public:
     bool Viewing() const;
     bool Locked()  const;
 
+    //
+    // Versioning
+    //
+
+    // Changes on every write through this tensor or a view of it (Buffer(),
+    // Tensor(), Set, resizing, redistributing into it, ...), and is never
+    // reused, so (address, version) identifies the data.  Writes through
+    // pointers obtained earlier must call BumpVersion().
+    std::size_t Version() const;
+    void BumpVersion();
+
     //
     // Utilities
     //
@@ -324,6 +338,12 @@ protected:
     ViewType viewType_;
     Memory<T> auxMemory_;
 
+    //Shared with views of this tensor
+    std::shared_ptr<std::size_t> version_;
+    //Whether the data is a buffer attached from outside, whose writes no
+    //version records
+    bool attached_;
+
 private:
     void CopyFromDifferentGrid( const DistTensorBase<T>& A );
 
@@ -331,6 +351,7 @@ private:
     void SetDefaultPermutation();
     void SetModeShift(Mode mode);
     void SetGrid();
+    void DetachVersion();
 
     void ComplainIfReal() const;
 
@@ -357,6 +378,17 @@ private:
     template<typename S>
     friend void View2x1Helper
     ( DistTensor<S>& A, const DistTensor<S>& BT, const DistTensor<S>& BB, Mode mode, bool isLocked );
+    //Locked views set their local tensor without writing (and so without
+    //bumping the version shared with) the viewed tensor
+    template<typename S>
+    friend void LockedView( DistTensor<S>& A, const DistTensor<S>& B );
+    template<typename S>
+    friend void LockedView
+    ( DistTensor<S>& A, const DistTensor<S>& B,
+      const Location& loc, const ObjShape& shape );
+    template<typename S>
+    friend void LockedView2x1
+    ( DistTensor<S>& A, const DistTensor<S>& BT, const DistTensor<S>& BB, Mode mode );
 
     template<typename S>
     friend class DistTensor;
@@ -0,0 +1,43 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#pragma once
+#ifndef ROTE_CORE_DISTTENSOR_REDISTHANDLE_HPP
+#define ROTE_CORE_DISTTENSOR_REDISTHANDLE_HPP
+
+namespace rote {
+
+// A redistribution between two distributed tensor layouts that is planned once
+// and executed any number of times.  The handle owns its plan; the per-peer
+// pack/unpack tables of each step live in the process-wide redistribution cache.
+template<typename T>
+class RedistHandle
+{
+public:
+    RedistHandle(const DistTensor<T>& B, const DistTensor<T>& A, const ModeArray& reduceModes=ModeArray());
+    ~RedistHandle();
+
+    // B = alpha * A + beta * B, with A redistributed to B's distribution
+    void Execute(DistTensor<T>& B, const DistTensor<T>& A, const T alpha=T(1), const T beta=T(0)) const;
+
+    const RedistPlan& Plan() const {return plan_;}
+    const ModeArray& ReduceModes() const {return reduceModes_;}
+
+private:
+    bool Matches(const DistTensor<T>& B, const DistTensor<T>& A) const;
+
+    RedistPlan plan_;
+    ModeArray reduceModes_;
+    TensorDistribution distB_;
+    TensorDistribution distA_;
+    ObjShape gridShape_;
+};
+
+} // namespace rote
+
+#endif // ifndef ROTE_CORE_DISTTENSOR_REDISTHANDLE_HPP
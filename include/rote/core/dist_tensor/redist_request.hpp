@@ -0,0 +1,57 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#pragma once
+#ifndef ROTE_CORE_DISTTENSOR_REDISTREQUEST_HPP
+#define ROTE_CORE_DISTTENSOR_REDISTREQUEST_HPP
+
+namespace rote {
+
+// An in-flight redistribution posted by DistTensor<T>::RedistFromAsync.
+// The request owns the communication buffers; the target tensor is only
+// written when the request completes in Wait() or a successful Test(), so it
+// (but not the source) must stay alive until then.
+template<typename T>
+class RedistRequest
+{
+public:
+    RedistRequest();
+    ~RedistRequest();
+
+    // Block until the collective finishes, then unpack into the target
+    void Wait();
+    // Unpack and return true if the collective has finished
+    bool Test();
+    bool Active() const {return active_;}
+
+private:
+    friend class DistTensor<T>;
+
+    RedistRequest(const RedistRequest<T>& request);
+    RedistRequest<T>& operator=(const RedistRequest<T>& request);
+
+    void Post(const T* recvBuf, T* dataBuf, const Unsigned nElemsPerProc, const std::shared_ptr<const CommPackInfo>& unpackInfo, const bool update, const T alpha, const T beta);
+    void Unpack();
+
+    bool active_;
+    mpi::Request request_;
+    Memory<T> auxMemory_;
+
+    // Unpack state captured when the collective was posted
+    const T* recvBuf_;
+    T* dataBuf_;
+    Unsigned nElemsPerProc_;
+    std::shared_ptr<const CommPackInfo> unpackInfo_;
+    bool update_;
+    T alpha_;
+    T beta_;
+};
+
+} // namespace rote
+
+#endif // ifndef ROTE_CORE_DISTTENSOR_REDISTREQUEST_HPP
@@ -85,7 +85,14 @@ public:
       T* buffer, const std::vector<Unsigned>& strides, const rote::Grid& g );
 
     // Create a copy of distributed matrix A
-//    DistTensor( const DistTensor<T>& A );
+    DistTensor( const DistTensor<T>& A );
+    const DistTensor<T>& operator=( const DistTensor<T>& A );
+
+#ifndef SWIG
+    // Take over A's local data instead of copying it
+    DistTensor( DistTensor<T>&& A );
+    const DistTensor<T>& operator=( DistTensor<T>&& A );
+#endif
 
     ~DistTensor();
 
@@ -96,16 +103,24 @@ public:
     //
     void RedistFrom(const DistTensor<T>& A, const ModeArray& reduceModes, const T alpha=T(1), const T beta=T(0));
     void RedistFrom(const DistTensor<T>& A);
+    void RedistFrom(const RedistPlan& plan, const DistTensor<T>& A, const ModeArray& reduceModes, const T alpha=T(1), const T beta=T(0));
+
+    //
+    // Nonblocking redist interface routines
+    //
+    void RedistFromAsync(const DistTensor<T>& A, const ModeArray& reduceModes, RedistRequest<T>& request, const T alpha=T(1), const T beta=T(0));
+    void RedistFromAsync(const DistTensor<T>& A, RedistRequest<T>& request);
+    void RedistFromAsync(const RedistPlan& plan, const DistTensor<T>& A, const ModeArray& reduceModes, RedistRequest<T>& request, const T alpha=T(1), const T beta=T(0));
 
     //
     // All-to-all interface routines
     //
-    void AllToAllRedistFrom(const DistTensor<T>& A, const ModeArray& commModes, const T alpha=T(1), const T beta=T(0));
+    void AllToAllRedistFrom(const DistTensor<T>& A, const ModeArray& commModes, const T alpha=T(1), const T beta=T(0), RedistRequest<T>* request=0);
 
     //
     // Allgather interface routines
     //
-    void AllGatherRedistFrom(const DistTensor<T>& A, const ModeArray& commModes, const T alpha=T(1), const T beta=T(0));
+    void AllGatherRedistFrom(const DistTensor<T>& A, const ModeArray& commModes, const T alpha=T(1), const T beta=T(0), RedistRequest<T>* request=0);
 
     //
     // Broadcast interface routines
@@ -137,7 +152,7 @@ public:
     //
     // Reduce Redist routine
     //
-    void ReduceUpdateRedistFrom(const RedistType& redistType, const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& reduceModes);
+    void ReduceUpdateRedistFrom(const RedistType& redistType, const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& reduceModes, RedistRequest<T>* request=0);
 
     //
     // AllReduce interface routines
@@ -150,7 +165,7 @@ public:
     //
     // Reduce-scatter interface routines
     //
-    void ReduceScatterUpdateRedistFrom(const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& reduceModes);
+    void ReduceScatterUpdateRedistFrom(const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& reduceModes, RedistRequest<T>* request=0);
     void ReduceScatterRedistFrom(const DistTensor<T>& A, const Mode reduceMode);
     void ReduceScatterRedistFrom(const T alpha, const DistTensor<T>& A, const Mode reduceMode);
     void ReduceScatterUpdateRedistFrom(const T alpha, const DistTensor<T>& A, const T beta, const Mode reduceMode);
@@ -171,20 +186,42 @@ public:
     void ScatterRedistFrom(const DistTensor<T>& A, const ModeArray& commModes, const T alpha=T(1), const T beta=T(0));
 
 private:
+    //
+    // Cached pack/unpack table routines
+    //
+    CommPackKey CommPackKeyFor(const CommPackKind kind, const DistTensor<T>& A, const ModeArray& commModes, const ModeArray& reduceModes, const ObjShape& bufShape) const;
+
+    void ExecuteRedistPlan(const RedistPlan& plan, const DistTensor<T>& A, const ModeArray& reduceModes, const T alpha, const T beta, RedistRequest<T>* request);
+
     //
     // All-to-all workhorse routines
     //
     bool CheckAllToAllCommRedist(const DistTensor<T>& A);
-    void AllToAllCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const T alpha=T(1), const T beta=T(0));
+    void AllToAllCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const T alpha=T(1), const T beta=T(0), RedistRequest<T>* request=0);
     void PackA2ACommSendBuf(const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& sendShape, T * const sendBuf);
     void UnpackA2ACommRecvBuf(const T * const recvBuf, const ModeArray& commModes, const ObjShape& sendShape, const DistTensor<T>& A, const T alpha=T(0), const T beta=T(0));
+    std::shared_ptr<const CommPackInfo> A2ACommPackInfo(const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& sendShape);
+    std::shared_ptr<const CommPackInfo> A2ACommUnpackInfo(const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& recvShape);
+    void AllToAllExactCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& commDataShape, const T alpha, const T beta);
+    void UnpackExactCommRecvBuf(const T * const recvBuf, const CommPackInfo& unpackInfo, const std::vector<int>& recvDispls, const T alpha, const T beta);
+    void AllToAllZeroCopyCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& commDataShape);
+    std::shared_ptr<const CommDatatypes> A2ACommDatatypes(const CommPackKind kind, const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& bufShape);
 
     //
     // Allgather workhorse routines
     //
     bool CheckAllGatherCommRedist(const DistTensor<T>& A);
-    void AllGatherCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const T alpha=T(1), const T beta=T(0));
+    void AllGatherCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const T alpha=T(1), const T beta=T(0), RedistRequest<T>* request=0);
     void PackAGCommSendBuf(const DistTensor<T>& A, T * const sendBuf);
+    void AllGatherExactCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const T alpha, const T beta);
+    void AllGatherZeroCopyCommRedist(const DistTensor<T>& A, const ModeArray& commModes);
+
+    //
+    // Memory-capped AllToAll/AllGather routines
+    //
+    void ChunkedCommRedist(const RedistType type, const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& commDataShape, const Unsigned nChunks, const T alpha, const T beta);
+    void PackChunkCommSendBuf(const DistTensor<T>& A, const CommPackInfo& packInfo, const ObjShape& chunkShape, const Mode chunkMode, const Unsigned chunkStart, T * const sendBuf);
+    void UnpackChunkCommRecvBuf(const T * const recvBuf, const CommPackInfo& unpackInfo, const ObjShape& chunkShape, const Mode chunkMode, const Unsigned chunkStart, const T alpha, const T beta);
 
     //
     // Broadcast workhorse routines
@@ -217,9 +254,11 @@ private:
     // Reduce-scatter workhorse routines
     //
     bool CheckReduceScatterCommRedist(const DistTensor<T>& A);
-    void ReduceScatterUpdateCommRedist(const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& reduceModes, const ModeArray& commModes);
+    void ReduceScatterUpdateCommRedist(const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& reduceModes, const ModeArray& commModes, RedistRequest<T>* request=0);
     void PackRSCommSendBuf(const DistTensor<T>& A, const ModeArray& reduceModes, const ModeArray& commModes, T * const sendBuf);
+    std::shared_ptr<const CommPackInfo> RSCommPackInfo(const DistTensor<T>& A, const ModeArray& reduceModes, const ModeArray& commModes);
     void UnpackRSUCommRecvBuf(const T* const recvBuf, const T alpha, const T beta);
+    void ReduceScatterExactCommRedist(const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& reduceModes, const ModeArray& commModes);
 
     //
     // Reduce-to-one workhorse routines
@@ -234,6 +273,10 @@ private:
     void ScatterCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const T alpha=T(1), const T beta=T(0));
 
     bool AlignCommBufRedist(const DistTensor<T>& A, const T* unalignedSendBuf, const Unsigned sendSize, T* alignedSendBuf, const Unsigned recvSize);
+    bool UseExactCommCounts(const DistTensor<T>& A, const double paddedElems, const double exactElems, const RedistRequest<T>* request) const;
+    bool UseZeroCopyRedist(const DistTensor<T>& A, const double paddedElems, const T alpha, const T beta, const RedistRequest<T>* request) const;
+    bool CommBufsAligned(const DistTensor<T>& A) const;
+    Unsigned RedistChunks(const ObjShape& commDataShape, const double auxElems, const RedistRequest<T>* request) const;
 
 };
 
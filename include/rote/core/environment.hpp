@@ -90,6 +90,88 @@ void PrintInputReport(){ GetArgs().PrintReport(); };
 Int Blocksize();
 void SetBlocksize( Int blocksize );
 
+// For overlapping the redistributions of the next block with the local
+// computation of the current one in the blocked Contract loops
+bool ContractPipelining();
+void SetContractPipelining( bool pipeline );
+
+// For tuning Contract calls made without block sizes.  The first call with a
+// new signature (indices, shapes, distributions and grid) times each variant
+// with candidate block sizes and records the fastest in the tuning database,
+// which later calls reuse.  The database is read from and appended to the
+// given file (none if empty); setting it drops the loaded entries.
+bool ContractAutotuning();
+void SetContractAutotuning( bool autotune );
+const std::string& ContractTuningFile();
+void SetContractTuningFile( const std::string& filename );
+
+// For getting and setting the most local memory (in bytes) the intermediates
+// of one block of a Contract variant may hold.  Variants over the limit are
+// only chosen if none fits.  Zero means no limit.
+std::size_t ContractMemoryLimit();
+void SetContractMemoryLimit( std::size_t bytes );
+
+// For getting and setting the seconds per local flop multi-operand Contract
+// calls charge when weighing contraction orders against redistributions
+double ContractFlopTime();
+void SetContractFlopTime( double seconds );
+
+// For getting and setting the model redistribution plans are scored with.
+// Setting it drops every cached plan.
+const CommCostModel& GetCommCostModel();
+void SetCommCostModel( const CommCostModel& model );
+
+// For getting and setting the fraction of padding (relative to the real data)
+// above which AllToAll, AllGather and ReduceScatter redistributions switch
+// from MaxLocalShape-padded blocks to exact per-peer counts.  Setting it drops
+// every cached plan.
+double CommPaddingThreshold();
+void SetCommPaddingThreshold( double threshold );
+
+// For getting and setting the most candidate steps a redistribution plan
+// may evaluate while searching intermediate distributions for a plan
+// cheaper than its greedy ones.  Zero keeps the greedy plans.  Setting it
+// drops every cached plan.
+Unsigned RedistPlanSearchLimit();
+void SetRedistPlanSearchLimit( Unsigned limit );
+
+// For getting and setting the padded per-process buffer size (in elements)
+// from which blocking AllToAll and AllGather redistributions that overwrite
+// their output describe each peer's block with MPI datatypes instead of
+// packing it through auxiliary buffers.
+Unsigned ZeroCopyRedistThreshold();
+void SetZeroCopyRedistThreshold( Unsigned threshold );
+
+// For getting and setting the most auxiliary memory (in bytes) a blocking
+// AllToAll or AllGather redistribution may hold at once.  Larger ones are
+// split into rounds, each moving a slab of the tensor.  Zero means no limit.
+// Push/Pop scope a limit to the calls in between.
+std::size_t RedistMemoryLimit();
+void SetRedistMemoryLimit( std::size_t bytes );
+void PushRedistMemoryLimit( std::size_t bytes );
+void PopRedistMemoryLimit();
+
+// Rounds run by redistributions split under RedistMemoryLimit(), counted
+// since startup on this process
+std::size_t RedistChunkRounds();
+
+// For getting and setting the most local memory (in bytes) the copies kept
+// by RedistFrom may hold.  A plain RedistFrom of an unmodified tensor (see
+// DistTensorBase::Version()), or of a view of the same part of one, into a
+// tensor laid out like an earlier one copies the earlier result instead of
+// redistributing.  A hit is not free:
+// it still costs one AllReduce of an integer over the grid and a copy of
+// the local data, and a miss costs a local copy of the result on top of the
+// redistribution, so the cache only pays off for redistributions that are
+// dominated by communication.  Zero (the default) disables the cache;
+// setting the limit drops the kept copies.
+std::size_t RedistResultCacheLimit();
+void SetRedistResultCacheLimit( std::size_t bytes );
+
+// Redistributions served from the kept copies, counted since startup on
+// this process
+std::size_t RedistResultHits();
+
 //std::mt19937& Generator();
 
 inline Unsigned IntCeil(Unsigned m, Unsigned n)
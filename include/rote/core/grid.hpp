@@ -39,6 +39,14 @@ public:
 
     static int FindFactor( int p );
 
+    // Route the blocking AllToAll, AllGather and ReduceScatter steps of
+    // redistributions through node-aware collectives (see NodeComm).  A
+    // nonzero ranksPerNode emulates nodes of that many consecutive ranks.
+    // Must be called by every process of the grid.
+    void SetNodeAwareCollectives( bool enable, Unsigned ranksPerNode=0 );
+    bool NodeAwareCollectives() const;
+    NodeComm& NodeAwareComm( const ModeArray& commModes, mpi::Comm comm ) const;
+
     // Utils
     Location ToGridViewLoc(const Location& loc, const GridView& gv) const;
     Location ToParticipatingGridViewLoc(const Location& loc, const GridView& gv) const;
@@ -61,6 +69,11 @@ private:
 
     //std::map<ModeArray, mpi::Comm> comms_;
 
+    bool nodeAware_;
+    Unsigned ranksPerNode_;
+    mutable std::map<ModeArray, NodeComm*> nodeComms_;
+    void FreeNodeComms();
+
     void SetUpGrid();
 
     // Disable copying this class due to MPI_Comm/MPI_Group ownership issues
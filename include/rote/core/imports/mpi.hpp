@@ -17,6 +17,7 @@ namespace mpi {
 #if defined(HAVE_MPI3_NONBLOCKING_COLLECTIVES) || \
     defined(HAVE_MPIX_NONBLOCKING_COLLECTIVES)
 #define HAVE_NONBLOCKING 1
+#define HAVE_NONBLOCKING_COLLECTIVES
 #else
 #define HAVE_NONBLOCKING 0
 #endif
@@ -39,6 +40,7 @@ typedef MPI_Op Op;
 typedef MPI_Request Request;
 typedef MPI_Status Status;
 typedef MPI_User_function UserFunction;
+typedef MPI_Win Win;
 
 typedef std::map<ModeArray, mpi::Comm> CommMap;
 
@@ -57,6 +59,7 @@ const int THREAD_SERIALIZED = 2;
 const int THREAD_MULTIPLE = 3;
 #endif
 const int UNDEFINED = MPI_UNDEFINED;
+const Comm COMM_NULL = MPI_COMM_NULL;
 const Comm COMM_SELF = MPI_COMM_SELF;
 const Comm COMM_WORLD = MPI_COMM_WORLD;
 const ErrorHandler ERRORS_RETURN = MPI_ERRORS_RETURN;
@@ -90,6 +93,13 @@ int QueryThread();
 double Time();
 void OpCreate( UserFunction* func, bool commutes, Op& op );
 void OpFree( Op& op );
+void TypeCreateHVector
+( int count, int blockLength, Aint stride, Datatype oldType, Datatype& newType );
+void TypeCreateHIndexed
+( int count, const int* blockLengths, const Aint* displs, Datatype oldType,
+  Datatype& newType );
+void TypeCommit( Datatype& type );
+void TypeFree( Datatype& type );
 
 // Communicator manipulation
 int WorldRank();
@@ -98,10 +108,20 @@ int CommSize( Comm comm );
 void CommCreate( Comm parentComm, Group subsetGroup, Comm& subsetComm );
 void CommDup( Comm original, Comm& duplicate );
 void CommSplit( Comm comm, int color, int key, Comm& newComm );
+void CommSplitShared( Comm comm, int key, Comm& newComm );
 void CommFree( Comm& comm );
 bool CongruentComms( Comm comm1, Comm comm2 );
 void ErrorHandlerSet( Comm comm, ErrorHandler errorHandler );
 
+// Shared-memory window routines (MPI-3)
+void WinAllocateShared
+( Aint size, int dispUnit, Comm comm, void* baseptr, Win& win );
+void WinSharedQuery( Win win, int rank, void* baseptr );
+void WinLockAll( Win win );
+void WinUnlockAll( Win win );
+void WinSync( Win win );
+void WinFree( Win& win );
+
 // Cartesian communicator routines
 void CartCreate
 ( Comm comm, int numDims, const int* dimensions, const int* periods,
@@ -331,6 +351,19 @@ void AllGather
 ( const std::complex<R>* sbuf, int sc,
         std::complex<R>* rbuf, int rc, Comm comm );
 
+#ifdef HAVE_NONBLOCKING_COLLECTIVES
+// Non-blocking AllGather
+// ----------------------
+template<typename R>
+void IAllGather
+( const R* sbuf, int sc,
+        R* rbuf, int rc, Comm comm, Request& request );
+template<typename R>
+void IAllGather
+( const std::complex<R>* sbuf, int sc,
+        std::complex<R>* rbuf, int rc, Comm comm, Request& request );
+#endif
+
 // AllGather with variable recv sizes
 // ----------------------------------
 template<typename R>
@@ -369,6 +402,19 @@ void AllToAll
 ( const std::complex<R>* sbuf, int sc,
         std::complex<R>* rbuf, int rc, Comm comm );
 
+#ifdef HAVE_NONBLOCKING_COLLECTIVES
+// Non-blocking AllToAll
+// ---------------------
+template<typename R>
+void IAllToAll
+( const R* sbuf, int sc,
+        R* rbuf, int rc, Comm comm, Request& request );
+template<typename R>
+void IAllToAll
+( const std::complex<R>* sbuf, int sc,
+        std::complex<R>* rbuf, int rc, Comm comm, Request& request );
+#endif
+
 // AllToAll with non-uniform send/recv sizes
 // -----------------------------------------
 template<typename R>
@@ -380,6 +426,13 @@ void AllToAll
 ( const std::complex<R>* sbuf, const int* scs, const int* sds,
         std::complex<R>* rbuf, const int* rcs, const int* rds, Comm comm );
 
+// AllToAll with a datatype (and byte displacement) per peer
+// ----------------------------------------------------------
+void AllToAll
+( const void* sbuf, const int* scs, const int* sds, const Datatype* sts,
+        void* rbuf, const int* rcs, const int* rds, const Datatype* rts,
+  Comm comm );
+
 // Reduce
 // ------
 template<typename T>
@@ -448,6 +501,20 @@ void ReduceScatter
 template<typename T>
 void ReduceScatter( T* sbuf, T* rbuf, int rc, Comm comm );
 
+#ifdef HAVE_NONBLOCKING_COLLECTIVES
+// Non-blocking ReduceScatter
+// --------------------------
+template<typename R>
+void IReduceScatter
+( R* sbuf, R* rbuf, int rc, Op op, Comm comm, Request& request );
+template<typename R>
+void IReduceScatter
+( std::complex<R>* sbuf, std::complex<R>* rbuf, int rc, Op op, Comm comm, Request& request );
+// Default to mpi::SUM
+template<typename T>
+void IReduceScatter( T* sbuf, T* rbuf, int rc, Comm comm, Request& request );
+#endif
+
 // Single-buffer ReduceScatter
 // ---------------------------
 template<typename R>
@@ -12,6 +12,46 @@
 
 namespace rote {
 
+struct WorkspaceStats
+{
+    std::size_t hits;
+    std::size_t misses;
+    std::size_t inUseBytes;
+    std::size_t retainedBytes;
+    std::size_t peakBytes;
+};
+
+// Process-wide pool every Memory<G> buffer (tensor data and redistribution
+// buffers alike) is drawn from.  Requests are rounded up to size classes
+// (at most 25% larger than asked for) and returned buffers are kept for
+// reuse, up to RetainLimit() bytes, instead of being freed.  By default the
+// limit follows the most bytes ever in use at once, so everything one
+// iteration of an algorithm frees is kept for the next one, at the price of
+// at most twice that high-water mark held per process.  SetRetainLimit(n)
+// fixes the limit at n bytes (0 turns retention off) and
+// SetRetainLimit(Workspace::HighWaterMark) restores the default.  The pool
+// is safe to use from inside OpenMP regions.
+class Workspace
+{
+public:
+    static const std::size_t HighWaterMark = std::size_t(-1);
+
+    // Returns a buffer of at least the requested bytes; its actual size is
+    // stored in grantedBytes and must be passed back to Return.
+    static byte* Acquire( std::size_t bytes, std::size_t& grantedBytes );
+    static void Return( byte* buffer, std::size_t grantedBytes );
+
+    // Frees every retained buffer
+    static void Trim();
+
+    static std::size_t RetainLimit();
+    static void SetRetainLimit( std::size_t bytes );
+
+    static WorkspaceStats Stats();
+    static void ResetStats();
+};
+
+// Buffers are not initialized, whatever G is
 template<typename G>
 class Memory
 {
@@ -0,0 +1,71 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#pragma once
+#ifndef ROTE_CORE_NODECOMM_HPP
+#define ROTE_CORE_NODECOMM_HPP
+
+namespace rote {
+
+// Node-aware view of a communicator for the collectives used by
+// redistributions.  Processes on the same node exchange data through an
+// MPI-3 shared-memory window, and only the first process of each node (its
+// leader) communicates over the network, sending one aggregated message per
+// pair of nodes.  All routines take the same arguments as their flat
+// counterparts and must be called by every process of the communicator.
+class NodeComm
+{
+public:
+    // Nodes are found with MPI_Comm_split_type(MPI_COMM_TYPE_SHARED).  A
+    // nonzero ranksPerNode further splits them into groups of that many
+    // consecutive world ranks, emulating smaller nodes on one machine.
+    NodeComm( mpi::Comm comm, Unsigned ranksPerNode=0 );
+    ~NodeComm();
+
+    Unsigned NumNodes() const { return nodeSizes_.size(); }
+
+    template<typename T>
+    void AllGather( const T* sbuf, int sc, T* rbuf );
+    template<typename T>
+    void AllToAll( const T* sbuf, int sc, T* rbuf );
+    template<typename T>
+    void ReduceScatter( const T* sbuf, T* rbuf, int rc );
+
+private:
+    // Node-local shared buffer of at least the given size, grown as needed
+    byte* Segment( std::size_t bytes );
+    void NodeSync();
+
+    mpi::Comm comm_;
+    mpi::Comm nodeComm_;
+    mpi::Comm leaderComm_;
+    int rank_;
+    int nodeRank_;
+    int nodeSize_;
+    int node_;
+
+    // Node and node-local rank of every process of comm_, and where each
+    // process sits when processes are ordered node by node
+    std::vector<int> nodeOf_;
+    std::vector<int> localRankOf_;
+    std::vector<int> nodeSizes_;
+    std::vector<int> nodeOffsets_;
+    std::vector<int> pos_;
+
+    mpi::Win win_;
+    byte* segment_;
+    std::size_t segmentBytes_;
+
+    // Disable copying due to MPI_Comm/MPI_Win ownership
+    const NodeComm& operator=( NodeComm& );
+    NodeComm( const NodeComm& );
+};
+
+} // namespace rote
+
+#endif // ifndef ROTE_CORE_NODECOMM_HPP
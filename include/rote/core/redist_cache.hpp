@@ -0,0 +1,118 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#pragma once
+#ifndef ROTE_CORE_REDISTCACHE_HPP
+#define ROTE_CORE_REDISTCACHE_HPP
+
+namespace rote {
+
+// Which per-peer table of a communication step a CommPackKey refers to
+enum CommPackKind {A2APack, A2AUnpack, RSPack, AGPack};
+
+// Everything the per-peer pack/unpack tables of one communication step
+// depend on.  Distributions are stored as their mode entries so the key
+// has a strict weak ordering.
+struct CommPackKey
+{
+    Unsigned kind;
+    ObjShape gridShape;
+    Location gridLoc;
+    ModeArray commModes;
+    ModeArray reduceModes;
+    ObjShape bufShape;
+
+    std::vector<ModeArray> distA;
+    ObjShape shapeA;
+    std::vector<Unsigned> alignA;
+    std::vector<Unsigned> permA;
+    std::vector<Unsigned> stridesA;
+
+    std::vector<ModeArray> distB;
+    ObjShape shapeB;
+    std::vector<Unsigned> alignB;
+    std::vector<Unsigned> permB;
+    std::vector<Unsigned> stridesB;
+};
+
+bool operator<(const CommPackKey& lhs, const CommPackKey& rhs);
+
+std::vector<ModeArray> DistEntries(const TensorDistribution& dist);
+
+// Plans depend only on the distributions, the reduced modes, the grid shape
+// and the size of the source tensor (which the plan cost is estimated for),
+// so each distinct request is planned once per process.  The returned plan
+// stays valid after it is evicted from the cache.
+std::shared_ptr<const RedistPlan> CachedRedistPlan(const TensorDistribution& dB, const TensorDistribution& dA, const ModeArray& reduceModes, const Grid& g, const ObjShape& shapeA, const Unsigned elemSize);
+
+// Returns the cached tables for key, or an empty pointer on a miss.
+std::shared_ptr<const CommPackInfo> FindCommPackInfo(const CommPackKey& key);
+std::shared_ptr<const CommPackInfo> StoreCommPackInfo(const CommPackKey& key, const CommPackInfo& info);
+
+// One MPI datatype per peer of a communication step, each describing that
+// peer's block in place in a tensor buffer, so MPI reads or writes the tensor
+// directly.  Each type carries its block's offset as an MPI_Aint (the int
+// displs stay 0) so buffers past 2 GiB work.  Peers with no data have
+// count 0.
+struct CommDatatypes
+{
+    explicit CommDatatypes(const Unsigned nPeers);
+    ~CommDatatypes();
+
+    std::vector<int> counts;
+    std::vector<int> displs;
+    std::vector<mpi::Datatype> types;
+};
+
+// Nested hvectors over the elements of a strided block, mode 0 fastest,
+// starting offset elements into the buffer
+mpi::Datatype StridedBlockType(const ObjShape& loopShape, const std::vector<Unsigned>& strides, const std::size_t offset, const Unsigned elemSize);
+
+// Datatypes are cached per step and element size, like the pack tables.
+std::shared_ptr<const CommDatatypes> FindCommDatatypes(const CommPackKey& key, const Unsigned elemSize);
+std::shared_ptr<const CommDatatypes> StoreCommDatatypes(const CommPackKey& key, const Unsigned elemSize, const std::shared_ptr<const CommDatatypes>& types);
+
+// A stamp no tensor version has used yet (see DistTensorBase::Version())
+std::size_t NewTensorVersion();
+
+// What a redistributed copy of a source depends on: the data the source
+// was written as (the version cell it shares with every view of the same
+// tensor, and the version), the part of it the source covers (where its
+// local data starts, and its global shape, distribution, alignments and
+// local permutation), and the layout of the target.
+struct RedistResultKey
+{
+    const void* src;
+    std::size_t version;
+    const void* data;
+    ObjShape srcShape;
+    std::vector<ModeArray> srcDist;
+    std::vector<Unsigned> srcAlign;
+    std::vector<Unsigned> srcPerm;
+    const Grid* grid;
+    std::vector<ModeArray> dist;
+    std::vector<Unsigned> align;
+    std::vector<Unsigned> perm;
+};
+
+bool operator<(const RedistResultKey& lhs, const RedistResultKey& rhs);
+
+// Redistributed copies are kept, least recently used first out, while their
+// local size stays within RedistResultCacheLimit().  Storing a copy drops
+// the copies of other versions of the same tensor, whichever part of it
+// they were redistributed from.
+std::shared_ptr<const void> FindRedistResult(const RedistResultKey& key);
+void StoreRedistResult(const RedistResultKey& key, const std::shared_ptr<const void>& result, const std::size_t bytes);
+void ClearRedistResults();
+
+// Drops every cached plan, pack table, datatype and redistributed copy.
+void ClearRedistCache();
+
+} // namespace rote
+
+#endif // ifndef ROTE_CORE_REDISTCACHE_HPP
@@ -65,6 +65,16 @@ private:
 	std::map<Mode, std::pair<Mode, Mode>> moved_; // Val is (tMode add, tMode rmv)
 };
 
+// Whether a collective whose padded per-process buffer holds paddedElems
+// elements should instead send exact per-peer counts, given the average real
+// data exactElems.  True once the padding exceeds CommPaddingThreshold().
+bool PreferExactCommCounts(const double paddedElems, const double exactElems);
+
+// Each plan is built by running the greedy passes in several orderings and
+// keeping the one with the lowest cost under GetCommCostModel() for a tensor
+// of shape shapeA.  A best-first search over intermediate distributions,
+// bounded by that cost and by RedistPlanSearchLimit(), then replaces it with
+// any cheaper sequence of steps it finds.
 class RedistPlan
 {
 public:
@@ -72,7 +82,9 @@ public:
     const TensorDistribution& dB,
     const TensorDistribution& dA,
     const ModeArray& reduceModes,
-    const Grid& g
+    const Grid& g,
+    const ObjShape& shapeA,
+    const Unsigned elemSize
   );
 
   const Redist& operator[](const int index) const {
@@ -80,6 +92,12 @@ public:
   }
   int size() const {return plan_.size();}
 
+  // Predicted seconds for the whole plan and for a single step
+  double Cost() const {return cost_;}
+  double StepCost(const int index) const {
+    return index < 0 ? stepCosts_[stepCosts_.size() + index] : stepCosts_[index];
+  }
+
   ~RedistPlan() {};
 
   void MoveOpt();
@@ -94,11 +112,25 @@ public:
   void ShuffleTo(const TensorDistribution& dB);
 
 private:
+  bool Build(const TensorDistribution& dA, const Unsigned strategy);
+  bool IsConsistent(const TensorDistribution& dA) const;
+  bool Search(const TensorDistribution& dA, const double bound);
+  void Expand(const TensorDistribution& dist, const Unsigned maxMoves, std::vector<std::vector<Redist> >& moves) const;
+  double EstimateCost(std::vector<double>& stepCosts) const;
+  double EstimateStepCost(const Redist& redist, ObjShape& shape) const;
+  double LocalBytes(const TensorDistribution& dist, const ObjShape& shape) const;
+  double ExactLocalBytes(const TensorDistribution& dist, const ObjShape& shape) const;
+
   RedistPlanInfo info_;
   std::vector<Redist> plan_;
   TensorDistribution dCur_;
   TensorDistribution dB_;
-  const Grid& g_;
+  ModeArray reduceModes_;
+  ObjShape gridShape_;
+  ObjShape shapeA_;
+  Unsigned elemSize_;
+  std::vector<double> stepCosts_;
+  double cost_;
 };
 
 } // namespace rote
@@ -78,6 +78,16 @@ struct PackData
     Permutation permutation;
 };
 
+//Per-peer pack/unpack tables of a single communication step.
+//Entry k describes the block exchanged with peer peers[k] of the
+//communicator: where it starts in the local data buffer and how to traverse it.
+struct CommPackInfo
+{
+    std::vector<Unsigned> peers;
+    std::vector<Unsigned> dataBufOffsets;
+    std::vector<PackData> packData;
+};
+
 struct YAxpPxData{
     ObjShape loopShape;
     std::vector<Unsigned> srcStrides;
@@ -139,6 +149,73 @@ struct ZAxpBypPxData{
     std::vector<Unsigned> permSrcStrides;
     std::vector<Unsigned> dstStrides;
 };
+
+//A contraction C[M,N,L] = A[M,K,L] B[K,N,L] over groups of tensor modes,
+//each group given by its extents and the strides of its modes in each
+//tensor.  L holds the batch modes (empty for a plain contraction)
+struct GettData{
+    ObjShape shapeM;
+    ObjShape shapeN;
+    ObjShape shapeK;
+    ObjShape shapeL;
+    std::vector<Unsigned> stridesAM;
+    std::vector<Unsigned> stridesAK;
+    std::vector<Unsigned> stridesBK;
+    std::vector<Unsigned> stridesBN;
+    std::vector<Unsigned> stridesCM;
+    std::vector<Unsigned> stridesCN;
+    std::vector<Unsigned> stridesAL;
+    std::vector<Unsigned> stridesBL;
+    std::vector<Unsigned> stridesCL;
+};
+
+//The fastest way found to run a contraction signature
+struct ContractTuning{
+    ContractVariant variant;
+    std::vector<Unsigned> blkSizes;
+};
+
+//Modeled (and optionally measured) cost of running a contraction variant
+struct ContractCost{
+    ContractVariant variant;
+    double predictedTime;     // Seconds, from the redistribution plans
+    double intermediateBytes; // Local bytes of one block's intermediates
+    double measuredTime;      // Seconds, or -1 if not measured
+};
+
+//One pairwise contraction of a multi-operand contraction.  Operands are
+//numbered in the order given, and the result of step k is operand n+k
+//(n operands).  The last step contracts into the output.
+struct ContractPathStep{
+    Unsigned left;
+    Unsigned right;
+    IndexArray indices;      // Of the result
+    ObjShape shape;
+    TensorDistribution dist;
+};
+
+//The order a multi-operand contraction is carried out in
+struct ContractPath{
+    std::vector<ContractPathStep> steps;
+    double predictedTime;    // Seconds, redistributions and flops
+    double peakBytes;        // Local bytes of intermediates alive at once
+};
+
+//Latency/bandwidth model used to score redistribution plans
+struct CommCostModel
+{
+    double alpha; // Seconds per message
+    double beta;  // Seconds per byte sent
+    double gamma; // Seconds per byte packed or reduced locally
+};
+
+//Fitted time alpha + beta*bytes of one collective over one communicator,
+//where bytes is the send buffer of each process
+struct CommFit
+{
+    double alpha;
+    double beta;
+};
 }
 
 #endif // ifndef ROTE_CORE_STRUCTS_HPP
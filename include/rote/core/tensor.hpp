@@ -40,11 +40,8 @@ public:
     Tensor( const ObjShape& shape, T* buffer, const std::vector<Unsigned>& strides, bool fixed=false );
     Tensor( const Tensor<T>& A );
 
-    // Move constructor
-    //Tensor( Tensor<T>&& A );
-
-    // Move assignment
-    //Tensor<T>& operator=( Tensor<T>&& A );
+    // Move constructor (takes over A's buffer or view; A is left empty)
+    Tensor( Tensor<T>&& A );
 
     // Swap
     void Swap( Tensor<T>& A );
@@ -147,6 +144,8 @@ public:
     //
 
     const Tensor<T>& operator=( const Tensor<T>& A );
+    // Takes over A's buffer when both own their data, otherwise copies
+    const Tensor<T>& operator=( Tensor<T>&& A );
 
     void Empty();
     void ResizeTo( const ObjShape& shape );
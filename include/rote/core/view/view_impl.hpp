@@ -37,6 +37,8 @@ inline void ViewHelper( DistTensor<T>& A, const DistTensor<T>& B, bool isLocked)
     A.modeAlignments_ = B.modeAlignments_;
     A.dist_ = B.dist_;
     A.localPerm_ = B.localPerm_;
+    A.version_ = B.version_;
+    A.attached_ = B.attached_;
     if(isLocked)
         A.viewType_ = LOCKED_VIEW;
     else
@@ -120,6 +122,8 @@ inline void ViewHelper
     A.shape_ = shape;
     A.dist_ = B.dist_;
     A.localPerm_ = B.localPerm_;
+    A.version_ = B.version_;
+    A.attached_ = B.attached_;
     for(i = 0; i < order; i++)
         A.modeAlignments_[i] = (B.ModeAlignment(i) + loc[i]) % modeWrapStrides[i];
 
@@ -193,6 +197,8 @@ inline void View2x1Helper
     A.shape_[mode] += BB.shape_[mode];
     A.modeAlignments_ = BT.modeAlignments_;
     A.localPerm_ = BT.localPerm_;
+    A.version_ = BT.version_;
+    A.attached_ = BT.attached_;
     if(isLocked)
         A.viewType_ = LOCKED_VIEW;
     else
@@ -200,7 +206,9 @@ inline void View2x1Helper
     if( A.Participating() )
     {
         A.modeShifts_ = BT.modeShifts_;
-        View2x1Helper(A.Tensor(), BT.LockedTensor(), BB.LockedTensor(), mode, isLocked);
+        //The local tensors store the modes in the local permutation
+        const Mode localMode = BT.localPerm_.InversePermutation()[mode];
+        View2x1Helper(A.tensor_, BT.LockedTensor(), BB.LockedTensor(), localMode, isLocked);
 //        if(isLocked)
 //            LockedView2x1( A.Tensor(), BT.LockedTensor(), BB.LockedTensor(), mode );
 //        else
@@ -436,7 +444,7 @@ inline void LockedView( DistTensor<T>& A, const DistTensor<T>& B )
     ViewHelper(A, B, true);
     //Set the data we can't set in helper
     if(A.Participating()){
-        LockedView(A.Tensor(), B.LockedTensor());
+        LockedView(A.tensor_, B.LockedTensor());
     }
 
 }
@@ -476,8 +484,9 @@ inline void View
     //Set the data we can't set in helper
     if(A.Participating()){
         const std::vector<Unsigned> modeWrapStrides = B.GridViewShape();
-        const std::vector<Unsigned> localShapeBehind = Lengths(loc, B.ModeShifts(), modeWrapStrides);
-        const std::vector<Unsigned> localShape = Lengths(shape, A.ModeShifts(), modeWrapStrides);
+        const Permutation& perm = B.LocalPermutation();
+        const std::vector<Unsigned> localShapeBehind = perm.applyTo(Lengths(loc, B.ModeShifts(), modeWrapStrides));
+        const std::vector<Unsigned> localShape = perm.applyTo(Lengths(shape, A.ModeShifts(), modeWrapStrides));
 
         View( A.Tensor(), B.Tensor(), localShapeBehind, localShape );
     }
@@ -520,10 +529,11 @@ inline void LockedView
     //Set the data we can't set in helper
     if(A.Participating()){
         const std::vector<Unsigned> modeWrapStrides = B.GridViewShape();
-        const std::vector<Unsigned> localShapeBehind = Lengths(loc, B.ModeShifts(), modeWrapStrides);
-        const std::vector<Unsigned> localShape = Lengths(shape, A.ModeShifts(), modeWrapStrides);
+        const Permutation& perm = B.LocalPermutation();
+        const std::vector<Unsigned> localShapeBehind = perm.applyTo(Lengths(loc, B.ModeShifts(), modeWrapStrides));
+        const std::vector<Unsigned> localShape = perm.applyTo(Lengths(shape, A.ModeShifts(), modeWrapStrides));
 
-        LockedView( A.Tensor(), B.LockedTensor(), localShapeBehind, localShape );
+        LockedView( A.tensor_, B.LockedTensor(), localShapeBehind, localShape );
     }
 }
 
@@ -559,7 +569,7 @@ inline void View2x1
     View2x1Helper(A, BT, BB, mode, false);
     //Set the data we can't set in helper
     if(A.Participating()){
-        View2x1( A.Tensor(), BT.Tensor(), BB.Tensor(), mode );
+        View2x1( A.Tensor(), BT.Tensor(), BB.Tensor(), BT.LocalPermutation().InversePermutation()[mode] );
     }
 }
 
@@ -598,7 +608,7 @@ inline void LockedView2x1
     View2x1Helper(A, BT, BB, mode, true);
     //Set the data we can't set in helper
     if(A.Participating()){
-        LockedView2x1( A.Tensor(), BT.LockedTensor(), BB.LockedTensor(), mode );
+        LockedView2x1( A.tensor_, BT.LockedTensor(), BB.LockedTensor(), BT.LocalPermutation().InversePermutation()[mode] );
     }
 }
 
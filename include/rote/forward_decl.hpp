@@ -18,18 +18,28 @@ class DistTensorBase;
 template<typename T>
 class DistTensor;
 
+template<typename T>
+class RedistHandle;
+
+template<typename T>
+class RedistRequest;
+
 // TODO: Move this
 template<typename T>
 class Hadamard;
 
 class GridView;
 class Grid;
+class NodeComm;
 
 class ModeDistribution;
 class TensorDistribution;
 
 class Permutation;
 
+struct CommCostModel;
+struct CommFit;
+
 template<typename T>
 class Memory;
 
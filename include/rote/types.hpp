@@ -32,6 +32,10 @@ typedef std::vector<Unsigned> Location;
 //Redistribution enum
 enum RedistType {AG, A2A, Local, RS, RTO, AR, GTO, BCast, Scatter, Perm};
 
+//Contraction variant enum (the operand kept in place; Stat25D keeps
+//replicas of C and splits the contraction between them)
+enum ContractVariant {StatA, StatB, StatC, Stat25D};
+
 //template<typename Real>
 //using Complex = std::complex<Real>;
 
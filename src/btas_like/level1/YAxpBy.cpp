@@ -12,218 +12,26 @@ namespace rote {
 template<typename T>
 inline void
 YAxpBy_fast(T alpha, T beta, T const * const srcBuf, T * const dstBuf, const YAxpByData& data ){
-  const std::vector<Unsigned> loopEnd = data.loopShape;
-  const std::vector<Unsigned> srcBufStrides = data.srcStrides;
-  const std::vector<Unsigned> dstBufStrides = data.dstStrides;
-  Unsigned srcBufPtr = 0;
-  Unsigned dstBufPtr = 0;
-  Unsigned order = loopEnd.size();
-  Location curLoc(order, 0);
-  Unsigned ptr = 0;
+  const ObjShape& loopShape = data.loopShape;
+  const std::vector<Unsigned>& srcStrides = data.srcStrides;
+  const std::vector<Unsigned>& dstStrides = data.dstStrides;
 
-  bool done = !ElemwiseLessThan(curLoc, loopEnd);
-
-  //Alpha cannot be zero (handled in parent call)
+  //NOTE: Zero coefficients skip their operand so that its contents (possibly
+  //uninitialized) are never read
   if(alpha == T(0)){
-    if(beta == T(0)){
-      Zero_fast(loopEnd, dstBufStrides, dstBuf);
-    }else if(beta == T(1)){
-    }else{
-      ScalData scal_data;
-      scal_data.loopShape = loopEnd;
-      scal_data.srcStrides = dstBufStrides;
-      Scal_fast(alpha, dstBuf, scal_data);
-    }
-  }else if(alpha == T(1)){
-    if(beta == T(0)){
-      if(loopEnd.size() == 0){
-        dstBuf[0] = srcBuf[0];
-        return;
-      }
-
-      while(!done){
-        dstBuf[dstBufPtr] = srcBuf[srcBufPtr];
-        //Update
-        curLoc[ptr]++;
-        dstBufPtr += dstBufStrides[ptr];
-        srcBufPtr += srcBufStrides[ptr];
-        while(ptr < order && curLoc[ptr] >= loopEnd[ptr]){
-          curLoc[ptr] = 0;
-
-          dstBufPtr -= dstBufStrides[ptr] * (loopEnd[ptr]);
-          srcBufPtr -= srcBufStrides[ptr] * (loopEnd[ptr]);
-          ptr++;
-          if(ptr >= order){
-            done = true;
-            break;
-          }else{
-            curLoc[ptr]++;
-            dstBufPtr += dstBufStrides[ptr];
-            srcBufPtr += srcBufStrides[ptr];
-          }
-        }
-        if(done)
-            break;
-        ptr = 0;
-      }
-    }else if(beta == T(1)){
-      if(loopEnd.size() == 0){
-        dstBuf[0] = srcBuf[0] + dstBuf[0];
-        return;
-      }
-
-      while(!done){
-        dstBuf[dstBufPtr] = srcBuf[srcBufPtr] + dstBuf[dstBufPtr];
-        //Update
-        curLoc[ptr]++;
-        dstBufPtr += dstBufStrides[ptr];
-        srcBufPtr += srcBufStrides[ptr];
-        while(ptr < order && curLoc[ptr] >= loopEnd[ptr]){
-          curLoc[ptr] = 0;
-
-          dstBufPtr -= dstBufStrides[ptr] * (loopEnd[ptr]);
-          srcBufPtr -= srcBufStrides[ptr] * (loopEnd[ptr]);
-          ptr++;
-          if(ptr >= order){
-            done = true;
-            break;
-          }else{
-            curLoc[ptr]++;
-            dstBufPtr += dstBufStrides[ptr];
-            srcBufPtr += srcBufStrides[ptr];
-          }
-        }
-        if(done)
-          break;
-        ptr = 0;
-      }
-    }else{
-      if(loopEnd.size() == 0){
-        dstBuf[0] = srcBuf[0] + beta*dstBuf[0];
-        return;
-      }
-
-      while(!done){
-        dstBuf[dstBufPtr] = srcBuf[srcBufPtr] + beta*dstBuf[dstBufPtr];
-        //Update
-        curLoc[ptr]++;
-        dstBufPtr += dstBufStrides[ptr];
-        srcBufPtr += srcBufStrides[ptr];
-        while(ptr < order && curLoc[ptr] >= loopEnd[ptr]){
-          curLoc[ptr] = 0;
-
-          dstBufPtr -= dstBufStrides[ptr] * (loopEnd[ptr]);
-          srcBufPtr -= srcBufStrides[ptr] * (loopEnd[ptr]);
-          ptr++;
-          if(ptr >= order){
-            done = true;
-            break;
-          }else{
-            curLoc[ptr]++;
-            dstBufPtr += dstBufStrides[ptr];
-            srcBufPtr += srcBufStrides[ptr];
-          }
-        }
-        if(done)
-          break;
-        ptr = 0;
-      }
-    }
+    ScalData scal_data;
+    scal_data.loopShape = loopShape;
+    scal_data.srcStrides = dstStrides;
+    Scal_fast(beta, dstBuf, scal_data);
+  }else if(beta == T(0)){
+    if(alpha == T(1))
+      ElemAssign(loopShape, dstStrides, dstBuf, Elem(srcBuf, srcStrides));
+    else
+      ElemAssign(loopShape, dstStrides, dstBuf, alpha*Elem(srcBuf, srcStrides));
+  }else if(beta == T(1)){
+    ElemAssign(loopShape, dstStrides, dstBuf, alpha*Elem(srcBuf, srcStrides) + Elem(dstBuf, dstStrides));
   }else{
-    if(beta == T(0)){
-      if(loopEnd.size() == 0){
-        dstBuf[0] = alpha*srcBuf[0];
-        return;
-      }
-
-      while(!done){
-        dstBuf[dstBufPtr] = alpha*srcBuf[srcBufPtr];
-        //Update
-        curLoc[ptr]++;
-        dstBufPtr += dstBufStrides[ptr];
-        srcBufPtr += srcBufStrides[ptr];
-        while(ptr < order && curLoc[ptr] >= loopEnd[ptr]){
-          curLoc[ptr] = 0;
-
-          dstBufPtr -= dstBufStrides[ptr] * (loopEnd[ptr]);
-          srcBufPtr -= srcBufStrides[ptr] * (loopEnd[ptr]);
-          ptr++;
-          if(ptr >= order){
-            done = true;
-            break;
-          }else{
-            curLoc[ptr]++;
-            dstBufPtr += dstBufStrides[ptr];
-            srcBufPtr += srcBufStrides[ptr];
-          }
-        }
-        if(done)
-          break;
-        ptr = 0;
-      }
-    }else if(beta == T(1)){
-      if(loopEnd.size() == 0){
-        dstBuf[0] = alpha*srcBuf[0] + dstBuf[0];
-        return;
-      }
-
-      while(!done){
-        dstBuf[dstBufPtr] = alpha*srcBuf[srcBufPtr] + dstBuf[dstBufPtr];
-        //Update
-        curLoc[ptr]++;
-        dstBufPtr += dstBufStrides[ptr];
-        srcBufPtr += srcBufStrides[ptr];
-        while(ptr < order && curLoc[ptr] >= loopEnd[ptr]){
-          curLoc[ptr] = 0;
-
-          dstBufPtr -= dstBufStrides[ptr] * (loopEnd[ptr]);
-          srcBufPtr -= srcBufStrides[ptr] * (loopEnd[ptr]);
-          ptr++;
-          if(ptr >= order){
-            done = true;
-            break;
-          }else{
-            curLoc[ptr]++;
-            dstBufPtr += dstBufStrides[ptr];
-            srcBufPtr += srcBufStrides[ptr];
-          }
-        }
-        if(done)
-          break;
-        ptr = 0;
-      }
-    }else{
-      if(loopEnd.size() == 0){
-        dstBuf[0] = alpha*srcBuf[0] + beta*dstBuf[0];
-        return;
-      }
-
-      while(!done){
-        dstBuf[dstBufPtr] = srcBuf[srcBufPtr] + beta*dstBuf[dstBufPtr];
-        //Update
-        curLoc[ptr]++;
-        dstBufPtr += dstBufStrides[ptr];
-        srcBufPtr += srcBufStrides[ptr];
-        while(ptr < order && curLoc[ptr] >= loopEnd[ptr]){
-          curLoc[ptr] = 0;
-
-          dstBufPtr -= dstBufStrides[ptr] * (loopEnd[ptr]);
-          srcBufPtr -= srcBufStrides[ptr] * (loopEnd[ptr]);
-          ptr++;
-          if(ptr >= order){
-            done = true;
-            break;
-          }else{
-            curLoc[ptr]++;
-            dstBufPtr += dstBufStrides[ptr];
-            srcBufPtr += srcBufStrides[ptr];
-          }
-        }
-        if(done)
-          break;
-        ptr = 0;
-      }
-    }
+    ElemAssign(loopShape, dstStrides, dstBuf, alpha*Elem(srcBuf, srcStrides) + beta*Elem(dstBuf, dstStrides));
   }
 }
 
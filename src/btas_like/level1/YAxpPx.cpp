@@ -13,53 +13,8 @@ namespace rote {
 template<typename T>
 void
 YAxpPx_fast(T alpha, T beta, T const * const srcBuf, T const * const permSrcBuf, T * const dstBuf, const YAxpPxData& data ){
-    const std::vector<Unsigned> loopEnd = data.loopShape;
-    const std::vector<Unsigned> srcBufStrides = data.srcStrides;
-    const std::vector<Unsigned> permBufStrides = data.permSrcStrides;
-    const std::vector<Unsigned> dstBufStrides = data.dstStrides;
-    Unsigned srcBufPtr = 0;
-    Unsigned permBufPtr = 0;
-    Unsigned dstBufPtr = 0;
-    Unsigned order = loopEnd.size();
-    Location curLoc(order, 0);
-    Unsigned ptr = 0;
-
-    if(loopEnd.size() == 0){
-        dstBuf[0] = alpha*srcBuf[0] + beta*permSrcBuf[0];
-        return;
-    }
-
-    bool done = !ElemwiseLessThan(curLoc, loopEnd);
-
-    while(!done){
-        dstBuf[dstBufPtr] = alpha*srcBuf[srcBufPtr] + beta*permSrcBuf[permBufPtr];
-
-        //Update
-        curLoc[ptr]++;
-        dstBufPtr += dstBufStrides[ptr];
-        srcBufPtr += srcBufStrides[ptr];
-        permBufPtr += permBufStrides[ptr];
-        while(ptr < order && curLoc[ptr] >= loopEnd[ptr]){
-            curLoc[ptr] = 0;
-
-            dstBufPtr -= dstBufStrides[ptr] * (loopEnd[ptr]);
-            srcBufPtr -= srcBufStrides[ptr] * (loopEnd[ptr]);
-            permBufPtr -= permBufStrides[ptr] * (loopEnd[ptr]);
-            ptr++;
-            if(ptr >= order){
-                done = true;
-                break;
-            }else{
-                curLoc[ptr]++;
-                dstBufPtr += dstBufStrides[ptr];
-                srcBufPtr += srcBufStrides[ptr];
-                permBufPtr += permBufStrides[ptr];
-            }
-        }
-        if(done)
-            break;
-        ptr = 0;
-    }
+    ElemAssign(data.loopShape, data.dstStrides, dstBuf,
+               alpha*Elem(srcBuf, data.srcStrides) + beta*Elem(permSrcBuf, data.permSrcStrides));
 }
 
 ////////////////////////////////////
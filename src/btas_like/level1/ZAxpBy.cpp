@@ -13,147 +13,8 @@ namespace rote {
 template<typename T>
 inline void
 ZAxpBy_fast(T alpha, T beta, T const * const src1Buf, T const * const src2Buf,  T * const dstBuf, const ZAxpByData& data ){
-    const std::vector<Unsigned> loopEnd = data.loopShape;
-    const std::vector<Unsigned> src1BufStrides = data.src1Strides;
-    const std::vector<Unsigned> src2BufStrides = data.src2Strides;
-    const std::vector<Unsigned> dstBufStrides = data.dstStrides;
-    Unsigned src1BufPtr = 0;
-    Unsigned src2BufPtr = 0;
-    Unsigned dstBufPtr = 0;
-    Unsigned order = loopEnd.size();
-    Location curLoc(order, 0);
-    Unsigned ptr = 0;
-
-    if(loopEnd.size() == 0){
-        dstBuf[0] = alpha * src1Buf[0] + beta * src2Buf[0];
-        return;
-    }
-
-    bool done = !ElemwiseLessThan(curLoc, loopEnd);
-
-    if(alpha == T(1) && beta == T(1)){
-
-        while(!done){
-
-            dstBuf[dstBufPtr] = src1Buf[src1BufPtr] + src2Buf[src2BufPtr];
-            //Update
-            curLoc[ptr]++;
-            dstBufPtr += dstBufStrides[ptr];
-            src1BufPtr += src1BufStrides[ptr];
-            src2BufPtr += src2BufStrides[ptr];
-            while(ptr < order && curLoc[ptr] >= loopEnd[ptr]){
-                curLoc[ptr] = 0;
-
-                dstBufPtr -= dstBufStrides[ptr] * (loopEnd[ptr]);
-                src1BufPtr -= src1BufStrides[ptr] * (loopEnd[ptr]);
-                src2BufPtr -= src2BufStrides[ptr] * (loopEnd[ptr]);
-                ptr++;
-                if(ptr >= order){
-                    done = true;
-                    break;
-                }else{
-                    curLoc[ptr]++;
-                    dstBufPtr += dstBufStrides[ptr];
-                    src1BufPtr += src1BufStrides[ptr];
-                    src2BufPtr += src2BufStrides[ptr];
-                }
-            }
-            if(done)
-                break;
-            ptr = 0;
-        }
-    }else if(alpha == T(1) && beta != T(1)){
-        while(!done){
-
-            dstBuf[dstBufPtr] = src1Buf[src1BufPtr] + beta * src2Buf[src2BufPtr];
-            //Update
-            curLoc[ptr]++;
-            dstBufPtr += dstBufStrides[ptr];
-            src1BufPtr += src1BufStrides[ptr];
-            src2BufPtr += src2BufStrides[ptr];
-            while(ptr < order && curLoc[ptr] >= loopEnd[ptr]){
-                curLoc[ptr] = 0;
-
-                dstBufPtr -= dstBufStrides[ptr] * (loopEnd[ptr]);
-                src1BufPtr -= src1BufStrides[ptr] * (loopEnd[ptr]);
-                src2BufPtr -= src2BufStrides[ptr] * (loopEnd[ptr]);
-                ptr++;
-                if(ptr >= order){
-                    done = true;
-                    break;
-                }else{
-                    curLoc[ptr]++;
-                    dstBufPtr += dstBufStrides[ptr];
-                    src1BufPtr += src1BufStrides[ptr];
-                    src2BufPtr += src2BufStrides[ptr];
-                }
-            }
-            if(done)
-                break;
-            ptr = 0;
-        }
-    }else if(alpha != T(1) && beta == T(1)){
-        while(!done){
-
-            dstBuf[dstBufPtr] = alpha * src1Buf[src1BufPtr] + src2Buf[src2BufPtr];
-            //Update
-            curLoc[ptr]++;
-            dstBufPtr += dstBufStrides[ptr];
-            src1BufPtr += src1BufStrides[ptr];
-            src2BufPtr += src2BufStrides[ptr];
-            while(ptr < order && curLoc[ptr] >= loopEnd[ptr]){
-                curLoc[ptr] = 0;
-
-                dstBufPtr -= dstBufStrides[ptr] * (loopEnd[ptr]);
-                src1BufPtr -= src1BufStrides[ptr] * (loopEnd[ptr]);
-                src2BufPtr -= src2BufStrides[ptr] * (loopEnd[ptr]);
-                ptr++;
-                if(ptr >= order){
-                    done = true;
-                    break;
-                }else{
-                    curLoc[ptr]++;
-                    dstBufPtr += dstBufStrides[ptr];
-                    src1BufPtr += src1BufStrides[ptr];
-                    src2BufPtr += src2BufStrides[ptr];
-                }
-            }
-            if(done)
-                break;
-            ptr = 0;
-        }
-    }else{
-        while(!done){
-
-            dstBuf[dstBufPtr] = alpha * src1Buf[src1BufPtr] + beta * src2Buf[src2BufPtr];
-            //Update
-            curLoc[ptr]++;
-            dstBufPtr += dstBufStrides[ptr];
-            src1BufPtr += src1BufStrides[ptr];
-            src2BufPtr += src2BufStrides[ptr];
-            while(ptr < order && curLoc[ptr] >= loopEnd[ptr]){
-                curLoc[ptr] = 0;
-
-                dstBufPtr -= dstBufStrides[ptr] * (loopEnd[ptr]);
-                src1BufPtr -= src1BufStrides[ptr] * (loopEnd[ptr]);
-                src2BufPtr -= src2BufStrides[ptr] * (loopEnd[ptr]);
-                ptr++;
-                if(ptr >= order){
-                    done = true;
-                    break;
-                }else{
-                    curLoc[ptr]++;
-                    dstBufPtr += dstBufStrides[ptr];
-                    src1BufPtr += src1BufStrides[ptr];
-                    src2BufPtr += src2BufStrides[ptr];
-                }
-            }
-            if(done)
-                break;
-            ptr = 0;
-        }
-    }
-
+    ElemAssign(data.loopShape, data.dstStrides, dstBuf,
+               alpha*Elem(src1Buf, data.src1Strides) + beta*Elem(src2Buf, data.src2Strides));
 }
 
 ////////////////////////////////////
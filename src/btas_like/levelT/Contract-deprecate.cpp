@@ -11,7 +11,52 @@
 
 namespace rote{
 
+//Groups the modes of a contraction with batch indices, read through the
+//indices of each tensor.  An index shared by A, B and C is a batch index
+//unless C only holds it as one of the unit modes left for contracted
+//indices (an extent-1 batch index contracts to the same result).  Returns
+//false if there are no batch indices.
+template <typename T>
+bool DetermineBatchedGettData(
+  const Tensor<T>& A, const IndexArray& indicesA,
+  const Tensor<T>& B, const IndexArray& indicesB,
+  const Tensor<T>& C, const IndexArray& indicesC,
+  GettData& data
+) {
+    Unsigned i;
+    for(i = 0; i < indicesA.size(); i++){
+        const int modeB = IndexOf(indicesB, indicesA[i]);
+        const int modeC = IndexOf(indicesC, indicesA[i]);
+        if(modeB < 0){
+            data.shapeM.push_back(A.Dimension(i));
+            data.stridesAM.push_back(A.Stride(i));
+            data.stridesCM.push_back(C.Stride(modeC));
+        }else if(modeC >= 0 && C.Dimension(modeC) != 1){
+            data.shapeL.push_back(A.Dimension(i));
+            data.stridesAL.push_back(A.Stride(i));
+            data.stridesBL.push_back(B.Stride(modeB));
+            data.stridesCL.push_back(C.Stride(modeC));
+        }else{
+            data.shapeK.push_back(A.Dimension(i));
+            data.stridesAK.push_back(A.Stride(i));
+            data.stridesBK.push_back(B.Stride(modeB));
+        }
+    }
+    for(i = 0; i < indicesB.size(); i++){
+        if(Contains(indicesA, indicesB[i]))
+            continue;
+        data.shapeN.push_back(B.Dimension(i));
+        data.stridesBN.push_back(B.Stride(i));
+        data.stridesCN.push_back(C.Stride(IndexOf(indicesC, indicesB[i])));
+    }
+    return data.shapeL.size() > 0;
+}
+
 // TODO: Deprecate
+// Indices shared by A, B and C are batch indices: each of their values
+// indexes an independent contraction.  Batched contractions always run
+// through Gett, which reads every tensor through its indices, so the
+// indices must follow each tensor's stored mode order.
 template <typename T>
 void LocalContract(
   T alpha,
@@ -26,6 +71,12 @@ void LocalContract(
 #endif
     PROFILE_SECTION("Contract");
 
+    GettData batchedData;
+    if(DetermineBatchedGettData(A, indicesA, B, indicesB, C, indicesC, batchedData)){
+        Gett(alpha, A.LockedBuffer(), B.LockedBuffer(), beta, C.Buffer(), batchedData);
+        PROFILE_RETURN;
+    }
+
     Unsigned i;
     const std::vector<ModeArray> contractPerms(DetermineContractModes(indicesA, indicesB, indicesC));
     const IndexArray contractIndices = DetermineContractIndices(indicesA, indicesB);
@@ -36,51 +87,46 @@ void LocalContract(
     const Permutation permB = contractPerms[1];
     const Permutation permC = contractPerms[2];
     const Unsigned nIndicesM = permA.size() - nIndicesContract;
-
-    Tensor<T> PA(A.Order());
-    Tensor<T> PB(B.Order());
-    Tensor<T> PC(C.Order());
-
-    Tensor<T> MPA, MPB, MPC;
-
-    //Create a matrix view of the tensors (permute if needed)
-    //Then call Gemm
-    if(permuteA){
-        Permute(A, PA, permA);
-        ViewAsMatrix(MPA, PA, nIndicesM);
-    }else{
-        ViewAsMatrix(MPA, A, nIndicesM);
-    }
-    if(permuteB){
-        Permute(B, PB, permB);
-        ViewAsMatrix(MPB, PB, nIndicesContract);
-    }else{
-        ViewAsMatrix(MPB, B, nIndicesContract);
+    const Unsigned nIndicesN = permB.size() - nIndicesContract;
+
+    //Contract straight from the strided layouts rather than permuting
+    //whole operands into matrix form
+    if((permuteA && permA != Permutation(A.Order())) ||
+       (permuteB && permB != Permutation(B.Order())) ||
+       (permuteC && permC != Permutation(C.Order()))){
+        const ModeArray modesA = permuteA ? permA.Entries() : Permutation(A.Order()).Entries();
+        const ModeArray modesB = permuteB ? permB.Entries() : Permutation(B.Order()).Entries();
+        const ModeArray modesC = permuteC ? permC.Entries() : Permutation(C.Order()).Entries();
+
+        GettData data;
+        for(i = 0; i < nIndicesM; i++){
+            data.shapeM.push_back(A.Dimension(modesA[i]));
+            data.stridesAM.push_back(A.Stride(modesA[i]));
+            data.stridesCM.push_back(C.Stride(modesC[i]));
+        }
+        for(i = 0; i < nIndicesN; i++){
+            data.shapeN.push_back(B.Dimension(modesB[nIndicesContract + i]));
+            data.stridesBN.push_back(B.Stride(modesB[nIndicesContract + i]));
+            data.stridesCN.push_back(C.Stride(modesC[nIndicesM + i]));
+        }
+        for(i = 0; i < nIndicesContract; i++){
+            data.shapeK.push_back(A.Dimension(modesA[nIndicesM + i]));
+            data.stridesAK.push_back(A.Stride(modesA[nIndicesM + i]));
+            data.stridesBK.push_back(B.Stride(modesB[i]));
+        }
+
+        Gett(alpha, A.LockedBuffer(), B.LockedBuffer(), beta, C.Buffer(), data);
+        PROFILE_RETURN;
     }
-    if(permuteC){
-        Permute(C, PC, permC);
-        ViewAsMatrix(MPC, PC, nIndicesM);
-
-        Gemm(alpha, MPA, MPB, beta, MPC);
 
-        Tensor<T> IPC;
-        const Permutation invPermC = permC.InversePermutation();
-        ObjShape splitColModes(nIndicesM);
-        for(i = 0; i < splitColModes.size(); i++)
-            splitColModes[i] = i;
-
-        std::vector<ObjShape> newShape(2);
-        newShape[0] = FilterVector(PC.Shape(), splitColModes);
-        newShape[1] = NegFilterVector(PC.Shape(), splitColModes);
-
-        ViewAsHigherOrder(IPC, MPC, newShape);
-
-        Permute(IPC, C, invPermC);
-    }else{
-        ViewAsMatrix(MPC, C, nIndicesM);
+    //Every requested permutation is the identity here, so view each tensor
+    //as a matrix in place and call Gemm
+    Tensor<T> MPA, MPB, MPC;
+    ViewAsMatrix(MPA, A, nIndicesM);
+    ViewAsMatrix(MPB, B, nIndicesContract);
+    ViewAsMatrix(MPC, C, nIndicesM);
 
-        Gemm(alpha, MPA, MPB, beta, MPC);
-    }
+    Gemm(alpha, MPA, MPB, beta, MPC);
     PROFILE_STOP;
 }
 
@@ -96,7 +142,7 @@ void LocalContractForRun(
   if (doEliminate) {
     Unsigned i;
     Unsigned order = C.Order();
-    IndexArray contractIndices = DetermineContractIndices(indicesA, indicesB);
+    IndexArray contractIndices = DiffVector(DetermineContractIndices(indicesA, indicesB), indicesC);
 
     ModeArray uModes(contractIndices.size());
     for(i = 0; i < uModes.size(); i++)
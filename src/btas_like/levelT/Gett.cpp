@@ -0,0 +1,131 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#include "rote.hpp"
+
+namespace rote{
+
+//Offset of every element of a group of modes (mode 0 fastest)
+inline std::vector<Unsigned> GroupOffsets(const ObjShape& shape, const std::vector<Unsigned>& strides){
+    std::vector<Unsigned> offsets(1, 0);
+    for(Unsigned i = 0; i < shape.size(); i++){
+        const Unsigned n = offsets.size();
+        offsets.resize(n * shape[i]);
+        for(Unsigned j = 1; j < shape[i]; j++)
+            for(Unsigned l = 0; l < n; l++)
+                offsets[j * n + l] = offsets[l] + j * strides[i];
+    }
+    return offsets;
+}
+
+template<typename T>
+void Gett(T alpha, T const * const A, T const * const B, T beta, T * const C, const GettData& data){
+    const std::vector<Unsigned> offAM = GroupOffsets(data.shapeM, data.stridesAM);
+    const std::vector<Unsigned> offAK = GroupOffsets(data.shapeK, data.stridesAK);
+    const std::vector<Unsigned> offBK = GroupOffsets(data.shapeK, data.stridesBK);
+    const std::vector<Unsigned> offBN = GroupOffsets(data.shapeN, data.stridesBN);
+    const std::vector<Unsigned> offCM = GroupOffsets(data.shapeM, data.stridesCM);
+    const std::vector<Unsigned> offCN = GroupOffsets(data.shapeN, data.stridesCN);
+    const std::vector<Unsigned> offAL = GroupOffsets(data.shapeL, data.stridesAL);
+    const std::vector<Unsigned> offBL = GroupOffsets(data.shapeL, data.stridesBL);
+    const std::vector<Unsigned> offCL = GroupOffsets(data.shapeL, data.stridesCL);
+    const Unsigned m = offAM.size();
+    const Unsigned n = offBN.size();
+    const Unsigned k = offAK.size();
+    const Unsigned nBatches = offAL.size();
+
+    if(m == 0 || n == 0 || nBatches == 0)
+        return;
+    if(k == 0){
+        for(Unsigned l = 0; l < nBatches; l++)
+            for(Unsigned j = 0; j < n; j++)
+                for(Unsigned i = 0; i < m; i++){
+                    T& c = C[offCL[l] + offCM[i] + offCN[j]];
+                    c = beta == T(0) ? T(0) : beta * c;
+                }
+        return;
+    }
+
+    const Unsigned mc = std::min(m, GettBlockM);
+    const Unsigned nc = std::min(n, GettBlockN);
+    const Unsigned kc = std::min(k, GettBlockK);
+    Memory<T> panels;
+    T* panelA = panels.Require(mc * kc + kc * nc + mc * nc);
+    T* panelB = &(panelA[mc * kc]);
+    T* panelC = &(panelB[kc * nc]);
+
+    //One blocked matrix product per batch
+    for(Unsigned l = 0; l < nBatches; l++){
+        const T* batchA = &(A[offAL[l]]);
+        const T* batchB = &(B[offBL[l]]);
+        T* batchC = &(C[offCL[l]]);
+
+        for(Unsigned jc = 0; jc < n; jc += nc){
+            const Unsigned nb = std::min(nc, n - jc);
+            for(Unsigned pc = 0; pc < k; pc += kc){
+                const Unsigned kb = std::min(kc, k - pc);
+
+                //Column-major kb x nb panel of B
+                for(Unsigned j = 0; j < nb; j++){
+                    const T* bCol = &(batchB[offBN[jc + j]]);
+                    T* panelCol = &(panelB[j * kb]);
+                    for(Unsigned p = 0; p < kb; p++)
+                        panelCol[p] = bCol[offBK[pc + p]];
+                }
+
+                for(Unsigned ic = 0; ic < m; ic += mc){
+                    const Unsigned mb = std::min(mc, m - ic);
+
+                    //Column-major mb x kb panel of A
+                    for(Unsigned p = 0; p < kb; p++){
+                        const T* aCol = &(batchA[offAK[pc + p]]);
+                        T* panelCol = &(panelA[p * mb]);
+                        for(Unsigned i = 0; i < mb; i++)
+                            panelCol[i] = aCol[offAM[ic + i]];
+                    }
+
+                    blas::Gemm('N', 'N', mb, nb, kb, alpha, panelA, mb, panelB, kb, T(0), panelC, mb);
+
+                    //The first K panel also applies beta
+                    const bool scaleC = pc == 0 && beta != T(1);
+                    for(Unsigned j = 0; j < nb; j++){
+                        T* cCol = &(batchC[offCN[jc + j]]);
+                        const T* panelCol = &(panelC[j * mb]);
+                        if(!scaleC){
+                            for(Unsigned i = 0; i < mb; i++)
+                                cCol[offCM[ic + i]] += panelCol[i];
+                        }else if(beta == T(0)){
+                            for(Unsigned i = 0; i < mb; i++)
+                                cCol[offCM[ic + i]] = panelCol[i];
+                        }else{
+                            for(Unsigned i = 0; i < mb; i++){
+                                T& c = cCol[offCM[ic + i]];
+                                c = beta * c + panelCol[i];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+#define PROTO(T) \
+    template void Gett(T alpha, T const * const A, T const * const B, T beta, T * const C, const GettData& data);
+
+PROTO(float)
+PROTO(double)
+
+#ifndef DISABLE_COMPLEX
+#ifndef DISABLE_FLOAT
+PROTO(std::complex<float>)
+#endif
+PROTO(std::complex<double>)
+#endif
+
+} // namespace rote
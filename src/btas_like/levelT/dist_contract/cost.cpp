@@ -0,0 +1,135 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+                      2013, Jeff Hammond
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#include "rote.hpp"
+#include <limits>
+
+namespace {
+
+// Clips the partitioned modes of shape to a single block, returning the
+// number of blocks the partitioning loops visit
+rote::Unsigned BlockShape(rote::ObjShape& shape, const rote::ModeArray& partModes, const std::vector<rote::Unsigned>& blkSizes){
+    rote::Unsigned nBlocks = 1;
+    for(rote::Unsigned i = 0; i < partModes.size(); i++){
+        const rote::Unsigned ext = shape[partModes[i]];
+        const rote::Unsigned blkSize = std::max(1u, blkSizes[i]);
+        nBlocks *= std::max(1u, rote::IntCeil(ext, blkSize));
+        shape[partModes[i]] = std::min(ext, blkSize);
+    }
+    return nBlocks;
+}
+
+// Bytes the most loaded process stores for a tensor of this shape
+double LocalBlockBytes(const rote::ObjShape& shape, const rote::TensorDistribution& dist, const rote::Grid& g, const rote::Unsigned elemSize){
+    const rote::ObjShape gridShape = g.Shape();
+    double bytes = elemSize;
+    for(rote::Unsigned i = 0; i < shape.size(); i++)
+        bytes *= rote::MaxLength(shape[i], std::max(1u, rote::prod(rote::FilterVector(gridShape, dist[i].Entries()))));
+    return bytes;
+}
+
+} // anonymous namespace
+
+namespace rote{
+
+//NOTE: Every variant performs the same local flops, so only the
+//redistributions of one block (times the number of blocks) are modeled
+template <typename T>
+ContractCost Contract<T>::predictCost(
+  ContractVariant variant,
+  const DistTensor<T>& A, const IndexArray& indicesA,
+  const DistTensor<T>& B, const IndexArray& indicesB,
+  const DistTensor<T>& C, const IndexArray& indicesC,
+  const std::vector<Unsigned>& blkSizes
+) {
+  if(variant == StatB){
+    ContractCost cost = Contract<T>::predictCost(StatA, B, indicesB, A, indicesA, C, indicesC, blkSizes);
+    cost.variant = StatB;
+    return cost;
+  }
+
+  const Grid& g = C.Grid();
+  const bool isStatC = variant == StatC || variant == Stat25D;
+  ContractCost cost;
+  cost.variant = variant;
+  cost.measuredTime = -1;
+  cost.predictedTime = std::numeric_limits<double>::max();
+  cost.intermediateBytes = std::numeric_limits<double>::max();
+
+  //2.5D needs replicas of C and something to split between them
+  if(variant == Stat25D && (C.GetGridView().FreeModes().size() == 0 || DiffVector(indicesA, indicesC).size() == 0))
+    return cost;
+
+  BlkContractStatCInfo contractInfo;
+  if(variant == Stat25D)
+    Contract<T>::setContract25DInfo(A, indicesA, B, indicesB, C, indicesC, blkSizes, contractInfo);
+  else
+    Contract<T>::setContractInfo(A, indicesA, B, indicesB, C, indicesC, blkSizes, isStatC, contractInfo);
+
+  //Too few block sizes for this variant's partitioning cannot run it
+  const ModeArray& partModesB = contractInfo.partModesB;
+  if(contractInfo.blkSizes.size() < partModesB.size())
+    return cost;
+
+  ObjShape shapeB = B.Shape();
+  const Unsigned nBlocks = BlockShape(shapeB, partModesB, contractInfo.blkSizes);
+  std::shared_ptr<const RedistPlan> planB = CachedRedistPlan(contractInfo.distIntB, B.TensorDist(), ModeArray(), g, shapeB, sizeof(T));
+  const double bytesB = LocalBlockBytes(shapeB, contractInfo.distIntB, g, sizeof(T));
+
+  if(isStatC){
+    ObjShape shapeA = A.Shape();
+    BlockShape(shapeA, contractInfo.partModesA, contractInfo.blkSizes);
+    std::shared_ptr<const RedistPlan> planA = CachedRedistPlan(contractInfo.distIntA, A.TensorDist(), ModeArray(), g, shapeA, sizeof(T));
+
+    cost.predictedTime = nBlocks * (planA->Cost() + planB->Cost());
+    cost.intermediateBytes = LocalBlockBytes(shapeA, contractInfo.distIntA, g, sizeof(T)) + bytesB;
+
+    //The replicas of C are summed once at the end
+    if(variant == Stat25D){
+      ObjShape shapeT = C.Shape();
+      for(Unsigned i = shapeT.size(); i < contractInfo.distT.size() - 1; i++)
+        shapeT.push_back(std::max(1u, prod(FilterVector(g.Shape(), contractInfo.distT[i].Entries()))));
+      std::shared_ptr<const RedistPlan> planT = CachedRedistPlan(C.TensorDist(), contractInfo.distT, contractInfo.reduceTensorModes, g, shapeT, sizeof(T));
+
+      cost.predictedTime += planT->Cost();
+      cost.intermediateBytes += LocalBlockBytes(shapeT, contractInfo.distT, g, sizeof(T));
+    }
+  }else{
+    ObjShape shapeC = C.Shape();
+    BlockShape(shapeC, contractInfo.partModesC, contractInfo.blkSizes);
+
+    IndexArray indicesT = ConcatenateVectors(indicesC, DiffVector(indicesA, indicesC));
+    ObjShape shapeT(indicesT.size());
+    SetTensorShapeToMatch(A.GetGridView().ParticipatingShape(), indicesA, shapeT, indicesT);
+    SetTensorShapeToMatch(shapeC, indicesC, shapeT, indicesT);
+    std::shared_ptr<const RedistPlan> planT = CachedRedistPlan(C.TensorDist(), contractInfo.distT, contractInfo.reduceTensorModes, g, shapeT, sizeof(T));
+
+    cost.predictedTime = nBlocks * (planB->Cost() + planT->Cost());
+    cost.intermediateBytes = bytesB + LocalBlockBytes(shapeT, contractInfo.distT, g, sizeof(T));
+  }
+  return cost;
+}
+
+#define PROTO(T) \
+	template class Contract<T>;
+
+//PROTO(Unsigned)
+//PROTO(Int)
+PROTO(float)
+PROTO(double)
+//PROTO(char)
+
+#ifndef DISABLE_COMPLEX
+#ifndef DISABLE_FLOAT
+PROTO(std::complex<float>)
+#endif
+PROTO(std::complex<double>)
+#endif
+
+} // namespace rote
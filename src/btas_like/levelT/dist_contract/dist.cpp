@@ -8,6 +8,7 @@
    http://opensource.org/licenses/BSD-2-Clause
 */
 #include "rote.hpp"
+#include <limits>
 
 namespace rote{
 
@@ -34,62 +35,143 @@ void Contract<T>::run(
   for(Unsigned i = 0; i < indicesC.size(); i++)
     indC[i] = indicesC[i];
 
-  //Determine Stationary variant.
-  const Unsigned numElemA = prod(A.Shape());
-  const Unsigned numElemB = prod(B.Shape());
-  const Unsigned numElemC = prod(C.Shape());
+  //Without block sizes, use (or find) the tuned ones
+  if(blkSizes.size() == 0 && ContractAutotuning()){
+    const std::string key = ContractTuningKey(
+      indA, A.Shape(), A.TensorDist(),
+      indB, B.Shape(), B.TensorDist(),
+      indC, C.Shape(), C.TensorDist(),
+      C.Grid(), sizeof(T)
+    );
+    ContractTuning tuning;
+    if(!FindContractTuning(key, C.Grid(), tuning)){
+      tuning = Contract<T>::tune(alpha, A, indA, B, indB, beta, C, indC);
+      StoreContractTuning(key, C.Grid(), tuning);
+    }
+    Contract<T>::runVariant(tuning.variant, alpha, A, indA, B, indB, beta, C, indC, tuning.blkSizes);
+    return;
+  }
 
-  bool isBiggerAB = numElemA > numElemB;
-  bool isBiggerAC = numElemA > numElemC;
-  bool isBiggerBC = numElemB > numElemC;
+  //Otherwise run the variant the cost model favors.  Given block sizes are
+  //for the free indices of C, which only StatA and StatB partition (StatC
+  //and Stat25D partition the contracted indices)
+  std::vector<ContractCost> costs;
+  for(Unsigned v = 0; v < NumContractVariants; v++)
+    if(blkSizes.size() == 0 || v == StatA || v == StatB)
+      costs.push_back(Contract<T>::predictCost((ContractVariant)v, A, indA, B, indB, C, indC, blkSizes));
+  Contract<T>::runVariant(SelectContractVariant(costs), alpha, A, indA, B, indB, beta, C, indC, blkSizes);
+}
 
-  bool isEqualAB = numElemA == numElemB;
+template <typename T>
+std::vector<ContractCost> Contract<T>::costs(
+  T alpha,
+  const DistTensor<T>& A, const std::string& indicesA,
+  const DistTensor<T>& B, const std::string& indicesB,
+  T beta,
+  const DistTensor<T>& C, const std::string& indicesC,
+  const std::vector<Unsigned>& blkSizes, bool measure
+) {
+  const IndexArray indA(indicesA.begin(), indicesA.end());
+  const IndexArray indB(indicesB.begin(), indicesB.end());
+  const IndexArray indC(indicesC.begin(), indicesC.end());
+
+  std::vector<ContractCost> costs(NumContractVariants);
+  for(Unsigned v = 0; v < NumContractVariants; v++){
+    costs[v] = Contract<T>::predictCost((ContractVariant)v, A, indA, B, indB, C, indC, blkSizes);
+    if(measure && costs[v].predictedTime < std::numeric_limits<double>::max())
+      costs[v].measuredTime = Contract<T>::timeVariant((ContractVariant)v, alpha, A, indA, B, indB, beta, C, indC, blkSizes);
+  }
+  return costs;
+}
 
-  bool isSmallerAB = numElemA < numElemB;
-  bool isSmallerAC = numElemA < numElemC;
+// Variant interface
+template <typename T>
+void Contract<T>::runVariant(
+  ContractVariant variant,
+  T alpha,
+  const DistTensor<T>& A, const IndexArray& indicesA,
+  const DistTensor<T>& B, const IndexArray& indicesB,
+  T beta,
+        DistTensor<T>& C, const IndexArray& indicesC,
+  const std::vector<Unsigned>& blkSizes
+) {
+  switch(variant){
+    case StatA: Contract<T>::run(alpha, A, indicesA, B, indicesB, beta, C, indicesC, blkSizes, false); break;
+    case StatB: Contract<T>::run(alpha, B, indicesB, A, indicesA, beta, C, indicesC, blkSizes, false); break;
+    case StatC: Contract<T>::run(alpha, A, indicesA, B, indicesB, beta, C, indicesC, blkSizes, true); break;
+    case Stat25D: Contract<T>::run25D(alpha, A, indicesA, B, indicesB, beta, C, indicesC, blkSizes); break;
+    default: LogicError("Unsupported contraction variant");
+  }
+}
 
-  bool isSmallerEqualAC = numElemA <= numElemC;
-  bool isSmallerEqualBC = numElemB <= numElemC;
+template <typename T>
+double Contract<T>::timeVariant(
+  ContractVariant variant,
+  T alpha,
+  const DistTensor<T>& A, const IndexArray& indicesA,
+  const DistTensor<T>& B, const IndexArray& indicesB,
+  T beta,
+  const DistTensor<T>& C, const IndexArray& indicesC,
+  const std::vector<Unsigned>& blkSizes
+) {
+  const mpi::Comm comm = C.Grid().OwningComm();
+  DistTensor<T> trialC(C);
 
-  bool isBiggerEqualAB = numElemA >= numElemB;
-  bool isBiggerEqualAC = numElemA >= numElemC;
+  mpi::Barrier(comm);
+  const double start = mpi::Time();
+  Contract<T>::runVariant(variant, alpha, A, indicesA, B, indicesB, beta, trialC, indicesC, blkSizes);
+  const double localTime = mpi::Time() - start;
+  double time;
+  mpi::AllReduce(&localTime, &time, 1, mpi::MAX, comm);
+  return time;
+}
 
-  if(isBiggerEqualAB && isBiggerAC){
-    Contract::run(
-      alpha,
-      A, indA,
-      B, indB,
-      beta,
-      C, indC,
-      blkSizes,
-      false
-    );
-  }else if((isSmallerAB && isBiggerEqualAC) ||
-       (isSmallerAB && isSmallerAC && isBiggerBC)){
-    Contract::run(
-      alpha,
-      B, indB,
-      A, indA,
-      beta,
-      C, indC,
-      blkSizes,
-      false
-    );
-  }else if((isBiggerAB && isSmallerEqualAC) ||
-       (isEqualAB && isSmallerEqualAC) ||
-     (isSmallerAB && isSmallerAC && isSmallerEqualBC)){
-    Contract::run(
-      alpha,
-      B, indB,
-      A, indA,
-      beta,
-      C, indC,
-      blkSizes,
-      false
-    );
-  }else{
-    LogicError("Should never occur");
+template <typename T>
+ContractTuning Contract<T>::tune(
+  T alpha,
+  const DistTensor<T>& A, const IndexArray& indicesA,
+  const DistTensor<T>& B, const IndexArray& indicesB,
+  T beta,
+  const DistTensor<T>& C, const IndexArray& indicesC
+) {
+  Unsigned i;
+  ContractTuning best;
+  double bestTime = -1;
+  for(Unsigned v = 0; v < NumContractVariants; v++){
+    const ContractVariant variant = (ContractVariant)v;
+    if(Contract<T>::predictCost(variant, A, indicesA, B, indicesB, C, indicesC, std::vector<Unsigned>()).predictedTime == std::numeric_limits<double>::max())
+      continue;
+
+    //Stationary A or B partitions the others over the indices of C it
+    //lacks; stationary C partitions A and B over the contracted indices
+    IndexArray partIndices;
+    ObjShape partExtents;
+    if(variant == StatC || variant == Stat25D){
+      partIndices = IsectVector(DiffVector(indicesA, indicesC), indicesB);
+      for(i = 0; i < partIndices.size(); i++)
+        partExtents.push_back(A.Dimension(IndexOf(indicesA, partIndices[i])));
+    }else{
+      partIndices = DiffVector(indicesC, variant == StatA ? indicesA : indicesB);
+      for(i = 0; i < partIndices.size(); i++)
+        partExtents.push_back(C.Dimension(IndexOf(indicesC, partIndices[i])));
+    }
+    const Unsigned maxExtent = partExtents.size() == 0 ? 1 : std::max(1u, *std::max_element(partExtents.begin(), partExtents.end()));
+
+    Unsigned blkSize = std::min(ContractTuningMinBlkSize, maxExtent);
+    while(true){
+      const std::vector<Unsigned> blkSizes(partIndices.size(), blkSize);
+      const double time = Contract<T>::timeVariant(variant, alpha, A, indicesA, B, indicesB, beta, C, indicesC, blkSizes);
+      if(bestTime < 0 || time < bestTime){
+        bestTime = time;
+        best.variant = variant;
+        best.blkSizes = blkSizes;
+      }
+      if(blkSize >= maxExtent || partIndices.size() == 0)
+        break;
+      blkSize = std::min(2 * blkSize, maxExtent);
+    }
   }
+  return best;
 }
 
 // Internal interface
@@ -113,24 +195,108 @@ void Contract<T>::run(
 	);
 
 	if (isStatC) {
-		if(contractInfo.permC != C.LocalPermutation()){
-			DistTensor<T> tmpC(C.TensorDist(), C.Grid());
-			tmpC.SetLocalPermutation(contractInfo.permC);
-			Permute(C, tmpC);
-			Scal(beta, tmpC);
-			Contract<T>::runHelperPartitionAB(0, contractInfo, alpha, A, indicesA, B, indicesB, beta, tmpC, indicesC);
-			Permute(tmpC, C);
+		//C stays in its own local permutation; the local kernels contract
+		//into it with its strides and fold beta into the first block
+		if(ContractPipelining()){
+			Pipeline pipeline(contractInfo, C.TensorDist(), C.Grid());
+			for(Unsigned i = 0; i < 2; i++){
+				PipelineSlot& slot = pipeline.Slot(i);
+				slot.intA.SetLocalPermutation(contractInfo.permA);
+				slot.intA.AlignModesWith(contractInfo.alignModesA, C, contractInfo.alignModesATo);
+				slot.intB.AlignModesWith(contractInfo.alignModesB, C, contractInfo.alignModesBTo);
+				slot.intB.SetLocalPermutation(contractInfo.permB);
+			}
+			Contract<T>::runHelperPartitionAB(0, contractInfo, alpha, A, indicesA, B, indicesB, beta, C, indicesC, &pipeline);
+
+			//Drain the oldest slot first
+			for(Unsigned i = 0; i < 2; i++){
+				PipelineSlot& slot = pipeline.Slot((pipeline.next + i) % 2);
+				if(slot.pending)
+					Contract<T>::flushPipelineSlotAB(contractInfo, alpha, indicesA, indicesB, C, indicesC, slot);
+			}
 		}else{
-			Scal(beta, C);
-			Contract<T>::runHelperPartitionAB(0, contractInfo, alpha, A, indicesA, B, indicesB, beta, C, indicesC);
+			Contract<T>::runHelperPartitionAB(0, contractInfo, alpha, A, indicesA, B, indicesB, beta, C, indicesC, 0);
 		}
 	} else {
 		DistTensor<T> tmpA(A.TensorDist(), A.Grid());
 		tmpA.SetLocalPermutation(contractInfo.permA);
 		Permute(A, tmpA);
 
-		Contract<T>::runHelperPartitionBC(0, contractInfo, alpha, tmpA, indicesA, B, indicesB, beta, C, indicesC);
+		if(ContractPipelining()){
+			Pipeline pipeline(contractInfo, C.TensorDist(), C.Grid());
+			for(Unsigned i = 0; i < 2; i++){
+				PipelineSlot& slot = pipeline.Slot(i);
+				slot.intB.AlignModesWith(contractInfo.alignModesB, tmpA, contractInfo.alignModesBTo);
+				slot.intB.SetLocalPermutation(contractInfo.permB);
+			}
+			pipeline.intT.AlignModesWith(contractInfo.alignModesT, tmpA, contractInfo.alignModesTTo);
+			pipeline.intT.SetLocalPermutation(contractInfo.permT);
+			Contract<T>::runHelperPartitionBC(0, contractInfo, alpha, tmpA, indicesA, B, indicesB, beta, C, indicesC, &pipeline);
+
+			//Drain the oldest slot first, then wait for the outstanding updates of C
+			for(Unsigned i = 0; i < 2; i++){
+				PipelineSlot& slot = pipeline.Slot((pipeline.next + i) % 2);
+				if(slot.pending)
+					Contract<T>::flushPipelineSlotBC(contractInfo, alpha, tmpA, indicesA, indicesB, beta, indicesC, pipeline, slot);
+			}
+			for(Unsigned i = 0; i < 2; i++)
+				pipeline.Slot((pipeline.next + i) % 2).reqC.Wait();
+		}else{
+			Contract<T>::runHelperPartitionBC(0, contractInfo, alpha, tmpA, indicesA, B, indicesB, beta, C, indicesC, 0);
+		}
+	}
+}
+
+template <typename T>
+void Contract<T>::run25D(
+  T alpha,
+	const DistTensor<T>& A, const IndexArray& indicesA,
+	const DistTensor<T>& B, const IndexArray& indicesB,
+  T beta,
+	      DistTensor<T>& C, const IndexArray& indicesC,
+	const std::vector<Unsigned>& blkSizes
+) {
+	BlkContractStatCInfo contractInfo;
+	Contract<T>::setContract25DInfo(
+		A, indicesA,
+		B, indicesB,
+		C, indicesC,
+		blkSizes, contractInfo
+	);
+
+	//The copies of C accumulate in the trailing (reduced) modes of T
+	IndexArray indicesT = ConcatenateVectors(indicesC, DiffVector(indicesA, indicesC));
+	ObjShape shapeT = C.Shape();
+	for(Unsigned i = indicesC.size(); i < indicesT.size(); i++)
+		shapeT.push_back(std::max(1u, prod(FilterVector(C.Grid().Shape(), contractInfo.distT[i].Entries()))));
+
+	DistTensor<T> intT(shapeT, contractInfo.distT, C.Grid());
+	intT.SetLocalPermutation(contractInfo.permC);
+	intT.ResizeTo(shapeT);
+	Zero(intT);
+
+	if(ContractPipelining()){
+		Pipeline pipeline(contractInfo, contractInfo.distT, C.Grid());
+		for(Unsigned i = 0; i < 2; i++){
+			PipelineSlot& slot = pipeline.Slot(i);
+			slot.intA.SetLocalPermutation(contractInfo.permA);
+			slot.intA.AlignModesWith(contractInfo.alignModesA, intT, contractInfo.alignModesATo);
+			slot.intB.AlignModesWith(contractInfo.alignModesB, intT, contractInfo.alignModesBTo);
+			slot.intB.SetLocalPermutation(contractInfo.permB);
+		}
+		Contract<T>::runHelperPartitionAB(0, contractInfo, alpha, A, indicesA, B, indicesB, T(1), intT, indicesT, &pipeline);
+
+		//Drain the oldest slot first
+		for(Unsigned i = 0; i < 2; i++){
+			PipelineSlot& slot = pipeline.Slot((pipeline.next + i) % 2);
+			if(slot.pending)
+				Contract<T>::flushPipelineSlotAB(contractInfo, alpha, indicesA, indicesB, intT, indicesT, slot);
+		}
+	}else{
+		Contract<T>::runHelperPartitionAB(0, contractInfo, alpha, A, indicesA, B, indicesB, T(1), intT, indicesT, 0);
 	}
+
+	C.RedistFrom(intT, contractInfo.reduceTensorModes, T(1), beta);
 }
 
 #define PROTO(T) \
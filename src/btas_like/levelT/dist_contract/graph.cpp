@@ -0,0 +1,284 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+                      2013, Jeff Hammond
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#include "rote.hpp"
+#include <map>
+
+namespace rote{
+
+template <typename T>
+ExprGraph<T>::ExprGraph()
+{ }
+
+template <typename T>
+DistTensor<T>& ExprGraph<T>::Temporary(const ObjShape& shape, const TensorDistribution& dist, const Grid& g) {
+  std::shared_ptr<DistTensor<T> > temp(new DistTensor<T>(shape, dist, g));
+  Zero(*temp);
+  temps_.push_back(temp);
+  return *temp;
+}
+
+template <typename T>
+typename ExprGraph<T>::Node& ExprGraph<T>::record(ExprOp op, T alpha, T beta, const DistTensor<T>* A, const DistTensor<T>* B, DistTensor<T>* C) {
+  Node node;
+  node.op = op;
+  node.alpha = alpha;
+  node.beta = beta;
+  node.A = A;
+  node.B = B;
+  node.C = C;
+  node.statB = false;
+  node.operand = -1;
+  nodes_.push_back(node);
+  return nodes_.back();
+}
+
+template <typename T>
+void ExprGraph<T>::GenContract(
+  T alpha,
+  const DistTensor<T>& A, const std::string& indicesA,
+  const DistTensor<T>& B, const std::string& indicesB,
+  T beta,
+        DistTensor<T>& C, const std::string& indicesC,
+  const std::vector<Unsigned>& blkSizes
+) {
+  Node& node = record(ContractOp, alpha, beta, &A, &B, &C);
+  node.indicesA = IndexArray(indicesA.begin(), indicesA.end());
+  node.indicesB = IndexArray(indicesB.begin(), indicesB.end());
+  node.indicesC = IndexArray(indicesC.begin(), indicesC.end());
+  node.blkSizes = blkSizes;
+}
+
+template <typename T>
+void ExprGraph<T>::YAxpBy(T alpha, const DistTensor<T>& X, T beta, DistTensor<T>& Y) {
+  record(YAxpByOp, alpha, beta, &X, 0, &Y);
+}
+
+template <typename T>
+void ExprGraph<T>::ZAxpBy(T alpha, const DistTensor<T>& X, T beta, const DistTensor<T>& Y, DistTensor<T>& Z) {
+  record(ZAxpByOp, alpha, beta, &X, &Y, &Z);
+}
+
+template <typename T>
+void ExprGraph<T>::GenYAxpPx(T alpha, const DistTensor<T>& X, T beta, const Permutation& perm, DistTensor<T>& Y) {
+  Node& node = record(GenYAxpPxOp, alpha, beta, &X, 0, &Y);
+  node.perm = perm;
+}
+
+template <typename T>
+void ExprGraph<T>::plan() {
+  Unsigned i, n;
+  operands_.clear();
+
+  //Number of recorded writes to each tensor before the current node
+  std::map<const DistTensor<T>*, Unsigned> versions;
+  for(n = 0; n < nodes_.size(); n++){
+    Node& node = nodes_[n];
+    if(node.op == ContractOp && node.blkSizes.size() == 0 && node.C != node.A && node.C != node.B){
+      const Grid& g = node.C->Grid();
+
+      //Terms are not blocked, so model a single block
+      const ObjShape shapeC = node.C->Shape();
+      const Unsigned maxExtent = shapeC.size() == 0 ? 1 : std::max(1u, *std::max_element(shapeC.begin(), shapeC.end()));
+      const std::vector<Unsigned> blkSizes(node.indicesC.size(), maxExtent);
+
+      double bestCost = 0;
+      double bestBytes = 0;
+      Int bestShared = -1;
+      std::shared_ptr<DistTensor<T> > bestIntB;
+      for(Unsigned s = 0; s < 2; s++){
+        const bool statB = s == 1;
+        const DistTensor<T>& stat = statB ? *node.B : *node.A;
+        const DistTensor<T>& moving = statB ? *node.A : *node.B;
+        const IndexArray& indicesStat = statB ? node.indicesB : node.indicesA;
+        const IndexArray& indicesMoving = statB ? node.indicesA : node.indicesB;
+
+        BlkContractStatCInfo contractInfo;
+        rote::Contract<T>::setContractInfo(
+          stat, indicesStat,
+          moving, indicesMoving,
+          *node.C, node.indicesC,
+          std::vector<Unsigned>(), false,
+          contractInfo
+        );
+        std::shared_ptr<DistTensor<T> > intB(new DistTensor<T>(contractInfo.distIntB, g));
+        intB->AlignModesWith(contractInfo.alignModesB, stat, contractInfo.alignModesBTo);
+        intB->SetLocalPermutation(contractInfo.permB);
+
+        //The local permutation of a shared redistribution is the one its
+        //first user chose; later users contract with its strides
+        Int shared = -1;
+        for(i = 0; i < operands_.size() && shared < 0; i++){
+          const Operand& operand = operands_[i];
+          if(operand.src == &moving && operand.version == versions[&moving] &&
+             operand.tensor->TensorDist() == intB->TensorDist() &&
+             operand.tensor->Alignments() == intB->Alignments())
+            shared = i;
+        }
+
+        const ContractCost statCost = rote::Contract<T>::predictCost(StatA, stat, indicesStat, moving, indicesMoving, *node.C, node.indicesC, blkSizes);
+        double cost = statCost.predictedTime;
+        if(shared >= 0)
+          cost -= CachedRedistPlan(contractInfo.distIntB, moving.TensorDist(), ModeArray(), g, moving.Shape(), sizeof(T))->Cost();
+
+        if(s == 0 || cost < bestCost){
+          bestCost = cost;
+          bestBytes = statCost.intermediateBytes;
+          bestShared = shared;
+          bestIntB = intB;
+          node.statB = statB;
+          node.contractInfo = contractInfo;
+        }
+      }
+
+      //Intermediates too large to hold are left to the blocked Contract
+      const std::size_t limit = ContractMemoryLimit();
+      if(limit > 0 && bestBytes > limit){
+        versions[node.C]++;
+        continue;
+      }
+
+      if(bestShared < 0){
+        Operand operand;
+        operand.src = node.statB ? node.A : node.B;
+        operand.version = versions[operand.src];
+        operand.tensor = bestIntB;
+        operand.uses = 0;
+        operand.ready = false;
+        operands_.push_back(operand);
+        bestShared = operands_.size() - 1;
+      }
+      operands_[bestShared].uses++;
+      node.operand = bestShared;
+    }
+    versions[node.C]++;
+  }
+}
+
+template <typename T>
+void ExprGraph<T>::Evaluate() {
+  PROFILE_SECTION("ExprGraph");
+  Unsigned i, n;
+  plan();
+
+  //Last node using each temporary
+  std::vector<Int> lastUse(temps_.size(), -1);
+  for(n = 0; n < nodes_.size(); n++){
+    const Node& node = nodes_[n];
+    for(i = 0; i < temps_.size(); i++){
+      const DistTensor<T>* temp = temps_[i].get();
+      if(node.A == temp || node.B == temp || node.C == temp)
+        lastUse[i] = n;
+    }
+  }
+
+  std::vector<std::shared_ptr<ContractSum<T> > > sums;
+  for(n = 0; n < nodes_.size(); n++){
+    const Node& node = nodes_[n];
+
+    //Reduce pending terms into any output this node uses, unless it only
+    //adds another term to it
+    for(i = 0; i < sums.size();){
+      const DistTensor<T>* out = &(sums[i]->C_);
+      const bool adds = node.operand >= 0 && node.C == out && node.beta == T(1) && node.indicesC == sums[i]->indicesC_;
+      if(!adds && (node.A == out || node.B == out || node.C == out)){
+        sums[i]->Finish();
+        sums.erase(sums.begin() + i);
+      }else{
+        i++;
+      }
+    }
+
+    switch(node.op){
+    case ContractOp:
+      if(node.operand < 0){
+        rote::Contract<T>::run(
+          node.alpha,
+          *node.A, std::string(node.indicesA.begin(), node.indicesA.end()),
+          *node.B, std::string(node.indicesB.begin(), node.indicesB.end()),
+          node.beta,
+          *node.C, std::string(node.indicesC.begin(), node.indicesC.end()),
+          node.blkSizes
+        );
+      }else{
+        std::shared_ptr<ContractSum<T> > sum;
+        for(i = 0; i < sums.size() && !sum; i++)
+          if(&(sums[i]->C_) == node.C)
+            sum = sums[i];
+        if(!sum){
+          sum.reset(new ContractSum<T>(node.beta, *node.C, std::string(node.indicesC.begin(), node.indicesC.end())));
+          sums.push_back(sum);
+        }
+
+        Operand& operand = operands_[node.operand];
+        const DistTensor<T>& moving = node.statB ? *node.A : *node.B;
+        if(!operand.ready){
+          operand.tensor->RedistFrom(moving);
+          operand.ready = true;
+        }
+        if(node.statB)
+          sum->accumulate(node.alpha, *node.B, node.indicesB, *operand.tensor, node.indicesA, node.contractInfo);
+        else
+          sum->accumulate(node.alpha, *node.A, node.indicesA, *operand.tensor, node.indicesB, node.contractInfo);
+
+        if(--operand.uses == 0)
+          operand.tensor.reset();
+      }
+      break;
+    case YAxpByOp:
+      rote::YAxpBy(node.alpha, *node.A, node.beta, *node.C);
+      break;
+    case ZAxpByOp:
+      rote::ZAxpBy(node.alpha, *node.A, node.beta, *node.B, *node.C);
+      break;
+    case GenYAxpPxOp:
+      rote::GenYAxpPx(node.alpha, *node.A, node.beta, node.perm, *node.C);
+      break;
+    }
+
+    //Temporaries nothing reads again are dropped, pending terms included
+    for(i = 0; i < temps_.size(); i++){
+      if(lastUse[i] != (Int)n)
+        continue;
+      for(Unsigned j = 0; j < sums.size(); j++){
+        if(&(sums[j]->C_) == temps_[i].get()){
+          sums.erase(sums.begin() + j);
+          break;
+        }
+      }
+      temps_[i]->EmptyData();
+    }
+  }
+
+  for(i = 0; i < sums.size(); i++)
+    sums[i]->Finish();
+
+  nodes_.clear();
+  operands_.clear();
+  temps_.clear();
+  PROFILE_STOP;
+}
+
+#define PROTO(T) \
+	template class ExprGraph<T>;
+
+//PROTO(Unsigned)
+//PROTO(Int)
+PROTO(float)
+PROTO(double)
+//PROTO(char)
+
+#ifndef DISABLE_COMPLEX
+#ifndef DISABLE_FLOAT
+PROTO(std::complex<float>)
+#endif
+PROTO(std::complex<double>)
+#endif
+
+} // namespace rote
@@ -24,7 +24,7 @@ void Contract<T>::run(
   if (doEliminate) {
     Unsigned i;
     Unsigned order = C.Order();
-    IndexArray contractIndices = DetermineContractIndices(indicesA, indicesB);
+    IndexArray contractIndices = DiffVector(DetermineContractIndices(indicesA, indicesB), indicesC);
 
     ModeArray uModes(contractIndices.size());
     for(i = 0; i < uModes.size(); i++)
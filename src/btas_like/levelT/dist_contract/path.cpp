@@ -0,0 +1,445 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+                      2013, Jeff Hammond
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#include "rote.hpp"
+#include <limits>
+#include <sstream>
+
+namespace {
+
+// Paths are kept per signature (and cost model), and flushed wholesale once
+// there are this many
+const std::size_t maxCachedPaths = 256;
+std::map<std::string, rote::ContractPath> pathCache;
+
+std::string ContractPathKey(const std::vector<std::string>& indices, const std::vector<rote::ObjShape>& shapes, const std::vector<rote::TensorDistribution>& dists, const rote::Grid& g, const rote::Unsigned elemSize){
+    rote::Unsigned i;
+    std::ostringstream key;
+    key.precision(17);
+    for(rote::Unsigned t = 0; t < indices.size(); t++){
+        key << indices[t] << ":";
+        for(i = 0; i < shapes[t].size(); i++)
+            key << (i == 0 ? "" : ",") << shapes[t][i];
+        key << ":" << rote::TensorDistToString(dists[t]) << "|";
+    }
+    for(i = 0; i < g.Order(); i++)
+        key << (i == 0 ? "" : ",") << g.Dimension(i);
+    const rote::CommCostModel& model = rote::GetCommCostModel();
+    key << "|" << elemSize << "|" << model.alpha << "," << model.beta << "," << model.gamma;
+    key << "|" << rote::ContractFlopTime() << "|" << rote::ContractMemoryLimit();
+    return key.str();
+}
+
+// Bytes the most loaded process stores for a tensor of this shape
+double LocalBytes(const rote::ObjShape& shape, const rote::TensorDistribution& dist, const rote::Grid& g, const rote::Unsigned elemSize){
+    const rote::ObjShape gridShape = g.Shape();
+    double bytes = elemSize;
+    for(rote::Unsigned i = 0; i < shape.size(); i++)
+        bytes *= rote::MaxLength(shape[i], std::max(1u, rote::prod(rote::FilterVector(gridShape, dist[i].Entries()))));
+    return bytes;
+}
+
+// Gives each mode the grid modes it asks for, modes of larger extent first,
+// skipping grid modes already taken
+rote::TensorDistribution ResolveDist(const rote::ObjShape& shape, const std::vector<rote::ModeArray>& wanted, const rote::Unsigned gridOrder){
+    rote::Unsigned i, j;
+    std::vector<rote::Unsigned> order(shape.size());
+    for(i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&shape](rote::Unsigned a, rote::Unsigned b){ return shape[a] > shape[b]; });
+
+    std::vector<bool> used(gridOrder, false);
+    std::vector<rote::ModeArray> entries(shape.size());
+    for(i = 0; i < order.size(); i++){
+        const rote::ModeArray& modes = wanted[order[i]];
+        for(j = 0; j < modes.size(); j++){
+            if(!used[modes[j]]){
+                used[modes[j]] = true;
+                entries[order[i]].push_back(modes[j]);
+            }
+        }
+    }
+
+    std::vector<rote::ModeDistribution> dist(shape.size() + 1);
+    for(i = 0; i < shape.size(); i++)
+        dist[i] = rote::ModeDistribution(entries[i]);
+    return rote::TensorDistribution(dist);
+}
+
+// Deals the non-trivial grid modes (largest first) to whichever mode of
+// the tensor has the longest local extent at the time
+rote::TensorDistribution BalancedDist(const rote::ObjShape& shape, const rote::Grid& g){
+    rote::Unsigned i;
+    const rote::ObjShape gridShape = g.Shape();
+    std::vector<rote::Unsigned> gridModes;
+    for(i = 0; i < gridShape.size(); i++)
+        if(gridShape[i] > 1)
+            gridModes.push_back(i);
+    std::stable_sort(gridModes.begin(), gridModes.end(), [&gridShape](rote::Unsigned a, rote::Unsigned b){ return gridShape[a] > gridShape[b]; });
+
+    std::vector<rote::ModeArray> wanted(shape.size());
+    std::vector<rote::Unsigned> split(shape.size(), 1);
+    for(i = 0; i < gridModes.size() && shape.size() > 0; i++){
+        rote::Unsigned best = 0;
+        for(rote::Unsigned j = 1; j < shape.size(); j++)
+            if(rote::IntCeil(shape[j], split[j]) > rote::IntCeil(shape[best], split[best]))
+                best = j;
+        wanted[best].push_back(gridModes[i]);
+        split[best] *= gridShape[gridModes[i]];
+    }
+    return ResolveDist(shape, wanted, gridShape.size());
+}
+
+// An intermediate (or operand) of the search: a set of operands, the
+// indices left once they are contracted, and the distributions considered
+struct PathNode
+{
+    rote::IndexArray indices;
+    rote::ObjShape shape;
+    std::vector<rote::TensorDistribution> dists;
+    std::vector<double> bytes;
+};
+
+// Cheapest way found to form a node in one of its distributions
+struct PathChoice
+{
+    bool valid;
+    double time;
+    double bytes;
+    rote::Unsigned left;
+    rote::Unsigned leftDist;
+    rote::Unsigned right;
+    rote::Unsigned rightDist;
+};
+
+bool Cheaper(double time, double bytes, const PathChoice& than){
+    if(!than.valid)
+        return true;
+    const std::size_t limit = rote::ContractMemoryLimit();
+    if(limit > 0 && (bytes <= limit) != (than.bytes <= limit))
+        return bytes <= limit;
+    if(time != than.time)
+        return time < than.time;
+    return bytes < than.bytes;
+}
+
+} // anonymous namespace
+
+namespace rote{
+
+template <typename T>
+void Contract<T>::run(
+  T alpha,
+  const ContractOperand<T>& A,
+  const ContractOperand<T>& B,
+  const ContractOperand<T>& C,
+  T beta,
+        DistTensor<T>& D, const std::string& indicesD
+) {
+  std::vector<ContractOperand<T> > operands;
+  operands.push_back(A);
+  operands.push_back(B);
+  operands.push_back(C);
+  Contract<T>::run(alpha, operands, beta, D, indicesD);
+}
+
+template <typename T>
+void Contract<T>::run(
+  T alpha,
+  const std::vector<ContractOperand<T> >& operands,
+  T beta,
+        DistTensor<T>& D, const std::string& indicesD
+) {
+  Unsigned i;
+  if(operands.size() == 2){
+    Contract<T>::run(alpha, operands[0].tensor, operands[0].indices, operands[1].tensor, operands[1].indices, beta, D, indicesD, std::vector<Unsigned>());
+    return;
+  }
+
+  PROFILE_SECTION("ContractPath");
+  const Unsigned n = operands.size();
+  std::vector<std::string> keyIndices(1, indicesD);
+  std::vector<ObjShape> keyShapes(1, D.Shape());
+  std::vector<TensorDistribution> keyDists(1, D.TensorDist());
+  for(i = 0; i < n; i++){
+    keyIndices.push_back(operands[i].indices);
+    keyShapes.push_back(operands[i].tensor.Shape());
+    keyDists.push_back(operands[i].tensor.TensorDist());
+  }
+  const std::string key = ContractPathKey(keyIndices, keyShapes, keyDists, D.Grid(), sizeof(T));
+  std::map<std::string, ContractPath>::const_iterator it = ::pathCache.find(key);
+  if(it == ::pathCache.end()){
+    if(::pathCache.size() >= ::maxCachedPaths)
+      ::pathCache.clear();
+    it = ::pathCache.insert(std::make_pair(key, Contract<T>::path(operands, D, indicesD))).first;
+  }
+  const ContractPath& path = it->second;
+
+  std::vector<const DistTensor<T>*> tensors(n + path.steps.size());
+  std::vector<std::string> indices(n + path.steps.size());
+  for(i = 0; i < n; i++){
+    tensors[i] = &(operands[i].tensor);
+    indices[i] = operands[i].indices;
+  }
+
+  //Intermediates are freed once contracted
+  std::vector<std::shared_ptr<DistTensor<T> > > temps(path.steps.size());
+  for(i = 0; i < path.steps.size(); i++){
+    const ContractPathStep& step = path.steps[i];
+    if(i == path.steps.size() - 1){
+      Contract<T>::run(alpha, *tensors[step.left], indices[step.left], *tensors[step.right], indices[step.right], beta, D, indicesD, std::vector<Unsigned>());
+    }else{
+      temps[i].reset(new DistTensor<T>(step.shape, step.dist, D.Grid()));
+      Zero(*temps[i]);
+      tensors[n + i] = temps[i].get();
+      indices[n + i] = std::string(step.indices.begin(), step.indices.end());
+      Contract<T>::run(T(1), *tensors[step.left], indices[step.left], *tensors[step.right], indices[step.right], T(0), *temps[i], indices[n + i], std::vector<Unsigned>());
+    }
+    if(step.left >= n)
+      temps[step.left - n].reset();
+    if(step.right >= n)
+      temps[step.right - n].reset();
+  }
+  PROFILE_STOP;
+}
+
+//NOTE: Every index appears in exactly two of the operands and D, so the
+//      indices left after contracting a set of operands are those appearing
+//      once among them.  Sets are searched by increasing bitmask, so both
+//      halves of a split are settled before the set itself.
+template <typename T>
+ContractPath Contract<T>::path(
+  const std::vector<ContractOperand<T> >& operands,
+  const DistTensor<T>& D, const std::string& indicesD
+) {
+  Unsigned i, j;
+  const Unsigned n = operands.size();
+  if(n < 2)
+    LogicError("Contract needs at least two operands");
+  if(n >= 8 * sizeof(Unsigned))
+    LogicError("Too many operands to Contract");
+  const Grid& g = D.Grid();
+  const Unsigned full = (1u << n) - 1;
+
+  std::vector<IndexArray> ind(n);
+  for(i = 0; i < n; i++)
+    ind[i] = IndexArray(operands[i].indices.begin(), operands[i].indices.end());
+  const IndexArray indD(indicesD.begin(), indicesD.end());
+
+  //Check the indices pair up and agree on their extents
+  std::map<Index, Unsigned> counts;
+  std::map<Index, Unsigned> extents;
+  for(i = 0; i <= n; i++){
+    const IndexArray& indices = i < n ? ind[i] : indD;
+    const ObjShape shape = i < n ? operands[i].tensor.Shape() : D.Shape();
+    if(indices.size() != shape.size())
+      LogicError("Contract operand indices must match its order");
+    for(j = 0; j < indices.size(); j++){
+      counts[indices[j]]++;
+      if(extents.count(indices[j]) && extents[indices[j]] != shape[j])
+        LogicError("Contract operands disagree on the extent of an index");
+      extents[indices[j]] = shape[j];
+    }
+  }
+  for(std::map<Index, Unsigned>::const_iterator it = counts.begin(); it != counts.end(); it++)
+    if(it->second != 2)
+      LogicError("Each index must appear in exactly two of the Contract operands and output");
+
+  //Describe every set of operands, and lay out (without data) each
+  //distribution considered for it so the cost model can be queried
+  std::vector<PathNode> nodes(full + 1);
+  std::vector<std::vector<const DistTensor<T>*> > layouts(full + 1);
+  std::vector<std::shared_ptr<DistTensor<T> > > owned;
+  for(Unsigned set = 1; set <= full; set++){
+    PathNode& node = nodes[set];
+    if(set == full){
+      node.indices = indD;
+      node.shape = D.Shape();
+      node.dists.push_back(D.TensorDist());
+      node.bytes.push_back(0);
+      layouts[set].push_back(&D);
+      continue;
+    }
+    if((set & (set - 1)) == 0){
+      for(i = 0; (set >> i) != 1; i++);
+      node.indices = ind[i];
+      node.shape = operands[i].tensor.Shape();
+      node.dists.push_back(operands[i].tensor.TensorDist());
+      node.bytes.push_back(0);
+      layouts[set].push_back(&(operands[i].tensor));
+      continue;
+    }
+
+    //Indices left, each wanting the grid modes of the operand it comes
+    //from, or of D if it survives to the output
+    std::vector<ModeArray> fromOperands;
+    std::vector<ModeArray> fromOutput;
+    for(i = 0; i < n; i++){
+      if(!(set & (1u << i)))
+        continue;
+      const TensorDistribution dist = operands[i].tensor.TensorDist();
+      for(j = 0; j < ind[i].size(); j++){
+        Unsigned seen = 0;
+        for(Unsigned k = 0; k < n; k++)
+          if(set & (1u << k))
+            seen += Contains(ind[k], ind[i][j]) ? 1 : 0;
+        if(seen != 1)
+          continue;
+        node.indices.push_back(ind[i][j]);
+        node.shape.push_back(extents[ind[i][j]]);
+        fromOperands.push_back(dist[j].Entries());
+        const int d = IndexOf(indD, ind[i][j]);
+        fromOutput.push_back(d >= 0 ? D.TensorDist()[d].Entries() : dist[j].Entries());
+      }
+    }
+
+    TensorDistribution candidates[3] = {
+      ResolveDist(node.shape, fromOutput, g.Order()),
+      ResolveDist(node.shape, fromOperands, g.Order()),
+      BalancedDist(node.shape, g)
+    };
+    for(i = 0; i < 3; i++){
+      bool seen = false;
+      for(j = 0; j < node.dists.size() && !seen; j++)
+        seen = node.dists[j] == candidates[i];
+      if(seen)
+        continue;
+      node.dists.push_back(candidates[i]);
+      node.bytes.push_back(LocalBytes(node.shape, candidates[i], g, sizeof(T)));
+
+      std::shared_ptr<DistTensor<T> > layout(new DistTensor<T>(candidates[i], g));
+      layout->LockedAttach(node.shape, std::vector<Unsigned>(node.shape.size(), 0), 0, std::vector<Unsigned>(node.shape.size(), 1), g);
+      owned.push_back(layout);
+      layouts[set].push_back(layout.get());
+    }
+  }
+
+  //Cheapest way to form each set, in each of its distributions
+  const Unsigned nProcs = prod(g.Shape());
+  std::vector<std::vector<PathChoice> > best(full + 1);
+  for(Unsigned set = 1; set <= full; set++){
+    PathChoice none;
+    none.valid = false;
+    best[set].assign(nodes[set].dists.size(), none);
+    if((set & (set - 1)) == 0){
+      best[set][0].valid = true;
+      best[set][0].time = 0;
+      best[set][0].bytes = 0;
+      continue;
+    }
+
+    //Splits keep the lowest operand on the left so each is tried once
+    const Unsigned low = set & (~set + 1);
+    for(Unsigned left = (set - 1) & set; left > 0; left = (left - 1) & set){
+      if(!(left & low))
+        continue;
+      const Unsigned right = set ^ left;
+      const PathNode& nodeL = nodes[left];
+      const PathNode& nodeR = nodes[right];
+
+      //Every distribution performs the same local flops
+      double flops = 2.0 / nProcs;
+      IndexArray all = nodeL.indices;
+      for(i = 0; i < nodeR.indices.size(); i++)
+        if(!Contains(all, nodeR.indices[i]))
+          all.push_back(nodeR.indices[i]);
+      for(i = 0; i < all.size(); i++)
+        flops *= extents[all[i]];
+
+      for(Unsigned dL = 0; dL < nodeL.dists.size(); dL++){
+        if(!best[left][dL].valid)
+          continue;
+        for(Unsigned dR = 0; dR < nodeR.dists.size(); dR++){
+          if(!best[right][dR].valid)
+            continue;
+          for(Unsigned d = 0; d < nodes[set].dists.size(); d++){
+            std::vector<ContractCost> costs(NumContractVariants);
+            for(Unsigned v = 0; v < NumContractVariants; v++)
+              costs[v] = Contract<T>::predictCost((ContractVariant)v, *layouts[left][dL], nodeL.indices, *layouts[right][dR], nodeR.indices, *layouts[set][d], nodes[set].indices, std::vector<Unsigned>());
+            const ContractCost& cost = costs[SelectContractVariant(costs)];
+            if(cost.predictedTime == std::numeric_limits<double>::max())
+              continue;
+
+            const PathChoice& choiceL = best[left][dL];
+            const PathChoice& choiceR = best[right][dR];
+            const double sizeL = nodeL.bytes[dL];
+            const double sizeR = nodeR.bytes[dR];
+            const double time = choiceL.time + choiceR.time + cost.predictedTime + flops * ContractFlopTime();
+            const double bytes = std::max(std::max(choiceL.bytes, sizeL + choiceR.bytes), sizeL + sizeR + cost.intermediateBytes + nodes[set].bytes[d]);
+            if(Cheaper(time, bytes, best[set][d])){
+              PathChoice& choice = best[set][d];
+              choice.valid = true;
+              choice.time = time;
+              choice.bytes = bytes;
+              choice.left = left;
+              choice.leftDist = dL;
+              choice.right = right;
+              choice.rightDist = dR;
+            }
+          }
+        }
+      }
+    }
+  }
+  if(!best[full][0].valid)
+    LogicError("No way found to run the Contract");
+
+  //Unwind the choices into steps, operands before the steps using them
+  ContractPath path;
+  path.predictedTime = best[full][0].time;
+  path.peakBytes = best[full][0].bytes;
+  std::vector<std::pair<Unsigned, Unsigned> > stack(1, std::make_pair(full, 0u));
+  std::vector<std::pair<Unsigned, Unsigned> > order;
+  while(stack.size() > 0){
+    const std::pair<Unsigned, Unsigned> top = stack.back();
+    stack.pop_back();
+    if((top.first & (top.first - 1)) == 0)
+      continue;
+    order.push_back(top);
+    const PathChoice& choice = best[top.first][top.second];
+    stack.push_back(std::make_pair(choice.left, choice.leftDist));
+    stack.push_back(std::make_pair(choice.right, choice.rightDist));
+  }
+  std::reverse(order.begin(), order.end());
+
+  std::map<Unsigned, Unsigned> ids;
+  for(i = 0; i < n; i++)
+    ids[1u << i] = i;
+  for(i = 0; i < order.size(); i++){
+    const Unsigned set = order[i].first;
+    const PathChoice& choice = best[set][order[i].second];
+    ContractPathStep step;
+    step.left = ids[choice.left];
+    step.right = ids[choice.right];
+    step.indices = nodes[set].indices;
+    step.shape = nodes[set].shape;
+    step.dist = nodes[set].dists[order[i].second];
+    ids[set] = n + i;
+    path.steps.push_back(step);
+  }
+  return path;
+}
+
+#define PROTO(T) \
+	template class Contract<T>;
+
+//PROTO(Unsigned)
+//PROTO(Int)
+PROTO(float)
+PROTO(double)
+//PROTO(char)
+
+#ifndef DISABLE_COMPLEX
+#ifndef DISABLE_FLOAT
+PROTO(std::complex<float>)
+#endif
+PROTO(std::complex<double>)
+#endif
+
+} // namespace rote
@@ -0,0 +1,161 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+                      2013, Jeff Hammond
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#include "rote.hpp"
+
+namespace rote{
+
+template <typename T>
+ContractSum<T>::ContractSum(T beta, DistTensor<T>& C, const std::string& indicesC)
+: beta_(beta), C_(C), indicesC_(indicesC.begin(), indicesC.end()), finished_(false), scaled_(false)
+{ }
+
+template <typename T>
+void ContractSum<T>::Add(
+  T alpha,
+  const DistTensor<T>& A, const std::string& indicesA,
+  const DistTensor<T>& B, const std::string& indicesB
+) {
+  if(finished_)
+    LogicError("Cannot add terms to a finished ContractSum");
+  const IndexArray indA(indicesA.begin(), indicesA.end());
+  const IndexArray indB(indicesB.begin(), indicesB.end());
+
+  //Keep whichever operand the cost model favors stationary.  Terms are not
+  //blocked, so model a single block
+  const ObjShape shapeC = C_.Shape();
+  const Unsigned maxExtent = shapeC.size() == 0 ? 1 : std::max(1u, *std::max_element(shapeC.begin(), shapeC.end()));
+  const std::vector<Unsigned> blkSizes(indicesC_.size(), maxExtent);
+  const ContractCost costA = Contract<T>::predictCost(StatA, A, indA, B, indB, C_, indicesC_, blkSizes);
+  const ContractCost costB = Contract<T>::predictCost(StatB, A, indA, B, indB, C_, indicesC_, blkSizes);
+  const bool statB = costB.predictedTime < costA.predictedTime;
+
+  //An unblocked intermediate too large to hold is left to the blocked
+  //Contract, which updates C straight away
+  const std::size_t limit = ContractMemoryLimit();
+  if(limit > 0 && (statB ? costB : costA).intermediateBytes > limit){
+    Contract<T>::run(alpha, A, indicesA, B, indicesB, scaled_ ? T(1) : beta_, C_, std::string(indicesC_.begin(), indicesC_.end()), std::vector<Unsigned>());
+    scaled_ = true;
+    return;
+  }
+
+  if(statB)
+    addStationaryA(alpha, B, indB, A, indA);
+  else
+    addStationaryA(alpha, A, indA, B, indB);
+}
+
+template <typename T>
+void ContractSum<T>::addStationaryA(
+  T alpha,
+  const DistTensor<T>& A, const IndexArray& indicesA,
+  const DistTensor<T>& B, const IndexArray& indicesB
+) {
+  const Grid& g = C_.Grid();
+  BlkContractStatCInfo contractInfo;
+  Contract<T>::setContractInfo(
+    A, indicesA,
+    B, indicesB,
+    C_, indicesC_,
+    std::vector<Unsigned>(), false,
+    contractInfo
+  );
+
+  DistTensor<T> tmpA(A.TensorDist(), g);
+  tmpA.SetLocalPermutation(contractInfo.permA);
+  Permute(A, tmpA);
+
+  DistTensor<T> intB(contractInfo.distIntB, g);
+  intB.AlignModesWith(contractInfo.alignModesB, tmpA, contractInfo.alignModesBTo);
+  intB.SetLocalPermutation(contractInfo.permB);
+  intB.RedistFrom(B);
+
+  accumulate(alpha, tmpA, indicesA, intB, indicesB, contractInfo);
+}
+
+template <typename T>
+void ContractSum<T>::accumulate(
+  T alpha,
+  const DistTensor<T>& A, const IndexArray& indicesA,
+  const DistTensor<T>& intB, const IndexArray& indicesB,
+  const BlkContractStatCInfo& contractInfo
+) {
+  Unsigned i;
+  const Grid& g = C_.Grid();
+  IndexArray indicesT = ConcatenateVectors(indicesC_, DiffVector(indicesA, indicesC_));
+  ObjShape shapeT(indicesT.size());
+  SetTensorShapeToMatch(A.GetGridView().ParticipatingShape(), indicesA, shapeT, indicesT);
+  SetTensorShapeToMatch(C_.Shape(), indicesC_, shapeT, indicesT);
+
+  std::shared_ptr<DistTensor<T> > intT(new DistTensor<T>(shapeT, contractInfo.distT, g));
+  intT->AlignModesWith(contractInfo.alignModesT, A, contractInfo.alignModesTTo);
+
+  //Reuse an intermediate laid out the same way, otherwise start a new one
+  std::shared_ptr<DistTensor<T> > accum;
+  for(i = 0; i < accums_.size() && !accum; i++){
+    if(accums_[i]->TensorDist() == intT->TensorDist() &&
+       accums_[i]->Shape() == shapeT &&
+       accums_[i]->Alignments() == intT->Alignments())
+      accum = accums_[i];
+  }
+  if(!accum){
+    intT->SetLocalPermutation(contractInfo.permT);
+    intT->ResizeTo(shapeT);
+    Zero(*intT);
+    accums_.push_back(intT);
+    reduceModes_.push_back(contractInfo.reduceTensorModes);
+    accum = intT;
+  }
+
+  //NOTE: A shared intermediate keeps the local permutation of the term that
+  //created it, so later terms may contract into it with strides (GETT)
+  Contract<T>::run(
+    alpha,
+    A.LockedTensor(), A.LocalPermutation().applyTo(indicesA),
+    intB.LockedTensor(), intB.LocalPermutation().applyTo(indicesB),
+    T(1),
+    accum->Tensor(), accum->LocalPermutation().applyTo(indicesT),
+    false, true
+  );
+}
+
+template <typename T>
+void ContractSum<T>::Finish() {
+  if(finished_)
+    return;
+  finished_ = true;
+
+  if(accums_.size() == 0){
+    if(!scaled_)
+      Scal(beta_, C_);
+    return;
+  }
+  for(Unsigned i = 0; i < accums_.size(); i++)
+    C_.RedistFrom(*accums_[i], reduceModes_[i], T(1), i == 0 && !scaled_ ? beta_ : T(1));
+  accums_.clear();
+  reduceModes_.clear();
+}
+
+#define PROTO(T) \
+	template class ContractSum<T>;
+
+//PROTO(Unsigned)
+//PROTO(Int)
+PROTO(float)
+PROTO(double)
+//PROTO(char)
+
+#ifndef DISABLE_COMPLEX
+#ifndef DISABLE_FLOAT
+PROTO(std::complex<float>)
+#endif
+PROTO(std::complex<double>)
+#endif
+
+} // namespace rote
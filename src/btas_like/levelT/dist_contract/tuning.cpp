@@ -0,0 +1,136 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#include "rote.hpp"
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+// One line per signature: "<key> <variant> <blkSize>..."
+std::map<std::string, rote::ContractTuning> tuningDB;
+bool tuningFileLoaded = false;
+
+void LoadTuningFile(const rote::Grid& g){
+    using namespace rote;
+    ::tuningFileLoaded = true;
+    const std::string& filename = ContractTuningFile();
+    if(filename.empty())
+        return;
+
+    //Every process must see the same entries, so only one reads the file
+    const mpi::Comm comm = g.OwningComm();
+    std::string contents;
+    if(mpi::CommRank(comm) == 0){
+        std::ifstream file(filename.c_str());
+        std::stringstream buf;
+        buf << file.rdbuf();
+        contents = buf.str();
+    }
+    Unsigned size = contents.size();
+    mpi::Broadcast(size, 0, comm);
+    contents.resize(size);
+    if(size > 0)
+        mpi::Broadcast((byte*)(&(contents[0])), size, 0, comm);
+
+    std::istringstream lines(contents);
+    std::string line;
+    while(std::getline(lines, line)){
+        std::istringstream fields(line);
+        std::string key;
+        Unsigned variant;
+        if(!(fields >> key >> variant))
+            continue;
+        ContractTuning tuning;
+        tuning.variant = (ContractVariant)variant;
+        Unsigned blkSize;
+        while(fields >> blkSize)
+            tuning.blkSizes.push_back(blkSize);
+        ::tuningDB[key] = tuning;
+    }
+}
+
+} // anonymous namespace
+
+namespace rote{
+
+std::string ContractTuningKey(
+  const IndexArray& indicesA, const ObjShape& shapeA, const TensorDistribution& distA,
+  const IndexArray& indicesB, const ObjShape& shapeB, const TensorDistribution& distB,
+  const IndexArray& indicesC, const ObjShape& shapeC, const TensorDistribution& distC,
+  const Grid& g, const Unsigned elemSize
+) {
+    Unsigned i;
+    std::ostringstream key;
+    const IndexArray* indices[3] = {&indicesA, &indicesB, &indicesC};
+    const ObjShape* shapes[3] = {&shapeA, &shapeB, &shapeC};
+    const TensorDistribution* dists[3] = {&distA, &distB, &distC};
+    for(Unsigned t = 0; t < 3; t++){
+        key << std::string(indices[t]->begin(), indices[t]->end()) << ":";
+        for(i = 0; i < shapes[t]->size(); i++)
+            key << (i == 0 ? "" : ",") << (*shapes[t])[i];
+        const std::vector<ModeArray> entries = DistEntries(*dists[t]);
+        key << ":";
+        for(i = 0; i < entries.size(); i++){
+            key << "(";
+            for(Unsigned j = 0; j < entries[i].size(); j++)
+                key << (j == 0 ? "" : ",") << entries[i][j];
+            key << ")";
+        }
+        key << "|";
+    }
+    for(i = 0; i < g.Order(); i++)
+        key << (i == 0 ? "" : ",") << g.Dimension(i);
+    key << "|" << elemSize;
+    return key.str();
+}
+
+bool FindContractTuning(const std::string& key, const Grid& g, ContractTuning& tuning){
+    if(!::tuningFileLoaded)
+        LoadTuningFile(g);
+
+    std::map<std::string, ContractTuning>::const_iterator it = ::tuningDB.find(key);
+    if(it == ::tuningDB.end())
+        return false;
+    tuning = it->second;
+    return true;
+}
+
+void StoreContractTuning(const std::string& key, const Grid& g, const ContractTuning& tuning){
+    ::tuningDB[key] = tuning;
+
+    const std::string& filename = ContractTuningFile();
+    if(filename.empty() || mpi::CommRank(g.OwningComm()) != 0)
+        return;
+    std::ofstream file(filename.c_str(), std::ios::app);
+    file << key << " " << (Unsigned)tuning.variant;
+    for(Unsigned i = 0; i < tuning.blkSizes.size(); i++)
+        file << " " << tuning.blkSizes[i];
+    file << std::endl;
+}
+
+ContractVariant SelectContractVariant(const std::vector<ContractCost>& costs){
+    const double limit = ContractMemoryLimit();
+    Unsigned best = 0;
+    for(Unsigned i = 1; i < costs.size(); i++){
+        const bool fits = limit == 0 || costs[i].intermediateBytes <= limit;
+        const bool bestFits = limit == 0 || costs[best].intermediateBytes <= limit;
+        if(fits && (!bestFits || costs[i].predictedTime < costs[best].predictedTime))
+            best = i;
+        else if(!fits && !bestFits && costs[i].intermediateBytes < costs[best].intermediateBytes)
+            best = i;
+    }
+    return costs[best].variant;
+}
+
+void ClearContractTuning(){
+    ::tuningDB.clear();
+    ::tuningFileLoaded = false;
+}
+
+} // namespace rote
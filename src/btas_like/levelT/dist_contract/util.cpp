@@ -11,6 +11,65 @@
 
 namespace rote{
 
+template <typename T>
+Contract<T>::PipelineSlot::PipelineSlot(const BlkContractStatCInfo& contractInfo, const TensorDistribution& distC, const Grid& g)
+: intA(contractInfo.distIntA, g), intB(contractInfo.distIntB, g), outC(distC, g), beta(1), pending(false)
+{ }
+
+template <typename T>
+Contract<T>::Pipeline::Pipeline(const BlkContractStatCInfo& contractInfo, const TensorDistribution& distC, const Grid& g)
+: slot0(contractInfo, distC, g), slot1(contractInfo, distC, g), intT(contractInfo.distT, g), next(0)
+{ }
+
+// Pipeline helpers
+template <typename T>
+void Contract<T>::flushPipelineSlotAB(
+	BlkContractStatCInfo& contractInfo,
+	T alpha,
+	const IndexArray& indicesA, const IndexArray& indicesB,
+	      DistTensor<T>& C, const IndexArray& indicesC,
+	PipelineSlot& slot
+) {
+	slot.reqA.Wait();
+	slot.reqB.Wait();
+	Contract<T>::run(
+		alpha,
+		slot.intA.LockedTensor(), contractInfo.permA.applyTo(indicesA),
+		slot.intB.LockedTensor(), contractInfo.permB.applyTo(indicesB),
+		slot.beta,
+		C.Tensor(), C.LocalPermutation().applyTo(indicesC),
+		true, C.LocalPermutation() != contractInfo.permC
+	);
+	slot.pending = false;
+}
+
+template <typename T>
+void Contract<T>::flushPipelineSlotBC(
+	BlkContractStatCInfo& contractInfo,
+	T alpha,
+	const DistTensor<T>& A, const IndexArray& indicesA,
+	const IndexArray& indicesB,
+	T beta,
+	const IndexArray& indicesC,
+	Pipeline& pipeline, PipelineSlot& slot
+) {
+	IndexArray indicesT = ConcatenateVectors(indicesC, DiffVector(indicesA, indicesC));
+
+	slot.reqB.Wait();
+	pipeline.intT.ResizeTo(slot.shapeT);
+	Contract<T>::run(
+		alpha,
+		A.LockedTensor(), contractInfo.permA.applyTo(indicesA),
+		slot.intB.LockedTensor(), contractInfo.permB.applyTo(indicesB),
+		T(0),
+		pipeline.intT.Tensor(), contractInfo.permT.applyTo(indicesT),
+		false, false
+	);
+	//NOTE: intT is packed when the update is posted, so the next block may reuse it
+	slot.outC.RedistFromAsync(pipeline.intT, contractInfo.reduceTensorModes, slot.reqC, T(1), beta);
+	slot.pending = false;
+}
+
 // Partition helpers
 template <typename T>
 void Contract<T>::runHelperPartitionAB(
@@ -19,8 +78,23 @@ void Contract<T>::runHelperPartitionAB(
   const DistTensor<T>& A, const IndexArray& indicesA,
 	const DistTensor<T>& B, const IndexArray& indicesB,
 	T beta,
-        DistTensor<T>& C, const IndexArray& indicesC
+        DistTensor<T>& C, const IndexArray& indicesC,
+	Pipeline* pipeline
 ) {
+  if(depth == contractInfo.partModesA.size() && pipeline){
+		//Post this block, then contract the previous one while it is in flight
+		PipelineSlot& slot = pipeline->Slot(pipeline->next);
+		slot.intA.RedistFromAsync(A, slot.reqA);
+		slot.intB.RedistFromAsync(B, slot.reqB);
+		slot.beta = beta;
+		slot.pending = true;
+
+		pipeline->next = 1 - pipeline->next;
+		PipelineSlot& prev = pipeline->Slot(pipeline->next);
+		if(prev.pending)
+			Contract<T>::flushPipelineSlotAB(contractInfo, alpha, indicesA, indicesB, C, indicesC, prev);
+		return;
+	}
   if(depth == contractInfo.partModesA.size()){
 		DistTensor<T> intA(contractInfo.distIntA, A.Grid());
 		intA.SetLocalPermutation(contractInfo.permA);
@@ -32,13 +106,15 @@ void Contract<T>::runHelperPartitionAB(
 		intB.SetLocalPermutation(contractInfo.permB);
 		intB.RedistFrom(B);
 
+		//C is contracted into with its own strides when its local
+		//permutation is not the preferred one
 		Contract<T>::run(
 			alpha,
-			intA.LockedTensor(), indicesA,
-			intB.LockedTensor(), indicesB,
-			T(1),
-			C.Tensor(), indicesC,
-			true, false
+			intA.LockedTensor(), contractInfo.permA.applyTo(indicesA),
+			intB.LockedTensor(), contractInfo.permB.applyTo(indicesB),
+			beta,
+			C.Tensor(), C.LocalPermutation().applyTo(indicesC),
+			true, C.LocalPermutation() != contractInfo.permC
 		);
 		return;
 	}
@@ -74,7 +150,8 @@ void Contract<T>::runHelperPartitionAB(
 						B_B, B_2, partModeB, blkSize);
 
 		/*----------------------------------------------------------------*/
-		Contract<T>::runHelperPartitionAB(depth+1, contractInfo, alpha, A_1, indicesA, B_1, indicesB, beta, C, indicesC);
+		//Only the first block scales C by beta
+		Contract<T>::runHelperPartitionAB(depth+1, contractInfo, alpha, A_1, indicesA, B_1, indicesB, count == 0 ? beta : T(1), C, indicesC, pipeline);
 		count++;
 		/*----------------------------------------------------------------*/
 		SlideLockedPartitionDown(A_T, A_0,
@@ -86,6 +163,9 @@ void Contract<T>::runHelperPartitionAB(
 						   /**/ /**/
 						   B_B, B_2, partModeB);
 	}
+	//An empty partitioned mode leaves no block to apply beta
+	if(count == 0 && beta != T(1))
+		Scal(beta, C);
 }
 
 template <typename T>
@@ -95,15 +175,35 @@ void Contract<T>::runHelperPartitionBC(
   const DistTensor<T>& A, const IndexArray& indicesA,
 	const DistTensor<T>& B, const IndexArray& indicesB,
 	T beta,
-        DistTensor<T>& C, const IndexArray& indicesC
+        DistTensor<T>& C, const IndexArray& indicesC,
+	Pipeline* pipeline
 ) {
+  if(depth == contractInfo.partModesB.size() && pipeline){
+		//Post this block, then contract the previous one while it is in flight
+		PipelineSlot& slot = pipeline->Slot(pipeline->next);
+		slot.intB.RedistFromAsync(B, slot.reqB);
+
+		const rote::GridView gvA = A.GetGridView();
+		IndexArray indicesT = ConcatenateVectors(indicesC, DiffVector(indicesA, indicesC));
+		slot.shapeT.resize(indicesT.size());
+		SetTensorShapeToMatch(gvA.ParticipatingShape(), indicesA, slot.shapeT, indicesT);
+		SetTensorShapeToMatch(C.Shape(), indicesC, slot.shapeT, indicesT);
+		//NOTE: Only the target buffer is held by an in-flight update of this slot
+		View(slot.outC, C);
+		slot.pending = true;
+
+		pipeline->next = 1 - pipeline->next;
+		PipelineSlot& prev = pipeline->Slot(pipeline->next);
+		if(prev.pending)
+			Contract<T>::flushPipelineSlotBC(contractInfo, alpha, A, indicesA, indicesB, beta, indicesC, *pipeline, prev);
+		return;
+	}
   if(depth == contractInfo.partModesB.size()){
 		//Perform the distributed computation
 		DistTensor<T> intB(contractInfo.distIntB, B.Grid());
 
 		const rote::GridView gvA = A.GetGridView();
-		IndexArray contractIndices = DetermineContractIndices(indicesA, indicesB);
-		IndexArray indicesT = ConcatenateVectors(indicesC, contractIndices);
+		IndexArray indicesT = ConcatenateVectors(indicesC, DiffVector(indicesA, indicesC));
 		ObjShape shapeT(indicesT.size());
 		//NOTE: Overwrites values, but this is correct (initially sets to match gvA but then overwrites with C)
 		SetTensorShapeToMatch(gvA.ParticipatingShape(), indicesA, shapeT, indicesT);
@@ -121,10 +221,10 @@ void Contract<T>::runHelperPartitionBC(
 
 		Contract<T>::run(
 			alpha,
-			A.LockedTensor(), indicesA,
-			intB.LockedTensor(), indicesB,
+			A.LockedTensor(), contractInfo.permA.applyTo(indicesA),
+			intB.LockedTensor(), contractInfo.permB.applyTo(indicesB),
 			T(0),
-			intT.Tensor(), indicesT,
+			intT.Tensor(), contractInfo.permT.applyTo(indicesT),
 			false, false
 		);
 		C.RedistFrom(intT, contractInfo.reduceTensorModes, T(1), beta);
@@ -162,7 +262,7 @@ void Contract<T>::runHelperPartitionBC(
 
 
 		/*----------------------------------------------------------------*/
-		Contract<T>::runHelperPartitionBC(depth+1, contractInfo, alpha, A, indicesA, B_1, indicesB, beta, C_1, indicesC);
+		Contract<T>::runHelperPartitionBC(depth+1, contractInfo, alpha, A, indicesA, B_1, indicesB, beta, C_1, indicesC, pipeline);
 		/*----------------------------------------------------------------*/
 		SlideLockedPartitionDown(B_T, B_0,
 				                B_1,
@@ -189,6 +289,7 @@ void Contract<T>::setContractInfo(
 	IndexArray indicesAC = DiffVector(indicesC, indicesB);
 	IndexArray indicesBC = DiffVector(indicesC, indicesA);
 	IndexArray indicesAB = DiffVector(indicesA, indicesC);
+	IndexArray indicesL = IsectVector(IsectVector(indicesC, indicesA), indicesB);
 	IndexArray indicesT = ConcatenateVectors(indicesC, indicesAB);
 
 	TensorDistribution distA = A.TensorDist();
@@ -245,31 +346,36 @@ void Contract<T>::setContractInfo(
 	}
 
 	//Determine the final alignments needed
+	//NOTE: Batch indices stay where the stationary tensor has them
 	if (isStatC) {
-		contractInfo.alignModesA.resize(indicesAC.size());
-		contractInfo.alignModesATo.resize(indicesAC.size());
-		for(i = 0; i < indicesAC.size(); i++){
-			contractInfo.alignModesA[i] = IndexOf(indicesA, indicesAC[i]);
-			contractInfo.alignModesATo[i] = IndexOf(indicesC, indicesAC[i]);
+		IndexArray alignIndicesA = ConcatenateVectors(indicesAC, indicesL);
+		contractInfo.alignModesA.resize(alignIndicesA.size());
+		contractInfo.alignModesATo.resize(alignIndicesA.size());
+		for(i = 0; i < alignIndicesA.size(); i++){
+			contractInfo.alignModesA[i] = IndexOf(indicesA, alignIndicesA[i]);
+			contractInfo.alignModesATo[i] = IndexOf(indicesC, alignIndicesA[i]);
 		}
-		contractInfo.alignModesB.resize(indicesBC.size());
-		contractInfo.alignModesBTo.resize(indicesBC.size());
-		for(i = 0; i < indicesBC.size(); i++){
-			contractInfo.alignModesB[i] = IndexOf(indicesB, indicesBC[i]);
-			contractInfo.alignModesBTo[i] = IndexOf(indicesC, indicesBC[i]);
+		IndexArray alignIndicesB = ConcatenateVectors(indicesBC, indicesL);
+		contractInfo.alignModesB.resize(alignIndicesB.size());
+		contractInfo.alignModesBTo.resize(alignIndicesB.size());
+		for(i = 0; i < alignIndicesB.size(); i++){
+			contractInfo.alignModesB[i] = IndexOf(indicesB, alignIndicesB[i]);
+			contractInfo.alignModesBTo[i] = IndexOf(indicesC, alignIndicesB[i]);
 		}
 	} else {
-		contractInfo.alignModesB.resize(indicesAB.size());
-		contractInfo.alignModesBTo.resize(indicesAB.size());
-		for(i = 0; i < indicesAB.size(); i++){
-			contractInfo.alignModesB[i] = IndexOf(indicesB, indicesAB[i]);
-			contractInfo.alignModesBTo[i] = IndexOf(indicesA, indicesAB[i]);
+		IndexArray alignIndicesB = ConcatenateVectors(indicesAB, indicesL);
+		contractInfo.alignModesB.resize(alignIndicesB.size());
+		contractInfo.alignModesBTo.resize(alignIndicesB.size());
+		for(i = 0; i < alignIndicesB.size(); i++){
+			contractInfo.alignModesB[i] = IndexOf(indicesB, alignIndicesB[i]);
+			contractInfo.alignModesBTo[i] = IndexOf(indicesA, alignIndicesB[i]);
 		}
-		contractInfo.alignModesT.resize(indicesAC.size());
-		contractInfo.alignModesTTo.resize(indicesAC.size());
-		for(i = 0; i < indicesAC.size(); i++){
-			contractInfo.alignModesT[i] = IndexOf(indicesT, indicesAC[i]);
-			contractInfo.alignModesTTo[i] = IndexOf(indicesA, indicesAC[i]);
+		IndexArray alignIndicesT = ConcatenateVectors(indicesAC, indicesL);
+		contractInfo.alignModesT.resize(alignIndicesT.size());
+		contractInfo.alignModesTTo.resize(alignIndicesT.size());
+		for(i = 0; i < alignIndicesT.size(); i++){
+			contractInfo.alignModesT[i] = IndexOf(indicesT, alignIndicesT[i]);
+			contractInfo.alignModesTTo[i] = IndexOf(indicesA, alignIndicesT[i]);
 		}
 	}
 
@@ -284,14 +390,12 @@ void Contract<T>::setContractInfo(
 	}
 
 	//Set the local permutation info
-	std::cout << "permA\n";
-	PrintVector(indicesA, "indicesA");
-	PrintVector(indicesAC, "indicesAC");
-	PrintVector(indicesAB, "indicesAB");
-	Permutation permA(indicesA, ConcatenateVectors(indicesAC, indicesAB));
-	Permutation permB(indicesB, ConcatenateVectors(indicesAB, indicesBC));
-	Permutation permC(indicesC, ConcatenateVectors(indicesAC, indicesBC));
-	Permutation permT(indicesT, ConcatenateVectors(ConcatenateVectors(indicesAC, indicesBC), indicesAB));
+	//NOTE: Batch indices sit between the M and K (A) or before the K (B)
+	//modes, so a locally unit batch mode reads as part of K
+	Permutation permA(indicesA, ConcatenateVectors(ConcatenateVectors(indicesAC, indicesL), indicesAB));
+	Permutation permB(indicesB, ConcatenateVectors(ConcatenateVectors(indicesL, indicesAB), indicesBC));
+	Permutation permC(indicesC, ConcatenateVectors(ConcatenateVectors(indicesAC, indicesBC), indicesL));
+	Permutation permT(indicesT, ConcatenateVectors(ConcatenateVectors(ConcatenateVectors(indicesAC, indicesBC), indicesL), indicesAB));
 
 	contractInfo.permA = permA;
 	contractInfo.permB = permB;
@@ -299,6 +403,43 @@ void Contract<T>::setContractInfo(
 	contractInfo.permT = permT;
 }
 
+template<typename T>
+void Contract<T>::setContract25DInfo(
+	const DistTensor<T>& A, const IndexArray& indicesA,
+	const DistTensor<T>& B, const IndexArray& indicesB,
+	const DistTensor<T>& C, const IndexArray& indicesC,
+	const std::vector<Unsigned>& blkSizes,
+	      BlkContractStatCInfo& contractInfo
+) {
+	Unsigned i;
+	const ModeDistribution replicaModes(C.GetGridView().FreeModes());
+	IndexArray indicesAC = DiffVector(indicesC, indicesB);
+	IndexArray indicesBC = DiffVector(indicesC, indicesA);
+	IndexArray indicesAB = DiffVector(indicesA, indicesC);
+	IndexArray indicesL = IsectVector(IsectVector(indicesC, indicesA), indicesB);
+	IndexArray indicesT = ConcatenateVectors(indicesC, indicesAB);
+	if(replicaModes.size() == 0 || indicesAB.size() == 0)
+		LogicError("2.5D contraction needs C replicated over some grid mode and a contracted index");
+
+	Contract<T>::setContractInfo(A, indicesA, B, indicesB, C, indicesC, blkSizes, true, contractInfo);
+
+	//Split the longest contracted index over the replicas
+	Unsigned splitPos = 0;
+	for(i = 1; i < indicesAB.size(); i++)
+		if(A.Dimension(IndexOf(indicesA, indicesAB[i])) > A.Dimension(IndexOf(indicesA, indicesAB[splitPos])))
+			splitPos = i;
+	contractInfo.distIntA[IndexOf(indicesA, indicesAB[splitPos])] = replicaModes;
+	contractInfo.distIntB[IndexOf(indicesB, indicesAB[splitPos])] = replicaModes;
+
+	//T holds one (locally unit) copy of C per replica along the split index.
+	//The intermediates align with T, whose leading modes are those of C
+	TensorDistribution distT(indicesT.size());
+	distT.SetToMatch(C.TensorDist(), indicesC, indicesT);
+	distT[indicesC.size() + splitPos] = replicaModes;
+	contractInfo.distT = distT;
+	contractInfo.permC = Permutation(indicesT, ConcatenateVectors(ConcatenateVectors(ConcatenateVectors(indicesAC, indicesBC), indicesL), indicesAB));
+}
+
 #define PROTO(T) \
 	template class Contract<T>;
 
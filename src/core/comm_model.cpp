@@ -0,0 +1,275 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+
+#include "rote.hpp"
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+typedef std::pair<std::pair<rote::ObjShape, rote::ModeArray>, rote::Unsigned> CommFitKey;
+
+std::map<CommFitKey, rote::CommFit> commFits;
+
+// Collectives timed by the calibration, and the redistribution each models
+const rote::RedistType calibratedTypes[] = {rote::A2A, rote::AG, rote::RS, rote::Perm, rote::AR};
+const char* calibratedNames[] = {"A2A", "AG", "RS", "Perm", "AR"};
+const rote::Unsigned numCalibratedTypes = 5;
+
+// Elements each process contributes, and repetitions per timing
+const rote::Unsigned calibrationCounts[] = {1, 16, 256, 4096, 65536, 262144};
+const rote::Unsigned numCalibrationCounts = 6;
+const rote::Unsigned calibrationReps = 5;
+
+// Bytes each of the send and receive buffers may take; larger grids time
+// fewer of the calibrationCounts
+const std::size_t calibrationBufferBytes = 1 << 26;
+
+CommFitKey MakeKey(const rote::ObjShape& gridShape, const rote::ModeArray& commModes, const rote::RedistType type){
+    rote::ModeArray sortedModes = commModes;
+    rote::SortVector(sortedModes);
+    return CommFitKey(std::make_pair(gridShape, sortedModes), type);
+}
+
+// Least-squares fit of times = alpha + beta*bytes, with bytes ascending.
+// Noise at large sizes can push the intercept below zero; the latency is then
+// taken as the time of the smallest message instead
+rote::CommFit FitCosts(const std::vector<double>& bytes, const std::vector<double>& times){
+    const double n = bytes.size();
+    double meanB = 0, meanT = 0;
+    for(rote::Unsigned i = 0; i < bytes.size(); i++){
+        meanB += bytes[i] / n;
+        meanT += times[i] / n;
+    }
+    double covBT = 0, varB = 0;
+    for(rote::Unsigned i = 0; i < bytes.size(); i++){
+        covBT += (bytes[i] - meanB) * (times[i] - meanT);
+        varB += (bytes[i] - meanB) * (bytes[i] - meanB);
+    }
+
+    rote::CommFit fit;
+    fit.beta = varB > 0 ? std::max(0.0, covBT / varB) : 0;
+    fit.alpha = meanT - fit.beta * meanB;
+    if(fit.alpha <= 0)
+        fit.alpha = times[0];
+    return fit;
+}
+
+// Average seconds for one call of the collective of calibratedTypes[op]
+double TimeCollective(const rote::Unsigned op, double* sendBuf, double* recvBuf, const rote::Unsigned count, rote::mpi::Comm comm){
+    using namespace rote;
+    const int p = mpi::CommSize(comm);
+    const int rank = mpi::CommRank(comm);
+
+    mpi::Barrier(comm);
+    const double start = mpi::Time();
+    for(Unsigned rep = 0; rep < calibrationReps; rep++){
+        switch(calibratedTypes[op]){
+            case A2A: mpi::AllToAll(sendBuf, count, recvBuf, count, comm); break;
+            case AG: mpi::AllGather(sendBuf, count, recvBuf, count, comm); break;
+            case RS: mpi::ReduceScatter(sendBuf, recvBuf, count, comm); break;
+            case Perm: mpi::SendRecv(sendBuf, count, (rank + 1) % p, recvBuf, count, (rank + p - 1) % p, comm); break;
+            case AR: mpi::AllReduce(sendBuf, recvBuf, count, comm); break;
+            default: LogicError("Uncalibrated collective");
+        }
+    }
+    return (mpi::Time() - start) / calibrationReps;
+}
+
+} // anonymous namespace
+
+namespace rote {
+
+bool LoadCommModelFromEnv(){
+    const char* name = std::getenv("ROTE_COMM_MODEL");
+    return name ? LoadCommModel(std::string(name)) : false;
+}
+
+std::string CommModelFilename(){
+    const char* name = std::getenv("ROTE_COMM_MODEL");
+    return name ? std::string(name) : std::string("rote_comm_model.txt");
+}
+
+bool FindCommFit(const ObjShape& gridShape, const ModeArray& commModes, const RedistType type, CommFit& fit){
+    std::map<CommFitKey, CommFit>::const_iterator it = ::commFits.find(::MakeKey(gridShape, commModes, type));
+    if(it == ::commFits.end())
+        return false;
+    fit = it->second;
+    return true;
+}
+
+void CalibrateCommModel(const Grid& g){
+    CalibrateCommModel(g, CommModelFilename());
+}
+
+void CalibrateCommModel(const Grid& g, const std::string& filename, const Unsigned maxCount){
+    PROFILE_SECTION("CalibrateCommModel");
+    const ObjShape gridShape = g.Shape();
+    const Unsigned gridOrder = gridShape.size();
+
+    // Communicators come from a tensor distributed over the whole grid so the
+    // calibrated ones are the ones redistributions split off
+    std::vector<ModeDistribution> probeEntries(2);
+    probeEntries[0] = ModeDistribution(OrderedModes(gridOrder));
+    DistTensor<double> probe(TensorDistribution(probeEntries), g);
+
+    const Unsigned nProcs = prod(gridShape);
+    std::size_t maxBufCount = std::min<std::size_t>(::calibrationCounts[::numCalibrationCounts - 1], ::calibrationBufferBytes / (sizeof(double) * nProcs));
+    if(maxCount > 0)
+        maxBufCount = std::min<std::size_t>(maxBufCount, maxCount);
+    Unsigned numCounts = 0;
+    while(numCounts < ::numCalibrationCounts && ::calibrationCounts[numCounts] <= maxBufCount)
+        numCounts++;
+    //A bandwidth needs two sizes
+    numCounts = std::max<Unsigned>(numCounts, 2);
+    const Unsigned bufCount = ::calibrationCounts[numCounts - 1];
+    std::vector<double> sendBuf(bufCount * nProcs, 1.0);
+    std::vector<double> recvBuf(bufCount * nProcs);
+
+    for(Unsigned mask = 1; mask < (1u << gridOrder); mask++){
+        ModeArray commModes;
+        Unsigned p = 1;
+        for(Unsigned i = 0; i < gridOrder; i++){
+            if(mask & (1u << i)){
+                commModes.push_back(i);
+                p *= gridShape[i];
+            }
+        }
+        if(p < 2)
+            continue;
+
+        mpi::Comm comm = probe.GetCommunicatorForModes(commModes, g);
+        for(Unsigned op = 0; op < ::numCalibratedTypes; op++){
+            // Warm up, then keep the slowest process of every communicator
+            // so all processes fit the same costs
+            ::TimeCollective(op, &(sendBuf[0]), &(recvBuf[0]), 1, comm);
+
+            std::vector<double> bytes(numCounts);
+            std::vector<double> times(numCounts);
+            for(Unsigned i = 0; i < numCounts; i++){
+                const Unsigned count = ::calibrationCounts[i];
+                const RedistType type = ::calibratedTypes[op];
+                const bool sendsAll = type == A2A || type == RS;
+                bytes[i] = sizeof(double) * count * (sendsAll ? p : 1);
+                times[i] = ::TimeCollective(op, &(sendBuf[0]), &(recvBuf[0]), count, comm);
+            }
+            mpi::AllReduce(&(times[0]), times.size(), mpi::MAX, g.OwningComm());
+            ::commFits[::MakeKey(gridShape, commModes, ::calibratedTypes[op])] = ::FitCosts(bytes, times);
+        }
+    }
+
+    // The default model takes point-to-point costs over the whole grid and a
+    // local copy rate
+    CommCostModel model = GetCommCostModel();
+    CommFit fit;
+    if(FindCommFit(gridShape, OrderedModes(gridOrder), Perm, fit)){
+        model.alpha = fit.alpha;
+        model.beta = fit.beta;
+    }
+    const double start = mpi::Time();
+    for(Unsigned rep = 0; rep < ::calibrationReps; rep++)
+        MemCopy(&(recvBuf[0]), &(sendBuf[0]), sendBuf.size());
+    double copyTime = (mpi::Time() - start) / ::calibrationReps;
+    copyTime = mpi::AllReduce(copyTime, mpi::MAX, g.OwningComm());
+    model.gamma = copyTime / (sizeof(double) * sendBuf.size());
+    SetCommCostModel(model);
+
+    SaveCommModel(filename);
+    PROFILE_STOP;
+}
+
+void SaveCommModel(const std::string& filename){
+    if(mpi::CommRank(mpi::COMM_WORLD) != 0)
+        return;
+
+    std::ofstream out(filename.c_str());
+    if(!out.is_open())
+        LogicError("Could not open communication model file for writing");
+
+    const CommCostModel& model = GetCommCostModel();
+    out.precision(10);
+    out << "# ROTE communication model: default <alpha> <beta> <gamma>\n";
+    out << "# fit <collective> <grid order> <grid shape> <num modes> <modes> <alpha> <beta>\n";
+    out << "default " << model.alpha << " " << model.beta << " " << model.gamma << "\n";
+
+    std::map<CommFitKey, CommFit>::const_iterator it;
+    for(it = ::commFits.begin(); it != ::commFits.end(); it++){
+        const ObjShape& gridShape = it->first.first.first;
+        const ModeArray& commModes = it->first.first.second;
+        Unsigned op = 0;
+        while(op < ::numCalibratedTypes && ::calibratedTypes[op] != RedistType(it->first.second))
+            op++;
+
+        out << "fit " << ::calibratedNames[op] << " " << gridShape.size();
+        for(Unsigned i = 0; i < gridShape.size(); i++)
+            out << " " << gridShape[i];
+        out << " " << commModes.size();
+        for(Unsigned i = 0; i < commModes.size(); i++)
+            out << " " << commModes[i];
+        out << " " << it->second.alpha << " " << it->second.beta << "\n";
+    }
+}
+
+bool LoadCommModel(const std::string& filename){
+    std::string contents;
+    int length = -1;
+    if(mpi::CommRank(mpi::COMM_WORLD) == 0){
+        std::ifstream in(filename.c_str());
+        if(in.is_open()){
+            std::stringstream buf;
+            buf << in.rdbuf();
+            contents = buf.str();
+            length = contents.size();
+        }
+    }
+    mpi::Broadcast(&length, 1, 0, mpi::COMM_WORLD);
+    if(length < 0)
+        return false;
+
+    std::vector<byte> chars(length + 1, 0);
+    if(mpi::CommRank(mpi::COMM_WORLD) == 0)
+        std::copy(contents.begin(), contents.end(), chars.begin());
+    mpi::Broadcast(&(chars[0]), length, 0, mpi::COMM_WORLD);
+    contents.assign(chars.begin(), chars.begin() + length);
+
+    std::istringstream in(contents);
+    std::string line;
+    CommCostModel model = GetCommCostModel();
+    while(std::getline(in, line)){
+        std::istringstream fields(line);
+        std::string tag;
+        if(!(fields >> tag) || tag[0] == '#')
+            continue;
+
+        if(tag == "default"){
+            fields >> model.alpha >> model.beta >> model.gamma;
+        }else if(tag == "fit"){
+            std::string name;
+            Unsigned order, nModes;
+            fields >> name >> order;
+            ObjShape gridShape(order);
+            for(Unsigned i = 0; i < order; i++)
+                fields >> gridShape[i];
+            fields >> nModes;
+            ModeArray commModes(nModes);
+            for(Unsigned i = 0; i < nModes; i++)
+                fields >> commModes[i];
+            CommFit fit;
+            fields >> fit.alpha >> fit.beta;
+
+            for(Unsigned op = 0; op < ::numCalibratedTypes; op++)
+                if(name == ::calibratedNames[op])
+                    ::commFits[::MakeKey(gridShape, commModes, ::calibratedTypes[op])] = fit;
+        }
+    }
+    SetCommCostModel(model);
+    return true;
+}
+
+} // namespace rote
@@ -113,6 +113,11 @@ bool
 DistTensorBase<T>::Locked() const
 { return IsLocked( viewType_ ); }
 
+template<typename T>
+std::size_t
+DistTensorBase<T>::Version() const
+{ return *version_; }
+
 ///////////////////////////////
 // GridView pass-through
 ///////////////////////////////
@@ -212,12 +217,18 @@ DistTensorBase<T>::GetLocal( const Location& loc ) const
 template<typename T>
 T*
 DistTensorBase<T>::Buffer( const Location& loc )
-{ return tensor_.Buffer(loc); }
+{
+    BumpVersion();
+    return tensor_.Buffer(loc);
+}
 
 template<typename T>
 T*
 DistTensorBase<T>::Buffer()
-{ return tensor_.Buffer(); }
+{
+    BumpVersion();
+    return tensor_.Buffer();
+}
 
 template<typename T>
 const T*
@@ -232,7 +243,10 @@ DistTensorBase<T>::LockedBuffer( ) const
 template<typename T>
 rote::Tensor<T>&
 DistTensorBase<T>::Tensor()
-{ return tensor_; }
+{
+    BumpVersion();
+    return tensor_;
+}
 
 template<typename T>
 const rote::Tensor<T>&
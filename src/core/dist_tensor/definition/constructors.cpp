@@ -28,7 +28,9 @@ DistTensorBase<T>::DistTensorBase( const rote::Grid& grid )
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 { SetShifts(); SetParticipatingComm(); SetDefaultPermutation();}
 
 template<typename T>
@@ -49,7 +51,9 @@ DistTensorBase<T>::DistTensorBase( const Unsigned order, const rote::Grid& grid
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 { SetShifts(); SetParticipatingComm(); SetDefaultPermutation();}
 
 template<typename T>
@@ -70,7 +74,9 @@ DistTensorBase<T>::DistTensorBase( const TensorDistribution& dist, const rote::G
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 { SetShifts(); SetParticipatingComm(); SetDefaultPermutation();}
 
 template<typename T>
@@ -92,7 +98,9 @@ DistTensorBase<T>::DistTensorBase
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 {
     if(shape_.size() + 1 != dist_.size())
         LogicError("Error: Distribution must be of same order as object");
@@ -123,7 +131,9 @@ DistTensorBase<T>::DistTensorBase
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 {
     if(shape_.size() + 1 != dist_.size())
         LogicError("Error: Distribution must be of same order as object");
@@ -154,7 +164,9 @@ DistTensorBase<T>::DistTensorBase
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 {
     if(shape_.size() + 1 != dist_.size())
         LogicError("Error: Distribution must be of same order as object");
@@ -184,7 +196,9 @@ DistTensorBase<T>::DistTensorBase
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 {
     if(shape_.size() + 1 != dist_.size())
         LogicError("Error: Distribution must be of same order as object");
@@ -215,7 +229,9 @@ DistTensorBase<T>::DistTensorBase
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 {
     if(shape_.size() + 1 != dist_.size())
         LogicError("Error: Distribution must be of same order as object");
@@ -248,7 +264,9 @@ DistTensorBase<T>::DistTensorBase( const std::string& dist, const rote::Grid& gr
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 { SetShifts(); SetParticipatingComm(); SetDefaultPermutation();}
 
 template<typename T>
@@ -270,7 +288,9 @@ DistTensorBase<T>::DistTensorBase
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 {
     if(shape_.size() + 1 != dist_.size())
         LogicError("Error: Distribution must be of same order as object");
@@ -301,7 +321,9 @@ DistTensorBase<T>::DistTensorBase
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 {
     if(shape_.size() + 1 != dist_.size())
         LogicError("Error: Distribution must be of same order as object");
@@ -331,7 +353,9 @@ DistTensorBase<T>::DistTensorBase
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 {
     if(shape_.size() + 1 != dist_.size())
         LogicError("Error: Distribution must be of same order as object");
@@ -361,7 +385,9 @@ DistTensorBase<T>::DistTensorBase
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 {
     if(shape_.size() + 1 != dist_.size())
         LogicError("Error: Distribution must be of same order as object");
@@ -392,7 +418,9 @@ DistTensorBase<T>::DistTensorBase
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 {
     if(shape_.size() + 1 != dist_.size())
         LogicError("Error: Distribution must be of same order as object");
@@ -405,15 +433,41 @@ DistTensorBase<T>::DistTensorBase
 
 template<typename T>
 DistTensorBase<T>::DistTensorBase( const DistTensorBase<T>& A )
-: dist_(),
+: dist_(A.dist_),
+  shape_(A.shape_),
+
+  constrainedModeAlignments_(A.constrainedModeAlignments_),
+  modeAlignments_(A.modeAlignments_),
+  modeShifts_(A.modeShifts_),
+
+  tensor_(),
+  localPerm_(A.localPerm_),
+
+  grid_(A.grid_),
+  commMap_(A.commMap_),
+  gridView_(A.gridView_),
+  participatingComm_(A.participatingComm_),
+
+  viewType_(OWNER),
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
+{
+    //Same layout as A, so the local data is copied as is
+    tensor_ = A.LockedTensor();
+}
+
+template<typename T>
+DistTensorBase<T>::DistTensorBase( DistTensorBase<T>&& A )
+: dist_(A.TensorDist()),
   shape_(),
 
   constrainedModeAlignments_(),
   modeAlignments_(),
   modeShifts_(),
 
-  tensor_(true),
-  localPerm_(shape_.size()),
+  tensor_(),
+  localPerm_(),
 
   grid_(&(A.Grid())),
   commMap_(&(DefaultCommMap())),
@@ -421,15 +475,11 @@ DistTensorBase<T>::DistTensorBase( const DistTensorBase<T>& A )
   participatingComm_(),
 
   viewType_(OWNER),
-  auxMemory_()
+  auxMemory_(),
+  version_(new std::size_t(NewTensorVersion())),
+  attached_(false)
 {
-    SetShifts();
-    if( &A != this )
-        *this = A;
-    else
-        LogicError("Tried to construct [MC,MR] with itself");
-    SetDefaultPermutation();
-    SetParticipatingComm();
+    Swap( A );
 }
 
 template<typename T>
@@ -451,10 +501,17 @@ DistTensorBase<T>::Swap( DistTensorBase<T>& A )
     std::swap( localPerm_, A.localPerm_ );
 
     std::swap( grid_, A.grid_ );
+    std::swap( commMap_, A.commMap_ );
     std::swap( gridView_, A.gridView_ );
+    std::swap( participatingComm_, A.participatingComm_ );
 
     std::swap( viewType_, A.viewType_ );
     auxMemory_.Swap( A.auxMemory_ );
+
+    std::swap( version_, A.version_ );
+    std::swap( attached_, A.attached_ );
+    BumpVersion();
+    A.BumpVersion();
 }
 
 //
@@ -496,10 +553,28 @@ DistTensorBase<T>::operator=( const DistTensorBase<T>& A )
             grid_ = A.grid_;
             SetShifts();
         }
+        BumpVersion();
     }
     return *this;
 }
 
+template<typename T>
+const DistTensorBase<T>&
+DistTensorBase<T>::operator=( DistTensorBase<T>&& A )
+{
+#ifndef RELEASE
+    AssertNotLocked();
+#endif
+    if( &A == this )
+        return *this;
+    if( Grid() != A.Grid() || viewType_ != OWNER || A.viewType_ != OWNER )
+        return *this = static_cast<const DistTensorBase<T>&>(A);
+
+    Swap( A );
+    A.Empty();
+    return *this;
+}
+
 #define FULL(T) \
     template class DistTensorBase<T>;
 
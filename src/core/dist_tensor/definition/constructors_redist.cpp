@@ -102,6 +102,32 @@ DistTensor<T>::DistTensor
 : DistTensorBase<T>(shape, dist, modeAlignments, buffer, strides, g)
 { }
 
+template<typename T>
+DistTensor<T>::DistTensor( const DistTensor<T>& A )
+: DistTensorBase<T>(A)
+{ }
+
+template<typename T>
+DistTensor<T>::DistTensor( DistTensor<T>&& A )
+: DistTensorBase<T>(std::move(A))
+{ }
+
+template<typename T>
+const DistTensor<T>&
+DistTensor<T>::operator=( const DistTensor<T>& A )
+{
+    DistTensorBase<T>::operator=(A);
+    return *this;
+}
+
+template<typename T>
+const DistTensor<T>&
+DistTensor<T>::operator=( DistTensor<T>&& A )
+{
+    DistTensorBase<T>::operator=(std::move(A));
+    return *this;
+}
+
 template<typename T>
 DistTensor<T>::~DistTensor()
 { }
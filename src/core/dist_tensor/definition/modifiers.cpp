@@ -61,6 +61,7 @@ void
 DistTensorBase<T>::SetDistribution( const TensorDistribution& tenDist)
 {
     dist_ = tenDist;
+    BumpVersion();
 }
 
 template<typename T>
@@ -91,6 +92,7 @@ DistTensorBase<T>::AlignModesWith(const ModeArray& modes, const DistTensorBase<T
         constrainedModeAlignments_[mode] = true;
         SetModeShift(mode);
     }
+    BumpVersion();
 }
 
 template<typename T>
@@ -105,6 +107,7 @@ DistTensorBase<T>::Attach
     shape_ = shape;
     modeAlignments_ = modeAlignments;
     viewType_ = VIEW;
+    attached_ = true;
     SetShifts();
     if( Participating() )
     {
@@ -119,6 +122,8 @@ DistTensorBase<T>::LockedAttach
 ( const ObjShape& shape, const std::vector<Unsigned>& modeAlignments,
   const T* buffer, const std::vector<Unsigned>& strides, const rote::Grid& g )
 {
+    DetachVersion();
+    attached_ = true;
     grid_ = &g;
     shape_ = shape;
     modeAlignments_ = modeAlignments;
@@ -135,6 +140,8 @@ DistTensorBase<T>::LockedAttach
 ( const ObjShape& shape, const std::vector<Unsigned>& modeAlignments,
   const T* buffer, const Permutation& perm, const std::vector<Unsigned>& strides, const rote::Grid& g )
 {
+    DetachVersion();
+    attached_ = true;
     grid_ = &g;
     shape_ = shape;
     modeAlignments_ = modeAlignments;
@@ -164,6 +171,7 @@ DistTensorBase<T>::ResizeTo( const ObjShape& shape )
 #ifndef RELEASE
     AssertNotLocked();
 #endif
+    BumpVersion();
     if(AnyElemwiseNotEqual(shape_, shape)){
         shape_ = shape;
         SetShifts();
@@ -181,6 +189,7 @@ DistTensorBase<T>::ResizeTo( const ObjShape& shape, const std::vector<Unsigned>&
 #ifndef RELEASE
     AssertNotLocked();
 #endif
+    BumpVersion();
     shape_ = shape;
     if(Participating()){
         tensor_.ResizeTo(Lengths(shape, ModeShifts(), ModeStrides()), strides);
@@ -345,26 +354,38 @@ template<typename T>
 void
 DistTensorBase<T>::SetLocalRealPart
 ( const Location& loc, BASE(T) alpha )
-{ tensor_.SetRealPart(loc,alpha); }
+{
+    BumpVersion();
+    tensor_.SetRealPart(loc,alpha);
+}
 
 
 template<typename T>
 void
 DistTensorBase<T>::SetLocalImagPart
 ( const Location& loc, BASE(T) alpha )
-{ tensor_.SetImagPart(loc,alpha); }
+{
+    BumpVersion();
+    tensor_.SetImagPart(loc,alpha);
+}
 
 template<typename T>
 void
 DistTensorBase<T>::UpdateLocalRealPart
 ( const Location& loc, BASE(T) alpha )
-{ tensor_.UpdateRealPart(loc,alpha); }
+{
+    BumpVersion();
+    tensor_.UpdateRealPart(loc,alpha);
+}
 
 template<typename T>
 void
 DistTensorBase<T>::UpdateLocalImagPart
 ( const Location& loc, BASE(T) alpha )
-{ tensor_.UpdateImagPart(loc,alpha); }
+{
+    BumpVersion();
+    tensor_.UpdateImagPart(loc,alpha);
+}
 
 //TODO: Figure out participating logic
 template<typename T>
@@ -421,6 +442,8 @@ DistTensorBase<T>::Empty()
     tensor_.Empty();
 
     viewType_ = OWNER;
+    attached_ = false;
+    DetachVersion();
 }
 
 //TODO: Figure out if this is fully correct
@@ -432,17 +455,25 @@ DistTensorBase<T>::EmptyData()
 
     tensor_.Empty();
     viewType_ = OWNER;
+    attached_ = false;
+    DetachVersion();
 }
 
 template<typename T>
 void
 DistTensorBase<T>::SetLocal( const Location& loc, T alpha )
-{ tensor_.Set(loc, alpha); }
+{
+    BumpVersion();
+    tensor_.Set(loc, alpha);
+}
 
 template<typename T>
 void
 DistTensorBase<T>::UpdateLocal( const Location& loc, T alpha )
-{ tensor_.Update(loc,alpha); }
+{
+    BumpVersion();
+    tensor_.Update(loc,alpha);
+}
 
 template<typename T>
 void
@@ -451,8 +482,20 @@ DistTensorBase<T>::SetLocalPermutation(const Permutation& perm)
     Permutation permOldToNew = localPerm_.PermutationTo(perm);
     tensor_.ResizeTo(permOldToNew.applyTo(tensor_.Shape()));
     localPerm_ = perm;
+    BumpVersion();
 }
 
+template<typename T>
+void
+DistTensorBase<T>::BumpVersion()
+{ *version_ = NewTensorVersion(); }
+
+//Views share the version of the tensor they view; this stops sharing it
+template<typename T>
+void
+DistTensorBase<T>::DetachVersion()
+{ version_.reset(new std::size_t(NewTensorVersion())); }
+
 template<typename T>
 void
 DistTensorBase<T>::SetDefaultPermutation()
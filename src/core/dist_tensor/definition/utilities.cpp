@@ -107,6 +107,7 @@ template<typename T>
 void
 DistTensorBase<T>::CopyLocalBuffer(const DistTensorBase<T>& A)
 {
+    BumpVersion();
     tensor_.CopyBuffer(A.LockedTensor(), A.localPerm_, localPerm_);
 }
 
@@ -213,6 +214,60 @@ DistTensor<T>::AlignCommBufRedist(const DistTensor<T>& A, const T* unalignedSend
     return true;
 }
 
+//Exact per-peer counts are only used by blocking redistributions that need
+//no realignment, and not on node-aware grids, whose collectives aggregate
+//uniform padded blocks.  The padding is judged from global quantities so every
+//process of the communicator makes the same choice.
+template<typename T>
+bool
+DistTensor<T>::UseExactCommCounts(const DistTensor<T>& A, const double paddedElems, const double exactElems, const RedistRequest<T>* request) const
+{
+    if(request || A.Grid().NodeAwareCollectives() || !CommBufsAligned(A))
+        return false;
+
+    return PreferExactCommCounts(paddedElems, exactElems);
+}
+
+//Large blocking redistributions that overwrite our data (alpha = 1,
+//beta = 0) and need no realignment let MPI move each peer's block between
+//the tensor buffers directly, unless the grid uses node-aware collectives.
+template<typename T>
+bool
+DistTensor<T>::UseZeroCopyRedist(const DistTensor<T>& A, const double paddedElems, const T alpha, const T beta, const RedistRequest<T>* request) const
+{
+    if(request || alpha != T(1) || beta != T(0) || paddedElems < ZeroCopyRedistThreshold())
+        return false;
+    if(A.Grid().NodeAwareCollectives())
+        return false;
+
+    return CommBufsAligned(A);
+}
+
+//Whether A's data already sits on the processes that own it under our
+//alignments, so AlignCommBufRedist would not move anything
+template<typename T>
+bool
+DistTensor<T>::CommBufsAligned(const DistTensor<T>& A) const
+{
+    Location firstOwnerA = A.GetGridView().ToGridLoc(A.Alignments());
+    Location firstOwnerB = this->GetGridView().ToGridLoc(this->Alignments());
+    return !AnyElemwiseNotEqual(firstOwnerA, firstOwnerB);
+}
+
+//Rounds a blocking redistribution needing auxElems elements of auxiliary
+//memory is split into to stay within RedistMemoryLimit().  One round means
+//no splitting.
+template<typename T>
+Unsigned
+DistTensor<T>::RedistChunks(const ObjShape& commDataShape, const double auxElems, const RedistRequest<T>* request) const
+{
+    const std::size_t limit = RedistMemoryLimit();
+    if(request || limit == 0 || commDataShape.size() == 0 || prod(commDataShape) == 0)
+        return 1;
+
+    return std::max(1.0, Ceil(auxElems * sizeof(T) / limit));
+}
+
 template<typename T>
 ModeArray
 DistTensorBase<T>::GetMisalignedModes(const DistTensor<T>& B) const {
@@ -28,7 +28,7 @@ bool DistTensor<T>::CheckAllToAllCommRedist(const DistTensor<T>& A){
 }
 
 template <typename T>
-void DistTensor<T>::AllToAllCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const T alpha, const T beta){
+void DistTensor<T>::AllToAllCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const T alpha, const T beta, RedistRequest<T>* request){
         if(!this->CheckAllToAllCommRedist(A))
             LogicError("AllToAllDoubleModeRedist: Invalid redistribution request");
 
@@ -51,7 +51,29 @@ void DistTensor<T>::AllToAllCommRedist(const DistTensor<T>& A, const ModeArray&
         const Unsigned sendSize = prod(commDataShape);
         const Unsigned recvSize = sendSize;
 
-        T* auxBuf = this->auxMemory_.Require((sendSize + recvSize) * nRedistProcs);
+        //Let MPI read and write the tensor buffers for large redistributions
+        if(this->UseZeroCopyRedist(A, sendSize * nRedistProcs, alpha, beta, request)){
+            this->AllToAllZeroCopyCommRedist(A, commModes, commDataShape);
+            return;
+        }
+
+        //Move the data in rounds if its buffers would exceed the memory limit
+        const Unsigned nChunks = this->RedistChunks(commDataShape, double(sendSize + recvSize) * nRedistProcs, request);
+        if(nChunks > 1){
+            this->ChunkedCommRedist(A2A, A, commModes, commDataShape, nChunks, alpha, beta);
+            return;
+        }
+
+        //Send exact per-peer counts once the padding outweighs the data
+        const double exactElems = double(prod(A.Shape())) / prod(gvAShape);
+        if(this->UseExactCommCounts(A, sendSize * nRedistProcs, exactElems, request)){
+            this->AllToAllExactCommRedist(A, commModes, commDataShape, alpha, beta);
+            return;
+        }
+
+        //Nonblocking requests own their buffers until they complete
+        Memory<T>& auxMemory = request ? request->auxMemory_ : this->auxMemory_;
+        T* auxBuf = auxMemory.Require((sendSize + recvSize) * nRedistProcs);
 
         T* sendBuf = &(auxBuf[0]);
         T* recvBuf = &(auxBuf[sendSize*nRedistProcs]);
@@ -79,9 +101,23 @@ void DistTensor<T>::AllToAllCommRedist(const DistTensor<T>& A, const ModeArray&
             recvBuf = &(alignSendBuf[0]);
         }
 
-        mpi::AllToAll(sendBuf, sendSize, recvBuf, recvSize, comm);
+#ifdef HAVE_NONBLOCKING_COLLECTIVES
+        if(request)
+            mpi::IAllToAll(sendBuf, sendSize, recvBuf, recvSize, comm, request->request_);
+        else
+#endif
+        if(g.NodeAwareCollectives())
+            g.NodeAwareComm(commModes, comm).AllToAll(sendBuf, sendSize, recvBuf);
+        else
+            mpi::AllToAll(sendBuf, sendSize, recvBuf, recvSize, comm);
         PROFILE_STOP;
 
+        //Unpacking is deferred to the request's completion
+        if(request){
+            request->Post(recvBuf, this->Buffer(), sendSize, this->A2ACommUnpackInfo(A, commModes, commDataShape), alpha != T(0), alpha, beta);
+            return;
+        }
+
 //        ObjShape recvShape = commDataShape;
 //        recvShape.insert(recvShape.end(), nRedistProcs);
 //        PrintArray(recvBuf, recvShape, "recvBuf");
@@ -97,13 +133,143 @@ void DistTensor<T>::AllToAllCommRedist(const DistTensor<T>& A, const ModeArray&
         this->auxMemory_.Release();
 }
 
+//Each peer's block is packed densely (in our local permutation) at its
+//displacement, so only the real data is sent.
+template <typename T>
+void DistTensor<T>::AllToAllExactCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& commDataShape, const T alpha, const T beta){
+    const rote::Grid& g = A.Grid();
+    const mpi::Comm comm = this->GetCommunicatorForModes(commModes, g);
+    const Unsigned nRedistProcs = Max(1, prod(FilterVector(g.Shape(), commModes)));
+
+    std::shared_ptr<const CommPackInfo> packInfo = this->A2ACommPackInfo(A, commModes, commDataShape);
+    std::shared_ptr<const CommPackInfo> unpackInfo = this->A2ACommUnpackInfo(A, commModes, commDataShape);
+
+    std::vector<int> sendCounts(nRedistProcs, 0), sendDispls(nRedistProcs, 0);
+    std::vector<int> recvCounts(nRedistProcs, 0), recvDispls(nRedistProcs, 0);
+    for(Unsigned k = 0; k < packInfo->peers.size(); k++)
+        sendCounts[packInfo->peers[k]] = prod(packInfo->packData[k].loopShape);
+    for(Unsigned k = 0; k < unpackInfo->peers.size(); k++)
+        recvCounts[unpackInfo->peers[k]] = prod(unpackInfo->packData[k].loopShape);
+    for(Unsigned i = 1; i < nRedistProcs; i++){
+        sendDispls[i] = sendDispls[i-1] + sendCounts[i-1];
+        recvDispls[i] = recvDispls[i-1] + recvCounts[i-1];
+    }
+    const Unsigned sendSize = sendDispls[nRedistProcs-1] + sendCounts[nRedistProcs-1];
+    const Unsigned recvSize = recvDispls[nRedistProcs-1] + recvCounts[nRedistProcs-1];
+
+    T* auxBuf = this->auxMemory_.Require(sendSize + recvSize);
+    T* sendBuf = &(auxBuf[0]);
+    T* recvBuf = &(auxBuf[sendSize]);
+
+    //Determine permutation from local output to local input
+    const Permutation out2in = A.localPerm_.PermutationTo(this->localPerm_).InversePermutation();
+    const Permutation in2out = out2in.InversePermutation();
+    const T* dataBuf = A.LockedBuffer();
+
+    PROFILE_SECTION("A2APack");
+    PEER_PARALLEL_FOR(packInfo->peers.size())
+    for(Unsigned k = 0; k < packInfo->peers.size(); k++){
+        PackData packData = packInfo->packData[k];
+        packData.dstBufStrides = out2in.applyTo(Dimensions2Strides(in2out.applyTo(packData.loopShape)));
+        PackCommHelper(packData, &(dataBuf[packInfo->dataBufOffsets[k]]), &(sendBuf[sendDispls[packInfo->peers[k]]]));
+    }
+    PROFILE_STOP;
+
+    PROFILE_SECTION("A2AComm");
+    mpi::AllToAll(sendBuf, &(sendCounts[0]), &(sendDispls[0]), recvBuf, &(recvCounts[0]), &(recvDispls[0]), comm);
+    PROFILE_STOP;
+
+    PROFILE_SECTION("A2AUnpack");
+    this->UnpackExactCommRecvBuf(recvBuf, *unpackInfo, recvDispls, alpha, beta);
+    PROFILE_STOP;
+
+    this->auxMemory_.Release();
+}
+
+template <typename T>
+void DistTensor<T>::AllToAllZeroCopyCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& commDataShape){
+    const mpi::Comm comm = this->GetCommunicatorForModes(commModes, A.Grid());
+
+    std::shared_ptr<const CommDatatypes> sendTypes = this->A2ACommDatatypes(A2APack, A, commModes, commDataShape);
+    std::shared_ptr<const CommDatatypes> recvTypes = this->A2ACommDatatypes(A2AUnpack, A, commModes, commDataShape);
+
+    PROFILE_SECTION("A2AComm");
+    mpi::AllToAll(A.LockedBuffer(), &(sendTypes->counts[0]), &(sendTypes->displs[0]), &(sendTypes->types[0]),
+                  this->Buffer(), &(recvTypes->counts[0]), &(recvTypes->displs[0]), &(recvTypes->types[0]), comm);
+    PROFILE_STOP;
+}
+
+//Datatypes reading each peer's block straight from A (A2APack, or AGPack
+//for the whole local data of an allgather) or writing it straight into our
+//buffer (A2AUnpack).  Blocks are traversed in our local permutation on both
+//sides so the element orders agree.
+template <typename T>
+std::shared_ptr<const CommDatatypes> DistTensor<T>::A2ACommDatatypes(const CommPackKind kind, const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& bufShape){
+    const CommPackKey key = this->CommPackKeyFor(kind, A, commModes, ModeArray(), bufShape);
+    std::shared_ptr<const CommDatatypes> types = FindCommDatatypes(key, sizeof(T));
+    if(types)
+        return types;
+
+    const Unsigned nRedistProcs = Max(1, prod(FilterVector(this->Grid().Shape(), commModes)));
+    const Permutation in2out = A.localPerm_.PermutationTo(this->localPerm_);
+
+    CommPackInfo info;
+    if(kind == AGPack){
+        //Every peer gets all of our local data
+        PackData packData;
+        packData.loopShape = in2out.applyTo(A.LocalShape());
+        packData.srcBufStrides = in2out.applyTo(A.LocalStrides());
+        for(Unsigned i = 0; i < nRedistProcs; i++){
+            info.peers.push_back(i);
+            info.dataBufOffsets.push_back(0);
+            info.packData.push_back(packData);
+        }
+    }else if(kind == A2APack){
+        info = *(this->A2ACommPackInfo(A, commModes, bufShape));
+        for(Unsigned k = 0; k < info.peers.size(); k++){
+            info.packData[k].loopShape = in2out.applyTo(info.packData[k].loopShape);
+            info.packData[k].srcBufStrides = in2out.applyTo(info.packData[k].srcBufStrides);
+        }
+    }else{
+        info = *(this->A2ACommUnpackInfo(A, commModes, bufShape));
+        for(Unsigned k = 0; k < info.peers.size(); k++)
+            info.packData[k].srcBufStrides = info.packData[k].dstBufStrides;
+    }
+
+    std::shared_ptr<CommDatatypes> newTypes(new CommDatatypes(nRedistProcs));
+    for(Unsigned k = 0; k < info.peers.size(); k++){
+        const PackData& packData = info.packData[k];
+        if(prod(packData.loopShape) == 0)
+            continue;
+
+        const Unsigned peer = info.peers[k];
+        newTypes->counts[peer] = 1;
+        newTypes->types[peer] = StridedBlockType(packData.loopShape, packData.srcBufStrides, info.dataBufOffsets[k], sizeof(T));
+    }
+    return StoreCommDatatypes(key, sizeof(T), newTypes);
+}
+
 template <typename T>
 void DistTensor<T>::PackA2ACommSendBuf(const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& sendShape, T * const sendBuf){
-    const Unsigned order = A.Order();
     const T* dataBuf = A.LockedBuffer();
+    const Unsigned nElemsPerProc = prod(sendShape);
 
-    const Location zeros(order, 0);
-    const Location ones(order, 1);
+    std::shared_ptr<const CommPackInfo> packInfo = this->A2ACommPackInfo(A, commModes, sendShape);
+
+    PEER_PARALLEL_FOR(packInfo->peers.size())
+    for(Unsigned k = 0; k < packInfo->peers.size(); k++){
+        PackCommHelper(packInfo->packData[k], &(dataBuf[packInfo->dataBufOffsets[k]]), &(sendBuf[packInfo->peers[k] * nElemsPerProc]));
+    }
+}
+
+template <typename T>
+std::shared_ptr<const CommPackInfo> DistTensor<T>::A2ACommPackInfo(const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& sendShape){
+    const CommPackKey key = this->CommPackKeyFor(A2APack, A, commModes, ModeArray(), sendShape);
+    std::shared_ptr<const CommPackInfo> packInfo = FindCommPackInfo(key);
+    if(packInfo)
+        return packInfo;
+
+    const Unsigned order = A.Order();
 
     //GridView information
     const rote::GridView gvA = A.GetGridView();
@@ -115,12 +281,9 @@ void DistTensor<T>::PackA2ACommSendBuf(const DistTensor<T>& A, const ModeArray&
     const std::vector<Unsigned> commLCMs = LCMs(gvAShape, gvBShape);
     const std::vector<Unsigned> modeStrideFactor = ElemwiseDivide(commLCMs, gvAShape);
 
-    const Unsigned nElemsPerProc = prod(sendShape);
-
     //Grid information
     const rote::Grid& g = this->Grid();
     const ObjShape gridShape = g.Shape();
-    const Location myGridLoc = g.Loc();
 
     const Unsigned nRedistProcsAll = Max(1, prod(FilterVector(gridShape, commModes)));
 
@@ -129,6 +292,17 @@ void DistTensor<T>::PackA2ACommSendBuf(const DistTensor<T>& A, const ModeArray&
     SortVector(sortedCommModes);
     const ObjShape commShape = FilterVector(gridShape, sortedCommModes);
 
+    //Pack into permuted form to minimize striding when unpacking
+    const ObjShape finalShape = this->localPerm_.applyTo(sendShape);
+    const std::vector<Unsigned> finalStrides = Dimensions2Strides(finalShape);
+
+    //Determine permutation from local output to local input
+    const Permutation out2in = A.localPerm_.PermutationTo(this->localPerm_).InversePermutation();
+
+    std::vector<char> sendTo(nRedistProcsAll, 0);
+    std::vector<Unsigned> dataBufPtrs(nRedistProcsAll);
+    std::vector<PackData> packDatas(nRedistProcsAll);
+
     //For each process we send to, we need to determine the first element we need to send them
     PARALLEL_FOR
     for(Unsigned i = 0; i < nRedistProcsAll; i++){
@@ -172,40 +346,91 @@ void DistTensor<T>::PackA2ACommSendBuf(const DistTensor<T>& A, const ModeArray&
             firstSendLoc[j] = myFirstIndex;
         }
 
-        //Pack the data if we need to send data to p_i
+        //Record how to pack the data if we need to send data to p_i
         if(found && ElemwiseLessThan(firstSendLoc, this->Shape())){
             //Determine where the initial piece of data is located.
             const Location localLoc = A.Global2LocalIndex(firstSendLoc);
-            Unsigned dataBufPtr = LinearLocFromStrides(A.localPerm_.applyTo(localLoc), A.LocalStrides());
+            dataBufPtrs[i] = LinearLocFromStrides(A.localPerm_.applyTo(localLoc), A.LocalStrides());
 
-            PackData packData;
+            PackData& packData = packDatas[i];
             packData.srcBufStrides = ElemwiseProd(A.LocalStrides(), A.localPerm_.applyTo(modeStrideFactor));
 
-            //Pack into permuted form to minimize striding when unpacking
-            ObjShape finalShape = this->localPerm_.applyTo(sendShape);
-            std::vector<Unsigned> finalStrides = Dimensions2Strides(finalShape);
-
-            //Determine permutation from local output to local input
-            Permutation out2in = A.localPerm_.PermutationTo(this->localPerm_).InversePermutation();
-
             //Permute pack strides to match input local permutation (for correct packing)
             packData.dstBufStrides = out2in.applyTo(finalStrides);
 
             packData.loopShape = MaxLengths(ElemwiseSubtract(A.LocalShape(), A.localPerm_.applyTo(localLoc)), A.localPerm_.applyTo(modeStrideFactor));
+            sendTo[i] = 1;
+        }
+    }
 
-            PackCommHelper(packData, &(dataBuf[dataBufPtr]), &(sendBuf[i * nElemsPerProc]));
+    CommPackInfo info;
+    for(Unsigned i = 0; i < nRedistProcsAll; i++){
+        if(sendTo[i]){
+            info.peers.push_back(i);
+            info.dataBufOffsets.push_back(dataBufPtrs[i]);
+            info.packData.push_back(packDatas[i]);
         }
     }
+    return StoreCommPackInfo(key, info);
 }
 
 template<typename T>
 void DistTensor<T>::UnpackA2ACommRecvBuf(const T * const recvBuf, const ModeArray& commModes, const ObjShape& recvShape, const DistTensor<T>& A, const T alpha, const T beta){
+    T* dataBuf = this->Buffer();
+    const Unsigned nElemsPerProc = prod(recvShape);
 
-    const Unsigned order = A.Order();
+    std::shared_ptr<const CommPackInfo> unpackInfo = this->A2ACommUnpackInfo(A, commModes, recvShape);
+
+    PEER_PARALLEL_FOR(unpackInfo->peers.size())
+    for(Unsigned k = 0; k < unpackInfo->peers.size(); k++){
+        const PackData& unpackData = unpackInfo->packData[k];
+        const T* srcBuf = &(recvBuf[unpackInfo->peers[k] * nElemsPerProc]);
+        T* dstBuf = &(dataBuf[unpackInfo->dataBufOffsets[k]]);
+
+        if(alpha == T(0))
+            PackCommHelper(unpackData, srcBuf, dstBuf);
+        else{
+            YAxpByData data;
+            data.loopShape = unpackData.loopShape;
+            data.dstStrides = unpackData.dstBufStrides;
+            data.srcStrides = unpackData.srcBufStrides;
+            YAxpBy_fast(alpha, beta, srcBuf, dstBuf, data);
+        }
+    }
+}
+
+//Unpacks blocks that were packed densely at the given displacements
+template<typename T>
+void DistTensor<T>::UnpackExactCommRecvBuf(const T * const recvBuf, const CommPackInfo& unpackInfo, const std::vector<int>& recvDispls, const T alpha, const T beta){
     T* dataBuf = this->Buffer();
 
-    const Location zeros(order, 0);
-    const Location ones(order, 1);
+    PEER_PARALLEL_FOR(unpackInfo.peers.size())
+    for(Unsigned k = 0; k < unpackInfo.peers.size(); k++){
+        PackData unpackData = unpackInfo.packData[k];
+        unpackData.srcBufStrides = Dimensions2Strides(unpackData.loopShape);
+        const T* srcBuf = &(recvBuf[recvDispls[unpackInfo.peers[k]]]);
+        T* dstBuf = &(dataBuf[unpackInfo.dataBufOffsets[k]]);
+
+        if(alpha == T(0))
+            PackCommHelper(unpackData, srcBuf, dstBuf);
+        else{
+            YAxpByData data;
+            data.loopShape = unpackData.loopShape;
+            data.dstStrides = unpackData.dstBufStrides;
+            data.srcStrides = unpackData.srcBufStrides;
+            YAxpBy_fast(alpha, beta, srcBuf, dstBuf, data);
+        }
+    }
+}
+
+template<typename T>
+std::shared_ptr<const CommPackInfo> DistTensor<T>::A2ACommUnpackInfo(const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& recvShape){
+    const CommPackKey key = this->CommPackKeyFor(A2AUnpack, A, commModes, ModeArray(), recvShape);
+    std::shared_ptr<const CommPackInfo> unpackInfo = FindCommPackInfo(key);
+    if(unpackInfo)
+        return unpackInfo;
+
+    const Unsigned order = A.Order();
 
     //GridView information
     const rote::GridView gvA = A.GetGridView();
@@ -217,8 +442,6 @@ void DistTensor<T>::UnpackA2ACommRecvBuf(const T * const recvBuf, const ModeArra
     std::vector<Unsigned> commLCMs = rote::LCMs(gvAShape, gvBShape);
     std::vector<Unsigned> modeStrideFactor = ElemwiseDivide(commLCMs, gvBShape);
 
-    const Unsigned nElemsPerProc = prod(recvShape);
-
     //Grid information
     const rote::Grid& g = this->Grid();
     const ObjShape gridShape = g.Shape();
@@ -231,6 +454,14 @@ void DistTensor<T>::UnpackA2ACommRecvBuf(const T * const recvBuf, const ModeArra
     SortVector(sortedCommModes);
     const ObjShape commShape = FilterVector(gridShape, sortedCommModes);
 
+    //Recv data is permuted the same way our local data is permuted
+    const ObjShape actualRecvShape = this->localPerm_.applyTo(recvShape);
+    const std::vector<Unsigned> recvStrides = Dimensions2Strides(actualRecvShape);
+
+    std::vector<char> recvFrom(nRedistProcsAll, 0);
+    std::vector<Unsigned> dataBufPtrs(nRedistProcsAll);
+    std::vector<PackData> unpackDatas(nRedistProcsAll);
+
     //For each process we recv from, we need to determine the first element we get from them
     PARALLEL_FOR
     for(Unsigned i = 0; i < nRedistProcsAll; i++){
@@ -279,33 +510,31 @@ void DistTensor<T>::UnpackA2ACommRecvBuf(const T * const recvBuf, const ModeArra
             firstRecvLoc[j] = myFirstIndex;
         }
 
-        //Unpack the data if we need to recv data from p_i
+        //Record how to unpack the data if we need to recv data from p_i
         if(found && ElemwiseLessThan(firstRecvLoc, this->Shape())){
             //Determine where to place the initial piece of data.
             const Location localLoc = this->Global2LocalIndex(firstRecvLoc);
-            Unsigned dataBufPtr = LinearLocFromStrides(this->localPerm_.applyTo(localLoc), this->LocalStrides());
+            dataBufPtrs[i] = LinearLocFromStrides(this->localPerm_.applyTo(localLoc), this->LocalStrides());
 
-            PackData unpackData;
+            PackData& unpackData = unpackDatas[i];
             unpackData.dstBufStrides = ElemwiseProd(this->LocalStrides(), this->localPerm_.applyTo(modeStrideFactor));
-
-            //Recv data is permuted the same way our local data is permuted
-            ObjShape actualRecvShape = this->localPerm_.applyTo(recvShape);
-            unpackData.srcBufStrides = Dimensions2Strides(actualRecvShape);
+            unpackData.srcBufStrides = recvStrides;
 
             //Test to fix bug
             unpackData.loopShape = MaxLengths(ElemwiseSubtract(this->LocalShape(), this->localPerm_.applyTo(localLoc)), this->localPerm_.applyTo(modeStrideFactor));
+            recvFrom[i] = 1;
+        }
+    }
 
-            if(alpha == T(0))
-            	PackCommHelper(unpackData, &(recvBuf[i * nElemsPerProc]), &(dataBuf[dataBufPtr]));
-            else{
-            	YAxpByData data;
-            	data.loopShape = unpackData.loopShape;
-            	data.dstStrides = unpackData.dstBufStrides;
-            	data.srcStrides = unpackData.srcBufStrides;
-            	YAxpBy_fast(alpha, beta, &(recvBuf[i * nElemsPerProc]), &(dataBuf[dataBufPtr]), data);
-            }
+    CommPackInfo info;
+    for(Unsigned i = 0; i < nRedistProcsAll; i++){
+        if(recvFrom[i]){
+            info.peers.push_back(i);
+            info.dataBufOffsets.push_back(dataBufPtrs[i]);
+            info.packData.push_back(unpackDatas[i]);
         }
     }
+    return StoreCommPackInfo(key, info);
 }
 
 #define FULL(T) \
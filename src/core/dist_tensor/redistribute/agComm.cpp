@@ -27,7 +27,7 @@ bool DistTensor<T>::CheckAllGatherCommRedist(const DistTensor<T>& A){
 
 template<typename T>
 void
-DistTensor<T>::AllGatherCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const T alpha, const T beta){
+DistTensor<T>::AllGatherCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const T alpha, const T beta, RedistRequest<T>* request){
 #ifndef RELEASE
   if(!CheckAllGatherCommRedist(A))
     LogicError("AllGatherRedist: Invalid redistribution request");
@@ -51,7 +51,29 @@ DistTensor<T>::AllGatherCommRedist(const DistTensor<T>& A, const ModeArray& comm
   const Unsigned sendSize = prod(commDataShape);
   const Unsigned recvSize = sendSize * nRedistProcs;
 
-  T* auxBuf = this->auxMemory_.Require(sendSize + recvSize);
+  //Let MPI read and write the tensor buffers for large redistributions
+  if(this->UseZeroCopyRedist(A, recvSize, alpha, beta, request)){
+    this->AllGatherZeroCopyCommRedist(A, commModes);
+    return;
+  }
+
+  //Move the data in rounds if its buffers would exceed the memory limit
+  const Unsigned nChunks = this->RedistChunks(commDataShape, double(sendSize) + recvSize, request);
+  if(nChunks > 1){
+    this->ChunkedCommRedist(AG, A, commModes, commDataShape, nChunks, alpha, beta);
+    return;
+  }
+
+  //Gather exact per-peer counts once the padding outweighs the data
+  const double exactElems = double(prod(A.Shape())) / prod(A.GridViewShape());
+  if(this->UseExactCommCounts(A, sendSize, exactElems, request)){
+    this->AllGatherExactCommRedist(A, commModes, alpha, beta);
+    return;
+  }
+
+  //Nonblocking requests own their buffers until they complete
+  Memory<T>& auxMemory = request ? request->auxMemory_ : this->auxMemory_;
+  T* auxBuf = auxMemory.Require(sendSize + recvSize);
 
   T* sendBuf = &(auxBuf[0]);
   T* recvBuf = &(auxBuf[sendSize]);
@@ -78,9 +100,23 @@ DistTensor<T>::AllGatherCommRedist(const DistTensor<T>& A, const ModeArray& comm
         recvBuf = &(alignSendBuf[0]);
 	}
 
-	mpi::AllGather(sendBuf, sendSize, recvBuf, sendSize, comm);
+#ifdef HAVE_NONBLOCKING_COLLECTIVES
+	if(request)
+		mpi::IAllGather(sendBuf, sendSize, recvBuf, sendSize, comm, request->request_);
+	else
+#endif
+	if(g.NodeAwareCollectives())
+		g.NodeAwareComm(commModes, comm).AllGather(sendBuf, sendSize, recvBuf);
+	else
+		mpi::AllGather(sendBuf, sendSize, recvBuf, sendSize, comm);
     PROFILE_STOP;
 
+    //Unpacking is deferred to the request's completion
+    if(request){
+        request->Post(recvBuf, this->Buffer(), sendSize, this->A2ACommUnpackInfo(A, commModes, commDataShape), alpha != T(0), alpha, beta);
+        return;
+    }
+
 //    printf("beta: %.3f\n", beta);
 //    ObjShape recvShape = commDataShape;
 //    recvShape.insert(recvShape.end(), nRedistProcs);
@@ -96,6 +132,68 @@ DistTensor<T>::AllGatherCommRedist(const DistTensor<T>& A, const ModeArray& comm
     this->auxMemory_.Release();
 }
 
+//Every process sends its local data densely packed in our local
+//permutation, and receives each peer's block at its displacement.
+template<typename T>
+void
+DistTensor<T>::AllGatherExactCommRedist(const DistTensor<T>& A, const ModeArray& commModes, const T alpha, const T beta){
+  const rote::Grid& g = A.Grid();
+  const mpi::Comm comm = this->GetCommunicatorForModes(commModes, g);
+  const Unsigned nRedistProcs = Max(1, prod(FilterVector(g.Shape(), commModes)));
+
+  std::shared_ptr<const CommPackInfo> unpackInfo = this->A2ACommUnpackInfo(A, commModes, A.MaxLocalShape());
+
+  std::vector<int> recvCounts(nRedistProcs, 0), recvDispls(nRedistProcs, 0);
+  for(Unsigned k = 0; k < unpackInfo->peers.size(); k++)
+    recvCounts[unpackInfo->peers[k]] = prod(unpackInfo->packData[k].loopShape);
+  for(Unsigned i = 1; i < nRedistProcs; i++)
+    recvDispls[i] = recvDispls[i-1] + recvCounts[i-1];
+
+  const Unsigned sendSize = prod(A.LocalShape());
+  const Unsigned recvSize = recvDispls[nRedistProcs-1] + recvCounts[nRedistProcs-1];
+
+  T* auxBuf = this->auxMemory_.Require(sendSize + recvSize);
+  T* sendBuf = &(auxBuf[0]);
+  T* recvBuf = &(auxBuf[sendSize]);
+
+  //Determine permutation from local output to local input
+  const Permutation out2in = A.localPerm_.PermutationTo(this->localPerm_).InversePermutation();
+  const Permutation in2out = out2in.InversePermutation();
+
+  PROFILE_SECTION("AGPack");
+  PackData packData;
+  packData.loopShape = A.LocalShape();
+  packData.srcBufStrides = A.LocalStrides();
+  packData.dstBufStrides = out2in.applyTo(Dimensions2Strides(in2out.applyTo(A.LocalShape())));
+  PackCommHelper(packData, A.LockedBuffer(), &(sendBuf[0]));
+  PROFILE_STOP;
+
+  PROFILE_SECTION("AGComm");
+  mpi::AllGather(sendBuf, sendSize, recvBuf, &(recvCounts[0]), &(recvDispls[0]), comm);
+  PROFILE_STOP;
+
+  PROFILE_SECTION("AGUnpack");
+  this->UnpackExactCommRecvBuf(recvBuf, *unpackInfo, recvDispls, alpha, beta);
+  PROFILE_STOP;
+
+  this->auxMemory_.Release();
+}
+
+template<typename T>
+void
+DistTensor<T>::AllGatherZeroCopyCommRedist(const DistTensor<T>& A, const ModeArray& commModes){
+  const mpi::Comm comm = this->GetCommunicatorForModes(commModes, A.Grid());
+  const ObjShape commDataShape = A.MaxLocalShape();
+
+  std::shared_ptr<const CommDatatypes> sendTypes = this->A2ACommDatatypes(AGPack, A, commModes, commDataShape);
+  std::shared_ptr<const CommDatatypes> recvTypes = this->A2ACommDatatypes(A2AUnpack, A, commModes, commDataShape);
+
+  PROFILE_SECTION("AGComm");
+  mpi::AllToAll(A.LockedBuffer(), &(sendTypes->counts[0]), &(sendTypes->displs[0]), &(sendTypes->types[0]),
+                this->Buffer(), &(recvTypes->counts[0]), &(recvTypes->displs[0]), &(recvTypes->types[0]), comm);
+  PROFILE_STOP;
+}
+
 template <typename T>
 void DistTensor<T>::PackAGCommSendBuf(const DistTensor<T>& A, T * const sendBuf)
 {
@@ -18,13 +18,13 @@ namespace rote{
 
 template <typename T>
 void
-DistTensor<T>::AllGatherRedistFrom(const DistTensor<T>& A, const ModeArray& commModes, T alpha, T beta){
+DistTensor<T>::AllGatherRedistFrom(const DistTensor<T>& A, const ModeArray& commModes, T alpha, T beta, RedistRequest<T>* request){
     PROFILE_SECTION("AGRedist");
     this->ResizeTo(A);
 
     ModeArray sortedCommModes = commModes;
     SortVector(sortedCommModes);
-    AllGatherCommRedist(A, sortedCommModes, alpha, beta);
+    AllGatherCommRedist(A, sortedCommModes, alpha, beta, request);
     PROFILE_STOP;
 }
 
@@ -0,0 +1,180 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#include "rote.hpp"
+
+namespace {
+
+std::size_t chunkRounds = 0;
+
+} // anonymous namespace
+
+namespace rote{
+
+std::size_t RedistChunkRounds()
+{ return ::chunkRounds; }
+
+//Splits an AllToAll or AllGather redistribution into rounds over slabs of
+//the per-peer blocks along one mode, so the auxiliary buffers only ever hold
+//one slab per peer.  The slab mode is the one with the most entries in a
+//block (the outermost of our local permutation on ties), so it can be cut
+//into the requested number of rounds if any mode can.  Every process derives
+//the same slabs from global shapes, so the rounds line up across the
+//communicator.
+template <typename T>
+void DistTensor<T>::ChunkedCommRedist(const RedistType type, const DistTensor<T>& A, const ModeArray& commModes, const ObjShape& commDataShape, const Unsigned nChunks, const T alpha, const T beta){
+    const rote::Grid& g = A.Grid();
+    const mpi::Comm comm = this->GetCommunicatorForModes(commModes, g);
+    const Unsigned nRedistProcs = Max(1, prod(FilterVector(g.Shape(), commModes)));
+    const Unsigned order = commDataShape.size();
+
+    const std::vector<Unsigned> outPerm = this->localPerm_.Entries();
+    Mode chunkMode = outPerm[order - 1];
+    for(Unsigned i = order - 1; i < order; i--)
+        if(commDataShape[outPerm[i]] > commDataShape[chunkMode])
+            chunkMode = outPerm[i];
+
+    const Unsigned chunkExtent = IntCeil(commDataShape[chunkMode], std::min(nChunks, commDataShape[chunkMode]));
+    ObjShape chunkShape = commDataShape;
+    chunkShape[chunkMode] = chunkExtent;
+    const Unsigned chunkSize = prod(chunkShape);
+
+    //AllGathers send one block (all of our data) rather than one per peer
+    CommPackInfo packInfo;
+    if(type == A2A){
+        packInfo = *(this->A2ACommPackInfo(A, commModes, commDataShape));
+    }else{
+        PackData packData;
+        packData.loopShape = A.LocalShape();
+        packData.srcBufStrides = A.LocalStrides();
+        packInfo.peers.push_back(0);
+        packInfo.dataBufOffsets.push_back(0);
+        packInfo.packData.push_back(packData);
+    }
+    std::shared_ptr<const CommPackInfo> unpackInfo = this->A2ACommUnpackInfo(A, commModes, commDataShape);
+
+    const Unsigned nSendBlocks = type == A2A ? nRedistProcs : 1;
+    T* auxBuf = this->auxMemory_.Require((nSendBlocks + nRedistProcs) * chunkSize);
+
+    for(Unsigned chunkStart = 0; chunkStart < commDataShape[chunkMode]; chunkStart += chunkExtent){
+        ::chunkRounds++;
+        T* sendBuf = &(auxBuf[0]);
+        T* recvBuf = &(auxBuf[nSendBlocks * chunkSize]);
+
+        PROFILE_SECTION("ChunkPack");
+        this->PackChunkCommSendBuf(A, packInfo, chunkShape, chunkMode, chunkStart, sendBuf);
+        PROFILE_STOP;
+
+        PROFILE_SECTION("ChunkComm");
+        //Realignment (as in the unchunked routines)
+        T* alignSendBuf = &(sendBuf[0]);
+        T* alignRecvBuf = &(auxBuf[nRedistProcs * chunkSize]);
+        bool didAlign = this->AlignCommBufRedist(A, alignSendBuf, nSendBlocks * chunkSize, alignRecvBuf, nSendBlocks * chunkSize);
+        if(didAlign){
+            sendBuf = &(alignRecvBuf[0]);
+            recvBuf = &(alignSendBuf[0]);
+        }
+
+        if(type == A2A){
+            if(g.NodeAwareCollectives())
+                g.NodeAwareComm(commModes, comm).AllToAll(sendBuf, chunkSize, recvBuf);
+            else
+                mpi::AllToAll(sendBuf, chunkSize, recvBuf, chunkSize, comm);
+        }else{
+            if(g.NodeAwareCollectives())
+                g.NodeAwareComm(commModes, comm).AllGather(sendBuf, chunkSize, recvBuf);
+            else
+                mpi::AllGather(sendBuf, chunkSize, recvBuf, chunkSize, comm);
+        }
+        PROFILE_STOP;
+
+        PROFILE_SECTION("ChunkUnpack");
+        this->UnpackChunkCommRecvBuf(recvBuf, *unpackInfo, chunkShape, chunkMode, chunkStart, alpha, beta);
+        PROFILE_STOP;
+    }
+
+    this->auxMemory_.Release();
+}
+
+//The entries of a block with index along chunkMode in
+//[chunkStart, chunkStart + chunkShape[chunkMode]).  Returns the offset of
+//the first one from the start of the block.
+inline Unsigned ChunkPackData(PackData& data, const Unsigned pos, const Unsigned chunkStart, const Unsigned chunkExtent, const std::vector<Unsigned>& blockStrides){
+    const Unsigned extent = data.loopShape[pos];
+    data.loopShape[pos] = extent > chunkStart ? std::min(extent - chunkStart, chunkExtent) : 0;
+    return chunkStart * blockStrides[pos];
+}
+
+template <typename T>
+void DistTensor<T>::PackChunkCommSendBuf(const DistTensor<T>& A, const CommPackInfo& packInfo, const ObjShape& chunkShape, const Mode chunkMode, const Unsigned chunkStart, T * const sendBuf){
+    const T* dataBuf = A.LockedBuffer();
+    const Unsigned nElemsPerProc = prod(chunkShape);
+
+    //Pack into permuted form to minimize striding when unpacking
+    const Permutation out2in = A.localPerm_.PermutationTo(this->localPerm_).InversePermutation();
+    const std::vector<Unsigned> dstStrides = out2in.applyTo(Dimensions2Strides(this->localPerm_.applyTo(chunkShape)));
+    const Unsigned pos = IndexOf(A.localPerm_.Entries(), chunkMode);
+
+    PEER_PARALLEL_FOR(packInfo.peers.size())
+    for(Unsigned k = 0; k < packInfo.peers.size(); k++){
+        PackData packData = packInfo.packData[k];
+        const Unsigned offset = ChunkPackData(packData, pos, chunkStart, chunkShape[chunkMode], packData.srcBufStrides);
+        if(prod(packData.loopShape) == 0)
+            continue;
+        packData.dstBufStrides = dstStrides;
+        PackCommHelper(packData, &(dataBuf[packInfo.dataBufOffsets[k] + offset]), &(sendBuf[packInfo.peers[k] * nElemsPerProc]));
+    }
+}
+
+template<typename T>
+void DistTensor<T>::UnpackChunkCommRecvBuf(const T * const recvBuf, const CommPackInfo& unpackInfo, const ObjShape& chunkShape, const Mode chunkMode, const Unsigned chunkStart, const T alpha, const T beta){
+    T* dataBuf = this->Buffer();
+    const Unsigned nElemsPerProc = prod(chunkShape);
+
+    const std::vector<Unsigned> srcStrides = Dimensions2Strides(this->localPerm_.applyTo(chunkShape));
+    const Unsigned pos = IndexOf(this->localPerm_.Entries(), chunkMode);
+
+    PEER_PARALLEL_FOR(unpackInfo.peers.size())
+    for(Unsigned k = 0; k < unpackInfo.peers.size(); k++){
+        PackData unpackData = unpackInfo.packData[k];
+        const Unsigned offset = ChunkPackData(unpackData, pos, chunkStart, chunkShape[chunkMode], unpackData.dstBufStrides);
+        if(prod(unpackData.loopShape) == 0)
+            continue;
+        unpackData.srcBufStrides = srcStrides;
+        const T* srcBuf = &(recvBuf[unpackInfo.peers[k] * nElemsPerProc]);
+        T* dstBuf = &(dataBuf[unpackInfo.dataBufOffsets[k] + offset]);
+
+        if(alpha == T(0))
+            PackCommHelper(unpackData, srcBuf, dstBuf);
+        else{
+            YAxpByData data;
+            data.loopShape = unpackData.loopShape;
+            data.dstStrides = unpackData.dstBufStrides;
+            data.srcStrides = unpackData.srcBufStrides;
+            YAxpBy_fast(alpha, beta, srcBuf, dstBuf, data);
+        }
+    }
+}
+
+#define FULL(T) \
+    template class DistTensor<T>;
+
+FULL(Int)
+#ifndef DISABLE_FLOAT
+FULL(float)
+#endif
+FULL(double)
+
+#ifndef DISABLE_COMPLEX
+#ifndef DISABLE_FLOAT
+FULL(std::complex<float>)
+#endif
+FULL(std::complex<double>)
+#endif
+
+} //namespace rote
@@ -101,7 +101,9 @@ void DistTensor<T>::UnpackLocalCommRecvBuf(const DistTensor<T>& A, const T* recv
 //    PrintVector(myFirstLocB, "firstLocB");
 //    PrintVector(myFirstElemLocAligned, "firstAlignedALoc");
 
-    Unsigned dataBufPtr = LinearLocFromStrides(ElemwiseDivide(ElemwiseSubtract(myFirstLocB, myFirstElemLocAligned), gvAShape), Dimensions2Strides(A.MaxLocalShape()));
+    //The buffer was packed in this tensor's local permutation
+    const std::vector<Unsigned> recvStrides = Dimensions2Strides(this->localPerm_.applyTo(A.MaxLocalShape()));
+    Unsigned dataBufPtr = LinearLocFromStrides(this->localPerm_.applyTo(ElemwiseDivide(ElemwiseSubtract(myFirstLocB, myFirstElemLocAligned), gvAShape)), recvStrides);
 
 
     const std::vector<Unsigned> commLCMs = LCMs(gvAShape, gvBShape);
@@ -111,7 +113,7 @@ void DistTensor<T>::UnpackLocalCommRecvBuf(const DistTensor<T>& A, const T* recv
 
     PackData unpackData;
     unpackData.loopShape = this->LocalShape();
-    unpackData.srcBufStrides = ElemwiseProd(Dimensions2Strides(A.MaxLocalShape()), modeStrideFactor);
+    unpackData.srcBufStrides = ElemwiseProd(recvStrides, this->localPerm_.applyTo(modeStrideFactor));
     unpackData.dstBufStrides = this->LocalStrides();
 
 //    PrintPackData(unpackData, "unpacking local");
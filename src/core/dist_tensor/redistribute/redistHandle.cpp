@@ -0,0 +1,52 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#include "rote.hpp"
+
+namespace rote{
+
+template <typename T>
+RedistHandle<T>::RedistHandle(const DistTensor<T>& B, const DistTensor<T>& A, const ModeArray& reduceModes)
+: plan_(*CachedRedistPlan(B.TensorDist(), A.TensorDist(), reduceModes, B.Grid(), A.Shape(), sizeof(T))),
+  reduceModes_(reduceModes), distB_(B.TensorDist()), distA_(A.TensorDist()), gridShape_(B.Grid().Shape())
+{ }
+
+template <typename T>
+RedistHandle<T>::~RedistHandle()
+{ }
+
+template <typename T>
+bool RedistHandle<T>::Matches(const DistTensor<T>& B, const DistTensor<T>& A) const{
+	return B.TensorDist() == distB_ && A.TensorDist() == distA_ &&
+	       B.Grid().Shape() == gridShape_ && A.Grid().Shape() == gridShape_;
+}
+
+template <typename T>
+void RedistHandle<T>::Execute(DistTensor<T>& B, const DistTensor<T>& A, const T alpha, const T beta) const{
+	if(!Matches(B, A))
+		LogicError("RedistHandle: tensors do not match the distributions the handle was planned for");
+	B.RedistFrom(plan_, A, reduceModes_, alpha, beta);
+}
+
+#define FULL(T) \
+    template class RedistHandle<T>;
+
+FULL(Int)
+#ifndef DISABLE_FLOAT
+FULL(float)
+#endif
+FULL(double)
+
+#ifndef DISABLE_COMPLEX
+#ifndef DISABLE_FLOAT
+FULL(std::complex<float>)
+#endif
+FULL(std::complex<double>)
+#endif
+
+} //namespace rote
@@ -10,27 +10,68 @@
 */
 #include "rote.hpp"
 
+namespace {
+
+std::size_t resultHits = 0;
+
+} // anonymous namespace
+
 namespace rote{
 
+std::size_t RedistResultHits()
+{ return ::resultHits; }
+
 template <typename T>
 void DistTensor<T>::RedistFrom(const DistTensor<T>& A, const ModeArray& reduceModes, const T alpha, const T beta){
+	std::shared_ptr<const RedistPlan> redistPlan = CachedRedistPlan(this->TensorDist(), A.TensorDist(), reduceModes, this->Grid(), A.Shape(), sizeof(T));
+	RedistFrom(*redistPlan, A, reduceModes, alpha, beta);
+}
+
+template <typename T>
+void DistTensor<T>::RedistFrom(const RedistPlan& redistPlan, const DistTensor<T>& A, const ModeArray& reduceModes, const T alpha, const T beta){
+	ExecuteRedistPlan(redistPlan, A, reduceModes, alpha, beta, 0);
+}
+
+template <typename T>
+void DistTensor<T>::RedistFromAsync(const DistTensor<T>& A, const ModeArray& reduceModes, RedistRequest<T>& request, const T alpha, const T beta){
+	std::shared_ptr<const RedistPlan> redistPlan = CachedRedistPlan(this->TensorDist(), A.TensorDist(), reduceModes, this->Grid(), A.Shape(), sizeof(T));
+	RedistFromAsync(*redistPlan, A, reduceModes, request, alpha, beta);
+}
+
+template <typename T>
+void DistTensor<T>::RedistFromAsync(const DistTensor<T>& A, RedistRequest<T>& request){
+	ModeArray reduceModes;
+	RedistFromAsync(A, reduceModes, request, T(1), T(0));
+}
+
+template <typename T>
+void DistTensor<T>::RedistFromAsync(const RedistPlan& redistPlan, const DistTensor<T>& A, const ModeArray& reduceModes, RedistRequest<T>& request, const T alpha, const T beta){
+	//A request carries at most one collective at a time
+	request.Wait();
+	ExecuteRedistPlan(redistPlan, A, reduceModes, alpha, beta, &request);
+}
+
+//NOTE: When request is non-null, the collective of the final step is only
+//      posted (A2A, AG and RS); Local, Perm and AR steps always complete here.
+template <typename T>
+void DistTensor<T>::ExecuteRedistPlan(const RedistPlan& redistPlan, const DistTensor<T>& A, const ModeArray& reduceModes, const T alpha, const T beta, RedistRequest<T>* request){
   PROFILE_SECTION("RedistFrom");
+	this->BumpVersion();
 
 	const Grid& g = this->Grid();
-	RedistPlan redistPlan(this->TensorDist(), A.TensorDist(), reduceModes, g);
 	// PrintRedistPlan(redistPlan, "Plan");
 
 	if (redistPlan.size() == 0) {
 		ModeArray blank;
 		this->PermutationRedistFrom(A, blank, alpha, beta);
-		return;
+		PROFILE_RETURN;
 	}
 
   DistTensor<T> tmp(A.TensorDist(), g);
   tmp.LockedAttach(A.Shape(), A.Alignments(), A.LockedBuffer(), A.LocalPermutation(), A.LocalStrides(), this->Grid());
 
   for(int i = 0; i < redistPlan.size() - 1; i++){
-  	Redist redist = redistPlan[i];
+  	const Redist& redist = redistPlan[i];
   	DistTensor<T> tmp2(redist.dB(), g);
 
   	switch(redist.type()){
@@ -42,17 +83,18 @@ void DistTensor<T>::RedistFrom(const DistTensor<T>& A, const ModeArray& reduceMo
       case AR: tmp2.AllReduceRedistFrom(tmp, reduceModes); break;
     	default: LogicError("Unsupported Communication");
   	}
+  	//Hand tmp2's buffer over rather than copying it
   	tmp.Empty();
-  	tmp = tmp2;
+  	tmp = std::move(tmp2);
   }
 
-	Redist redist = redistPlan[-1];
+	const Redist& redist = redistPlan[-1];
 	switch(redist.type()){
-		case AG: AllGatherRedistFrom(tmp, redist.modes(), alpha, beta); break;
-		case A2A: AllToAllRedistFrom(tmp, redist.modes(), alpha, beta); break;
+		case AG: AllGatherRedistFrom(tmp, redist.modes(), alpha, beta, request); break;
+		case A2A: AllToAllRedistFrom(tmp, redist.modes(), alpha, beta, request); break;
 		case Local: LocalRedistFrom(tmp, alpha, beta); break;
 		case Perm: PermutationRedistFrom(tmp, redist.modes(), alpha, beta); break;
-		case RS: ReduceScatterUpdateRedistFrom(alpha, tmp, beta, reduceModes); break;
+		case RS: ReduceScatterUpdateRedistFrom(alpha, tmp, beta, reduceModes, request); break;
     case AR: AllReduceUpdateRedistFrom(alpha, tmp, beta, reduceModes); break;
 		default: LogicError("Unsupported Communication");
 	}
@@ -60,10 +102,74 @@ void DistTensor<T>::RedistFrom(const DistTensor<T>& A, const ModeArray& reduceMo
   PROFILE_STOP;
 }
 
+//NOTE: Views are cached by the part of the tensor they cover, so the
+//      partition views redistributed by the blocked Contract loops hit when
+//      the same operand is contracted again.  Attached buffers, which
+//      change without a new version, views as targets and asynchronous
+//      redistributions are not cached.
 template <typename T>
 void DistTensor<T>::RedistFrom(const DistTensor<T>& A){
 	ModeArray reduceModes;
+	if(RedistResultCacheLimit() == 0 || A.attached_ || this->Viewing() || &A == this){
+		RedistFrom(A, reduceModes, T(1), T(0));
+		return;
+	}
+
+	RedistResultKey key;
+	key.src = A.version_.get();
+	key.version = A.Version();
+	key.data = A.LockedBuffer();
+	key.srcShape = A.Shape();
+	key.srcDist = DistEntries(A.TensorDist());
+	key.srcAlign = A.Alignments();
+	key.srcPerm = A.LocalPermutation().Entries();
+	key.grid = &(this->Grid());
+	key.dist = DistEntries(this->TensorDist());
+	key.align = this->Alignments();
+	key.perm = this->LocalPermutation().Entries();
+
+	//Every process must take the same path, as only a miss communicates.
+	//Local caches can disagree whatever the eviction order: a write bumps
+	//the version only on the processes making it (Set only on the owner),
+	//so the decision is agreed on with an AllReduce.
+	std::shared_ptr<const DistTensor<T> > cached = std::static_pointer_cast<const DistTensor<T> >(FindRedistResult(key));
+	if(mpi::AllReduce(cached ? 1 : 0, mpi::MIN, this->Grid().OwningComm())){
+		this->ResizeTo(A.Shape());
+		this->CopyLocalBuffer(*cached);
+		::resultHits++;
+		return;
+	}
+
+	//This tensor may be written later, so the cache keeps its own copy
 	RedistFrom(A, reduceModes, T(1), T(0));
+	std::shared_ptr<const DistTensor<T> > result(new DistTensor<T>(*this));
+	StoreRedistResult(key, result, result->AllocatedMemory() * sizeof(T));
+}
+
+template <typename T>
+CommPackKey DistTensor<T>::CommPackKeyFor(const CommPackKind kind, const DistTensor<T>& A, const ModeArray& commModes, const ModeArray& reduceModes, const ObjShape& bufShape) const{
+	const rote::Grid& g = this->Grid();
+
+	CommPackKey key;
+	key.kind = kind;
+	key.gridShape = g.Shape();
+	key.gridLoc = g.Loc();
+	key.commModes = commModes;
+	key.reduceModes = reduceModes;
+	key.bufShape = bufShape;
+
+	key.distA = DistEntries(A.TensorDist());
+	key.shapeA = A.Shape();
+	key.alignA = A.Alignments();
+	key.permA = A.localPerm_.Entries();
+	key.stridesA = A.LocalStrides();
+
+	key.distB = DistEntries(this->TensorDist());
+	key.shapeB = this->Shape();
+	key.alignB = this->Alignments();
+	key.permB = this->localPerm_.Entries();
+	key.stridesB = this->LocalStrides();
+	return key;
 }
 
 #define FULL(T) \
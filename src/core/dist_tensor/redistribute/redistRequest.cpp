@@ -0,0 +1,107 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#include "rote.hpp"
+
+namespace rote{
+
+template <typename T>
+RedistRequest<T>::RedistRequest()
+: active_(false), request_(mpi::REQUEST_NULL), auxMemory_(), recvBuf_(0), dataBuf_(0),
+  nElemsPerProc_(0), unpackInfo_(), update_(false), alpha_(T(1)), beta_(T(0))
+{ }
+
+template <typename T>
+RedistRequest<T>::~RedistRequest()
+{
+    //Never free buffers MPI may still be writing to
+    if(active_)
+        Wait();
+}
+
+template <typename T>
+void RedistRequest<T>::Wait(){
+    if(!active_)
+        return;
+
+    PROFILE_SECTION("RedistWait");
+    mpi::Wait(request_);
+    PROFILE_STOP;
+    Unpack();
+}
+
+template <typename T>
+bool RedistRequest<T>::Test(){
+    if(!active_)
+        return true;
+    if(!mpi::Test(request_))
+        return false;
+    Unpack();
+    return true;
+}
+
+template <typename T>
+void RedistRequest<T>::Post(const T* recvBuf, T* dataBuf, const Unsigned nElemsPerProc, const std::shared_ptr<const CommPackInfo>& unpackInfo, const bool update, const T alpha, const T beta){
+    recvBuf_ = recvBuf;
+    dataBuf_ = dataBuf;
+    nElemsPerProc_ = nElemsPerProc;
+    unpackInfo_ = unpackInfo;
+    update_ = update;
+    alpha_ = alpha;
+    beta_ = beta;
+    active_ = true;
+}
+
+template <typename T>
+void RedistRequest<T>::Unpack(){
+    PROFILE_SECTION("RedistUnpack");
+    const CommPackInfo& info = *unpackInfo_;
+
+    PEER_PARALLEL_FOR(info.peers.size())
+    for(Unsigned k = 0; k < info.peers.size(); k++){
+        const PackData& unpackData = info.packData[k];
+        const T* srcBuf = &(recvBuf_[info.peers[k] * nElemsPerProc_]);
+        T* dstBuf = &(dataBuf_[info.dataBufOffsets[k]]);
+
+        if(!update_)
+            PackCommHelper(unpackData, srcBuf, dstBuf);
+        else{
+            //Copy-construct and swap: GCC flags the inlined copy-assignment
+            //into data's empty (null) buffers with -Wnonnull
+            YAxpByData data;
+            ObjShape(unpackData.loopShape).swap(data.loopShape);
+            std::vector<Unsigned>(unpackData.dstBufStrides).swap(data.dstStrides);
+            std::vector<Unsigned>(unpackData.srcBufStrides).swap(data.srcStrides);
+            YAxpBy_fast(alpha_, beta_, srcBuf, dstBuf, data);
+        }
+    }
+    PROFILE_STOP;
+
+    active_ = false;
+    request_ = mpi::REQUEST_NULL;
+    unpackInfo_.reset();
+    auxMemory_.Empty();
+}
+
+#define FULL(T) \
+    template class RedistRequest<T>;
+
+FULL(Int)
+#ifndef DISABLE_FLOAT
+FULL(float)
+#endif
+FULL(double)
+
+#ifndef DISABLE_COMPLEX
+#ifndef DISABLE_FLOAT
+FULL(std::complex<float>)
+#endif
+FULL(std::complex<double>)
+#endif
+
+} //namespace rote
@@ -18,7 +18,7 @@ namespace rote{
 
 template<typename T>
 void
-DistTensor<T>::ReduceUpdateRedistFrom(const RedistType& redistType, const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& rModes)
+DistTensor<T>::ReduceUpdateRedistFrom(const RedistType& redistType, const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& rModes, RedistRequest<T>* request)
 {
     Unsigned i, j;
     const rote::GridView gv = A.GetGridView();
@@ -97,7 +97,7 @@ DistTensor<T>::ReduceUpdateRedistFrom(const RedistType& redistType, const T alph
    // Print(tmp, "tmp before RTO");
 
     switch(redistType){
-		case RS:  tmp2.ReduceScatterUpdateCommRedist(alpha, tmp, beta, sortedRModes, commModes); break;
+		case RS:  tmp2.ReduceScatterUpdateCommRedist(alpha, tmp, beta, sortedRModes, commModes, request); break;
 		case RTO: tmp2.ReduceToOneUpdateCommRedist(alpha, tmp, beta, commModes); break;
 		case AR:  tmp2.AllReduceUpdateCommRedist(alpha, tmp, beta, commModes); break;
 		default: break;
@@ -20,12 +20,17 @@ bool DistTensor<T>::CheckReduceScatterCommRedist(const DistTensor<T>& A){
 }
 
 template <typename T>
-void DistTensor<T>::ReduceScatterUpdateCommRedist(const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& reduceModes, const ModeArray& commModes){
+void DistTensor<T>::ReduceScatterUpdateCommRedist(const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& reduceModes, const ModeArray& commModes, RedistRequest<T>* request){
   if(!CheckReduceScatterCommRedist(A))
     LogicError("ReduceScatterRedist: Invalid redistribution request");
 
+	//Nothing to communicate, so update with the local sum (keeping beta*B)
 	if (commModes.size() == 0) {
-		LocalReduce(alpha, A, *this, reduceModes);
+		if(this->Participating()){
+			Scal(beta, this->Tensor());
+			Permutation permBToA = this->LocalPermutation().PermutationTo(A.LocalPermutation());
+			LocalReduce(alpha, A.LockedTensor(), this->Tensor(), permBToA, FilterVector(A.LocalPermutation().InversePermutation().Entries(), reduceModes));
+		}
 		return;
 	}
 
@@ -45,8 +50,17 @@ void DistTensor<T>::ReduceScatterUpdateCommRedist(const T alpha, const DistTenso
   const Unsigned recvSize = prod(commDataShape);
   const Unsigned sendSize = recvSize * nRedistProcs;
 
+  //Reduce exact per-peer counts once the padding outweighs the data
+  const double exactElems = double(prod(this->Shape())) / prod(gvB.ParticipatingShape()) * nRedistProcs;
+  if(UseExactCommCounts(A, sendSize, exactElems, request)){
+    ReduceScatterExactCommRedist(alpha, A, beta, reduceModes, commModes);
+    return;
+  }
+
     //NOTE: requiring 2*sendSize in case we realign
-	T* auxBuf = this->auxMemory_.Require(sendSize + sendSize);
+  //Nonblocking requests own their buffers until they complete
+  Memory<T>& auxMemory = request ? request->auxMemory_ : this->auxMemory_;
+	T* auxBuf = auxMemory.Require(sendSize + sendSize);
 	MemZero(&(auxBuf[0]), sendSize + sendSize);
 
 	T* sendBuf = &(auxBuf[0]);
@@ -77,9 +91,32 @@ void DistTensor<T>::ReduceScatterUpdateCommRedist(const T alpha, const DistTenso
 		recvBuf = &(alignSendBuf[0]);
   }
 
-  mpi::ReduceScatter(sendBuf, recvBuf, recvSize, comm);
+#ifdef HAVE_NONBLOCKING_COLLECTIVES
+  if(request)
+    mpi::IReduceScatter(sendBuf, recvBuf, recvSize, comm, request->request_);
+  else
+#endif
+  if(g.NodeAwareCollectives())
+    g.NodeAwareComm(commModes, comm).ReduceScatter(sendBuf, recvBuf, recvSize);
+  else
+    mpi::ReduceScatter(sendBuf, recvBuf, recvSize, comm);
   PROFILE_STOP;
 
+  //Unpacking is deferred to the request's completion
+  if(request){
+    CommPackInfo unpackInfo;
+    PackData unpackData;
+    unpackData.loopShape = this->LocalShape();
+    unpackData.srcBufStrides = Dimensions2Strides(this->localPerm_.applyTo(this->MaxLocalShape()));
+    unpackData.dstBufStrides = this->LocalStrides();
+    unpackInfo.peers.push_back(0);
+    unpackInfo.dataBufOffsets.push_back(0);
+    unpackInfo.packData.push_back(unpackData);
+
+    request->Post(recvBuf, this->Buffer(), recvSize, std::make_shared<const CommPackInfo>(unpackInfo), true, alpha, beta);
+    return;
+  }
+
   // PrintArray(recvBuf, commDataShape, "recvBuf");
 
   //Unpack the data (if participating)
@@ -93,14 +130,99 @@ void DistTensor<T>::ReduceScatterUpdateCommRedist(const T alpha, const DistTenso
   this->auxMemory_.Release();
 }
 
+//Each peer's block is packed densely with that peer's real local shape, so
+//the counts match what MPI_Reduce_scatter hands back to every process.
+template <typename T>
+void DistTensor<T>::ReduceScatterExactCommRedist(const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& reduceModes, const ModeArray& commModes){
+  const rote::Grid& g = A.Grid();
+  const mpi::Comm comm = this->GetCommunicatorForModes(commModes, g);
+  const rote::GridView gvB = this->GetGridView();
+  const ObjShape gvBShape = gvB.ParticipatingShape();
+  const Unsigned nRedistProcs = Max(1, prod(FilterVector(g.Shape(), commModes)));
+
+  ModeArray sortedCommModes = commModes;
+  SortVector(sortedCommModes);
+  const ObjShape commShape = FilterVector(g.Shape(), sortedCommModes);
+
+  //Local shape (in our permutation) of every process we reduce to
+  std::vector<ObjShape> blockShapes(nRedistProcs);
+  std::vector<int> recvCounts(nRedistProcs, 0), sendDispls(nRedistProcs, 0);
+  for(Unsigned i = 0; i < nRedistProcs; i++){
+    Location sortedCommLoc = LinearLoc2Loc(i, commShape);
+    Location procGridLoc = g.Loc();
+    for(Unsigned j = 0; j < sortedCommModes.size(); j++)
+      procGridLoc[sortedCommModes[j]] = sortedCommLoc[j];
+
+    const Location procGVLoc = g.ToParticipatingGridViewLoc(procGridLoc, gvB);
+    const ObjShape procLocalShape = Lengths(this->Shape(), Shifts(procGVLoc, this->Alignments(), gvBShape), gvBShape);
+    blockShapes[i] = this->localPerm_.applyTo(procLocalShape);
+    recvCounts[i] = prod(procLocalShape);
+    if(i > 0)
+      sendDispls[i] = sendDispls[i-1] + recvCounts[i-1];
+  }
+  const Unsigned sendSize = sendDispls[nRedistProcs-1] + recvCounts[nRedistProcs-1];
+  const Unsigned recvSize = prod(this->LocalShape());
+
+  T* auxBuf = this->auxMemory_.Require(sendSize + recvSize);
+  MemZero(&(auxBuf[0]), sendSize);
+
+  T* sendBuf = &(auxBuf[0]);
+  T* recvBuf = &(auxBuf[sendSize]);
+
+  //Determine permutation from local output to local input
+  const Permutation out2in = A.localPerm_.PermutationTo(this->localPerm_).InversePermutation();
+  std::shared_ptr<const CommPackInfo> packInfo = this->RSCommPackInfo(A, reduceModes, commModes);
+  const T* dataBuf = A.LockedBuffer();
+
+  PROFILE_SECTION("RSPack");
+  PEER_PARALLEL_FOR(packInfo->peers.size())
+  for(Unsigned k = 0; k < packInfo->peers.size(); k++){
+    const Unsigned peer = packInfo->peers[k];
+    PackData packData = packInfo->packData[k];
+    packData.dstBufStrides = out2in.applyTo(Dimensions2Strides(blockShapes[peer]));
+    PackCommHelper(packData, &(dataBuf[packInfo->dataBufOffsets[k]]), &(sendBuf[sendDispls[peer]]));
+  }
+  PROFILE_STOP;
+
+  PROFILE_SECTION("RSComm");
+  mpi::ReduceScatter(sendBuf, recvBuf, &(recvCounts[0]), comm);
+  PROFILE_STOP;
+
+  PROFILE_SECTION("RSUnpack");
+  YAxpByData data;
+  data.loopShape = this->LocalShape();
+  data.srcStrides = Dimensions2Strides(this->LocalShape());
+  data.dstStrides = this->LocalStrides();
+  YAxpBy_fast(alpha, beta, &(recvBuf[0]), this->Buffer(), data);
+  PROFILE_STOP;
+
+  this->auxMemory_.Release();
+}
+
 template <typename T>
 void DistTensor<T>::PackRSCommSendBuf(const DistTensor<T>& A, const ModeArray& rModes, const ModeArray& commModes, T * const sendBuf)
 {
-    const Unsigned order = A.Order();
     const T* dataBuf = A.LockedBuffer();
+    const Unsigned nElemsPerProc = prod(this->MaxLocalShape());
 
-    const Location zeros(order, 0);
-    const Location ones(order, 1);
+    std::shared_ptr<const CommPackInfo> packInfo = this->RSCommPackInfo(A, rModes, commModes);
+
+    PEER_PARALLEL_FOR(packInfo->peers.size())
+    for(Unsigned k = 0; k < packInfo->peers.size(); k++){
+        PackCommHelper(packInfo->packData[k], &(dataBuf[packInfo->dataBufOffsets[k]]), &(sendBuf[packInfo->peers[k] * nElemsPerProc]));
+    }
+}
+
+template <typename T>
+std::shared_ptr<const CommPackInfo> DistTensor<T>::RSCommPackInfo(const DistTensor<T>& A, const ModeArray& rModes, const ModeArray& commModes)
+{
+    const ObjShape sendShape = this->MaxLocalShape();
+    const CommPackKey key = this->CommPackKeyFor(RSPack, A, commModes, rModes, sendShape);
+    std::shared_ptr<const CommPackInfo> packInfo = FindCommPackInfo(key);
+    if(packInfo)
+        return packInfo;
+
+    const Unsigned order = A.Order();
 
     //GridView information
     const rote::GridView gvA = A.GetGridView();
@@ -121,13 +243,9 @@ void DistTensor<T>::PackRSCommSendBuf(const DistTensor<T>& A, const ModeArray& r
     for(Unsigned i = 0; i < rModes.size(); i++)
         modeStrideFactor[rModes[i]] = 1;
 
-    const ObjShape sendShape = this->MaxLocalShape();
-    const Unsigned nElemsPerProc = prod(sendShape);
-
     //Grid information
     const rote::Grid& g = this->Grid();
     const ObjShape gridShape = g.Shape();
-    const Location myGridLoc = g.Loc();
 
     const Unsigned nRedistProcsAll = Max(1, prod(FilterVector(gridShape, commModes)));
 
@@ -136,15 +254,23 @@ void DistTensor<T>::PackRSCommSendBuf(const DistTensor<T>& A, const ModeArray& r
     SortVector(sortedCommModes);
     const ObjShape commShape = FilterVector(gridShape, sortedCommModes);
 
-//    PrintData(A, "AData");
-//    PrintData(*this, "thisData");
+    //Pack into permuted form to minimize striding when unpacking
+    const ObjShape finalShape = this->localPerm_.applyTo(sendShape);
+    const std::vector<Unsigned> finalStrides = Dimensions2Strides(finalShape);
+
+    //Determine permutation from local output to local input
+    const Permutation out2in = A.localPerm_.PermutationTo(this->localPerm_).InversePermutation();
+
+    std::vector<char> sendTo(nRedistProcsAll, 0);
+    std::vector<Unsigned> dataBufPtrs(nRedistProcsAll);
+    std::vector<PackData> packDatas(nRedistProcsAll);
+
     //For each process we send to, we need to determine the first element we need to send them
     PARALLEL_FOR
     for(Unsigned i = 0; i < nRedistProcsAll; i++){
         Unsigned j;
         //Invert the process order based on the communicator used, to the actual process location
         Location sortedCommLoc = LinearLoc2Loc(i, commShape);
-//        Location procGridLoc = myGridLoc;
         Location myFirstElemLocA = A.DetermineFirstElem(gvA.ParticipatingLoc());
         Location firstOwnerB = gvB.ToGridLoc(this->Alignments());
         std::vector<Unsigned> alignBinA = g.ToParticipatingGridViewLoc(firstOwnerB, gvA);
@@ -154,41 +280,22 @@ void DistTensor<T>::PackRSCommSendBuf(const DistTensor<T>& A, const ModeArray& r
         for(j = 0; j < sortedCommModes.size(); j++){
             procGridLoc[sortedCommModes[j]] = sortedCommLoc[j];
         }
-//        PrintVector(procGridLoc, "procGridLoc");
-        //This is the first element p_i needs using A's alignment for B.
-        //Note the following 4 work, but accidentally assign a valid firstLoc no matter what.
-//        Location myFirstLoc = A.DetermineFirstElem(A.GetGridView().ParticipatingLoc());
-//        Location myFirstLocUnaligned = ElemwiseMod(ElemwiseSum(ElemwiseSubtract(myFirstLoc, A.Alignments()), A.Shape()), A.Shape());
-//        Location procFirstLoc = DetermineFirstElem(GridLoc2ParticipatingGridViewLoc(procGridLoc, gridShape, TensorDist()));
-//        Location procFirstLocUnaligned = ElemwiseMod(ElemwiseSum(ElemwiseSubtract(procFirstLoc, Alignments()), Shape()), Shape());
 
         //Get my first elem location
         Location myFirstLoc = A.DetermineFirstElem(A.GetGridView().ParticipatingLoc());
 
         //Determine what grid location p_i corresponds to AFTER alignment has been performed
         //so we correctly determine what elements to pack
-//        Location firstElemOwnerA = GridViewLoc2GridLoc(A.Alignments(), gvA);
-//        Location firstElemOwnerB = GridViewLoc2GridLoc(Alignments(), gvB);
-//        Location alignDiff = ElemwiseSubtract(firstElemOwnerB, firstElemOwnerA);
-//        Location procLocAfterRealign = ElemwiseMod(ElemwiseSum(ElemwiseSum(procGridLoc, alignDiff), g.Shape()), g.Shape());
         Location procFirstLoc = this->DetermineFirstElem(g.ToParticipatingGridViewLoc(procGridLoc, gvB));
 
-        //Determine the first element I need to send to p_i
-        //The first element I own is
-//        Location myFirstLoc = A.DetermineFirstElem(A.GetGridView().ParticipatingLoc());
-
         //Iterate to figure out the first elem I need to send p_i
         Location firstSendLoc = myFirstLoc;
 
-//        PrintVector(myFirstLoc, "myFirstLoc");
-//        PrintVector(adjustedProcFirstElemLoc, "adjustedProcFirstElemLoc");
-
         bool found = true;
         for(j = 0; j < nonRModes.size(); j++){
             Mode nonRMode = nonRModes[j];
             Unsigned myFirstIndex = myFirstLoc[nonRMode];
             Unsigned sendFirstIndex = procFirstLoc[nonRMode];
-//            Unsigned sendFirstIndex = adjustedProcFirstElemLoc[nonRMode];
             Unsigned myModeStride = A.ModeStride(nonRMode);
             Unsigned sendProcModeStride = this->ModeStride(nonRMode);
 
@@ -205,44 +312,36 @@ void DistTensor<T>::PackRSCommSendBuf(const DistTensor<T>& A, const ModeArray& r
             firstSendLoc[nonRMode] = myFirstIndex;
         }
 
-//        if(found)
-//            PrintVector(firstSendLoc, "haha sending first loc");
-//        else
-//            PrintVector(firstSendLoc, "nope sending first loc");
-
-        //Convert this value back to a Global Loc I own.
-//        Location actualFirstSendLoc = ElemwiseMod(ElemwiseSum(firstSendLoc, A.Alignments()), A.Shape());
-
         //Check this is a valid location to pack
         Location firstRecvLoc = firstSendLoc;
         for(j = 0; j < rModes.size(); j++)
             firstRecvLoc[rModes[j]] = 0;
 
-        //Pack the data if we need to send data to p_i
+        //Record how to pack the data if we need to send data to p_i
         if(found && ElemwiseLessThan(firstRecvLoc, this->Shape()) && ElemwiseLessThan(firstSendLoc, A.Shape())){
             //Determine where the initial piece of data is located.
             const Location localLoc = A.Global2LocalIndex(firstSendLoc);
-//            PrintVector(localLoc, "localLoc");
-            Unsigned dataBufPtr = LinearLocFromStrides(A.localPerm_.applyTo(localLoc), A.LocalStrides());
+            dataBufPtrs[i] = LinearLocFromStrides(A.localPerm_.applyTo(localLoc), A.LocalStrides());
 
-            PackData packData;
+            PackData& packData = packDatas[i];
             packData.loopShape = MaxLengths(ElemwiseSubtract(A.LocalShape(), A.localPerm_.applyTo(localLoc)), A.localPerm_.applyTo(modeStrideFactor));
             packData.srcBufStrides = ElemwiseProd(A.LocalStrides(), A.localPerm_.applyTo(modeStrideFactor));
 
-            //Pack into permuted form to minimize striding when unpacking
-            ObjShape finalShape = this->localPerm_.applyTo(sendShape);
-            std::vector<Unsigned> finalStrides = Dimensions2Strides(finalShape);
-
-            //Determine permutation from local output to local input
-            Permutation out2in = A.localPerm_.PermutationTo(this->localPerm_).InversePermutation();
-
             //Permute pack strides to match input local permutation (for correct packing)
             packData.dstBufStrides = out2in.applyTo(finalStrides);
+            sendTo[i] = 1;
+        }
+    }
 
-//            PrintPackData(packData, "rsPackData");
-            PackCommHelper(packData, &(dataBuf[dataBufPtr]), &(sendBuf[i * nElemsPerProc]));
+    CommPackInfo info;
+    for(Unsigned i = 0; i < nRedistProcsAll; i++){
+        if(sendTo[i]){
+            info.peers.push_back(i);
+            info.dataBufOffsets.push_back(dataBufPtrs[i]);
+            info.packData.push_back(packDatas[i]);
         }
     }
+    return StoreCommPackInfo(key, info);
 }
 
 template <typename T>
@@ -18,10 +18,10 @@ namespace rote{
 
 template<typename T>
 void
-DistTensor<T>::ReduceScatterUpdateRedistFrom(const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& rModes)
+DistTensor<T>::ReduceScatterUpdateRedistFrom(const T alpha, const DistTensor<T>& A, const T beta, const ModeArray& rModes, RedistRequest<T>* request)
 {
     PROFILE_SECTION("RSRedist");
-    ReduceUpdateRedistFrom(RS, alpha, A, beta, rModes);
+    ReduceUpdateRedistFrom(RS, alpha, A, beta, rModes, request);
     PROFILE_STOP;
 }
 
@@ -23,6 +23,17 @@ double minRealWindowVal, maxRealWindowVal,
        minImagWindowVal, maxImagWindowVal;
 #endif
 std::stack<rote::Int> blocksizeStack;
+bool contractPipelining = false;
+bool contractAutotuning = false;
+std::string contractTuningFile;
+std::size_t contractMemoryLimit = 0;
+double contractFlopTime = 1e-10;
+rote::CommCostModel commCostModel = {2e-6, 1e-9, 2.5e-10};
+double commPaddingThreshold = 0.25;
+rote::Unsigned redistPlanSearchLimit = 4096;
+rote::Unsigned zeroCopyRedistThreshold = 1 << 18;
+std::stack<std::size_t> redistMemoryLimitStack;
+std::size_t redistResultCacheLimit = 0;
 rote::Grid* defaultGrid = 0;
 rote::mpi::CommMap* defaultCommMap = 0;
 rote::Args* args = 0;
@@ -144,6 +155,11 @@ void Initialize( int& argc, char**& argv )
         ::blocksizeStack.pop();
     ::blocksizeStack.push( 128 );
 
+    // No limit on redistribution memory by default
+    while( ! ::redistMemoryLimitStack.empty() )
+        ::redistMemoryLimitStack.pop();
+    ::redistMemoryLimitStack.push( 0 );
+
     // Build the default grid
     //defaultGrid = new Grid( mpi::COMM_WORLD );
     defaultCommMap = new mpi::CommMap();
@@ -164,6 +180,9 @@ void Initialize( int& argc, char**& argv )
     mpi::CreateMaxLocPairOp<float>();
     mpi::CreateMaxLocPairOp<double>();
 
+    // Load a calibrated communication model only if ROTE_COMM_MODEL names one
+    LoadCommModelFromEnv();
+
     // Seed the random number generators using Katzgrabber's approach
     // from "Random Numbers in Scientific Computing: An Introduction"
     // NOTE: srand no longer needed after C++11
@@ -187,6 +206,9 @@ void Finalize()
     }
     if( ::numElemInits == 0 )
     {
+        ClearRedistCache();
+        Workspace::Trim();
+
         delete ::args;
         ::args = 0;
 
@@ -221,6 +243,8 @@ void Finalize()
         ::defaultCommMap = 0;
         while( ! ::blocksizeStack.empty() )
             ::blocksizeStack.pop();
+        while( ! ::redistMemoryLimitStack.empty() )
+            ::redistMemoryLimitStack.pop();
     }
 }
 
@@ -237,6 +261,97 @@ Int Blocksize()
 void SetBlocksize( Int blocksize )
 { ::blocksizeStack.top() = blocksize; }
 
+bool ContractPipelining()
+{ return ::contractPipelining; }
+
+void SetContractPipelining( bool pipeline )
+{ ::contractPipelining = pipeline; }
+
+bool ContractAutotuning()
+{ return ::contractAutotuning; }
+
+void SetContractAutotuning( bool autotune )
+{ ::contractAutotuning = autotune; }
+
+const std::string& ContractTuningFile()
+{ return ::contractTuningFile; }
+
+void SetContractTuningFile( const std::string& filename )
+{
+    ::contractTuningFile = filename;
+    ClearContractTuning();
+}
+
+std::size_t ContractMemoryLimit()
+{ return ::contractMemoryLimit; }
+
+void SetContractMemoryLimit( std::size_t bytes )
+{ ::contractMemoryLimit = bytes; }
+
+double ContractFlopTime()
+{ return ::contractFlopTime; }
+
+void SetContractFlopTime( double seconds )
+{ ::contractFlopTime = seconds; }
+
+const CommCostModel& GetCommCostModel()
+{ return ::commCostModel; }
+
+void SetCommCostModel( const CommCostModel& model )
+{
+    ::commCostModel = model;
+    ClearRedistCache();
+}
+
+double CommPaddingThreshold()
+{ return ::commPaddingThreshold; }
+
+void SetCommPaddingThreshold( double threshold )
+{
+    ::commPaddingThreshold = threshold;
+    ClearRedistCache();
+}
+
+Unsigned RedistPlanSearchLimit()
+{ return ::redistPlanSearchLimit; }
+
+void SetRedistPlanSearchLimit( Unsigned limit )
+{
+    ::redistPlanSearchLimit = limit;
+    ClearRedistCache();
+}
+
+Unsigned ZeroCopyRedistThreshold()
+{ return ::zeroCopyRedistThreshold; }
+
+void SetZeroCopyRedistThreshold( Unsigned threshold )
+{ ::zeroCopyRedistThreshold = threshold; }
+
+std::size_t RedistMemoryLimit()
+{ return ::redistMemoryLimitStack.top(); }
+
+void SetRedistMemoryLimit( std::size_t bytes )
+{ ::redistMemoryLimitStack.top() = bytes; }
+
+void PushRedistMemoryLimit( std::size_t bytes )
+{ ::redistMemoryLimitStack.push( bytes ); }
+
+void PopRedistMemoryLimit()
+{
+    if( ::redistMemoryLimitStack.size() <= 1 )
+        LogicError("Popped more redistribution memory limits than pushed");
+    ::redistMemoryLimitStack.pop();
+}
+
+std::size_t RedistResultCacheLimit()
+{ return ::redistResultCacheLimit; }
+
+void SetRedistResultCacheLimit( std::size_t bytes )
+{
+    ::redistResultCacheLimit = bytes;
+    ClearRedistResults();
+}
+
 ModeArray OrderedModes(Unsigned order)
 {
     Unsigned i;
@@ -39,6 +39,8 @@ namespace rote {
   Grid::Grid( mpi::Comm comm, const ObjShape& shape )
   {
       inGrid_ = true; // this is true by assumption for this constructor
+      nodeAware_ = false;
+      ranksPerNode_ = 0;
 
       mpi::CommDup(comm, owningComm_);
 
@@ -85,6 +87,7 @@ namespace rote {
 
   Grid::~Grid()
   {
+      FreeNodeComms();
       if( !mpi::Finalized() )
       {
           if( inGrid_ )
@@ -154,6 +157,39 @@ namespace rote {
   Grid::OwningComm() const
   { return owningComm_; }
 
+  void
+  Grid::SetNodeAwareCollectives( bool enable, Unsigned ranksPerNode )
+  {
+      if( enable != nodeAware_ || ranksPerNode != ranksPerNode_ )
+          FreeNodeComms();
+      nodeAware_ = enable;
+      ranksPerNode_ = ranksPerNode;
+  }
+
+  bool
+  Grid::NodeAwareCollectives() const
+  { return nodeAware_; }
+
+  NodeComm&
+  Grid::NodeAwareComm( const ModeArray& commModes, mpi::Comm comm ) const
+  {
+      ModeArray sortedCommModes = commModes;
+      SortVector(sortedCommModes);
+      std::map<ModeArray, NodeComm*>::iterator it = nodeComms_.find(sortedCommModes);
+      if( it == nodeComms_.end() )
+          it = nodeComms_.insert(std::make_pair(sortedCommModes, new NodeComm(comm, ranksPerNode_))).first;
+      return *(it->second);
+  }
+
+  void
+  Grid::FreeNodeComms()
+  {
+      std::map<ModeArray, NodeComm*>::iterator it;
+      for( it = nodeComms_.begin(); it != nodeComms_.end(); it++ )
+          delete it->second;
+      nodeComms_.clear();
+  }
+
   //
   // Comparison functions
   //
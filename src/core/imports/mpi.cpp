@@ -91,6 +91,33 @@ void OpFree( Op& op )
     SafeMpi( MPI_Op_free( &op ) );
 }
 
+void TypeCreateHVector
+( int count, int blockLength, Aint stride, Datatype oldType, Datatype& newType )
+{
+    SafeMpi
+    ( MPI_Type_create_hvector( count, blockLength, stride, oldType, &newType ) );
+}
+
+void TypeCreateHIndexed
+( int count, const int* blockLengths, const Aint* displs, Datatype oldType,
+  Datatype& newType )
+{
+    SafeMpi
+    ( MPI_Type_create_hindexed
+      ( count, const_cast<int*>(blockLengths), const_cast<Aint*>(displs),
+        oldType, &newType ) );
+}
+
+void TypeCommit( Datatype& type )
+{
+    SafeMpi( MPI_Type_commit( &type ) );
+}
+
+void TypeFree( Datatype& type )
+{
+    SafeMpi( MPI_Type_free( &type ) );
+}
+
 //---------------------------//
 // Communicator manipulation //
 //---------------------------//
@@ -131,11 +158,57 @@ void CommSplit( Comm comm, int color, int key, Comm& newComm )
     SafeMpi( MPI_Comm_split( comm, color, key, &newComm ) );
 }
 
+void CommSplitShared( Comm comm, int key, Comm& newComm )
+{
+    SafeMpi
+    ( MPI_Comm_split_type
+      ( comm, MPI_COMM_TYPE_SHARED, key, MPI_INFO_NULL, &newComm ) );
+}
+
 void CommFree( Comm& comm )
 {
     SafeMpi( MPI_Comm_free( &comm ) );
 }
 
+//--------------------------------//
+// Shared-memory window routines  //
+//--------------------------------//
+
+void WinAllocateShared
+( Aint size, int dispUnit, Comm comm, void* baseptr, Win& win )
+{
+    SafeMpi
+    ( MPI_Win_allocate_shared
+      ( size, dispUnit, MPI_INFO_NULL, comm, baseptr, &win ) );
+}
+
+void WinSharedQuery( Win win, int rank, void* baseptr )
+{
+    Aint size;
+    int dispUnit;
+    SafeMpi( MPI_Win_shared_query( win, rank, &size, &dispUnit, baseptr ) );
+}
+
+void WinLockAll( Win win )
+{
+    SafeMpi( MPI_Win_lock_all( MPI_MODE_NOCHECK, win ) );
+}
+
+void WinUnlockAll( Win win )
+{
+    SafeMpi( MPI_Win_unlock_all( win ) );
+}
+
+void WinSync( Win win )
+{
+    SafeMpi( MPI_Win_sync( win ) );
+}
+
+void WinFree( Win& win )
+{
+    SafeMpi( MPI_Win_free( &win ) );
+}
+
 bool CongruentComms( Comm comm1, Comm comm2 )
 {
     int result;
@@ -1037,7 +1110,7 @@ template void Broadcast( std::complex<double>& b, int root, Comm comm );
 template<typename R>
 void IBroadcast( R* buf, int count, int root, Comm comm, Request& request )
 {
-    SafeMpi( MPI_Ibcast( buf, count, TypeMap<R>(), root, comm, &request ) );
+    SafeMpi( NONBLOCKING_COLL(Ibcast)( buf, count, TypeMap<R>(), root, comm, &request ) );
 }
 
 template<typename R>
@@ -1046,10 +1119,10 @@ void IBroadcast
 {
 #ifdef AVOID_COMPLEX_MPI
     SafeMpi
-    ( MPI_Ibcast( buf, 2*count, TypeMap<R>(), root, comm, &request ) );
+    ( NONBLOCKING_COLL(Ibcast)( buf, 2*count, TypeMap<R>(), root, comm, &request ) );
 #else
     SafeMpi
-    ( MPI_Ibcast
+    ( NONBLOCKING_COLL(Ibcast)
       ( buf, count, TypeMap<std::complex<R> >(), root, comm, &request ) );
 #endif
 }
@@ -1138,7 +1211,7 @@ void IGather
         R* rbuf, int rc, int root, Comm comm, Request& request )
 {
     SafeMpi
-    ( MPI_Igather
+    ( NONBLOCKING_COLL(Igather)
       ( const_cast<R*>(sbuf), sc, TypeMap<R>(),
         rbuf,                 rc, TypeMap<R>(), root, comm, &request ) );
 }
@@ -1150,13 +1223,13 @@ void IGather
 {
 #ifdef AVOID_COMPLEX_MPI
     SafeMpi
-    ( MPI_Igather
+    ( NONBLOCKING_COLL(Igather)
       ( const_cast<std::complex<R>*>(sbuf), 2*sc, TypeMap<R>(),
         rbuf,                          2*rc, TypeMap<R>(),
         root, comm, &request ) );
 #else
     SafeMpi
-    ( MPI_Igather
+    ( NONBLOCKING_COLL(Igather)
       ( const_cast<std::complex<R>*>(sbuf), sc, TypeMap<std::complex<R> >(),
         rbuf,                          rc, TypeMap<std::complex<R> >(),
         root, comm, &request ) );
@@ -1353,6 +1426,51 @@ template void AllGather( const double* sbuf, int sc, double* rbuf, int rc, Comm
 template void AllGather( const std::complex<float>* sbuf, int sc, std::complex<float>* rbuf, int rc, Comm comm );
 template void AllGather( const std::complex<double>* sbuf, int sc, std::complex<double>* rbuf, int rc, Comm comm );
 
+#ifdef HAVE_NONBLOCKING_COLLECTIVES
+template<typename R>
+void IAllGather
+( const R* sbuf, int sc,
+        R* rbuf, int rc, Comm comm, Request& request )
+{
+    SafeMpi
+    ( NONBLOCKING_COLL(Iallgather)
+      ( const_cast<R*>(sbuf), sc, TypeMap<R>(),
+        rbuf,                 rc, TypeMap<R>(), comm, &request ) );
+}
+
+template<typename R>
+void IAllGather
+( const std::complex<R>* sbuf, int sc,
+        std::complex<R>* rbuf, int rc, Comm comm, Request& request )
+{
+#ifdef AVOID_COMPLEX_MPI
+    SafeMpi
+    ( NONBLOCKING_COLL(Iallgather)
+      ( const_cast<std::complex<R>*>(sbuf), 2*sc, TypeMap<R>(),
+        rbuf,                          2*rc, TypeMap<R>(), comm, &request ) );
+#else
+    SafeMpi
+    ( NONBLOCKING_COLL(Iallgather)
+      ( const_cast<std::complex<R>*>(sbuf), sc, TypeMap<std::complex<R> >(),
+        rbuf,                          rc, TypeMap<std::complex<R> >(), comm, &request ) );
+#endif
+}
+
+template void IAllGather( const byte* sbuf, int sc, byte* rbuf, int rc, Comm comm, Request& request );
+template void IAllGather( const int* sbuf, int sc, int* rbuf, int rc, Comm comm, Request& request );
+template void IAllGather( const unsigned* sbuf, int sc, unsigned* rbuf, int rc, Comm comm, Request& request );
+template void IAllGather( const long int* sbuf, int sc, long int* rbuf, int rc, Comm comm, Request& request );
+template void IAllGather( const unsigned long* sbuf, int sc, unsigned long* rbuf, int rc, Comm comm, Request& request );
+#ifdef HAVE_MPI_LONG_LONG
+template void IAllGather( const long long int* sbuf, int sc, long long int* rbuf, int rc, Comm comm, Request& request );
+template void IAllGather( const unsigned long long* sbuf, int sc, unsigned long long* rbuf, int rc, Comm comm, Request& request );
+#endif
+template void IAllGather( const float* sbuf, int sc, float* rbuf, int rc, Comm comm, Request& request );
+template void IAllGather( const double* sbuf, int sc, double* rbuf, int rc, Comm comm, Request& request );
+template void IAllGather( const std::complex<float>* sbuf, int sc, std::complex<float>* rbuf, int rc, Comm comm, Request& request );
+template void IAllGather( const std::complex<double>* sbuf, int sc, std::complex<double>* rbuf, int rc, Comm comm, Request& request );
+#endif // ifdef HAVE_NONBLOCKING_COLLECTIVES
+
 template<typename R>
 void AllGather
 ( const R* sbuf, int sc,
@@ -1694,6 +1812,51 @@ template void AllToAll
 ( const std::complex<double>* sbuf, int sc,
         std::complex<double>* rbuf, int rc, Comm comm );
 
+#ifdef HAVE_NONBLOCKING_COLLECTIVES
+template<typename R>
+void IAllToAll
+( const R* sbuf, int sc,
+        R* rbuf, int rc, Comm comm, Request& request )
+{
+    SafeMpi
+    ( NONBLOCKING_COLL(Ialltoall)
+      ( const_cast<R*>(sbuf), sc, TypeMap<R>(),
+        rbuf,                 rc, TypeMap<R>(), comm, &request ) );
+}
+
+template<typename R>
+void IAllToAll
+( const std::complex<R>* sbuf, int sc,
+        std::complex<R>* rbuf, int rc, Comm comm, Request& request )
+{
+#ifdef AVOID_COMPLEX_MPI
+    SafeMpi
+    ( NONBLOCKING_COLL(Ialltoall)
+      ( const_cast<std::complex<R>*>(sbuf), 2*sc, TypeMap<R>(),
+        rbuf,                          2*rc, TypeMap<R>(), comm, &request ) );
+#else
+    SafeMpi
+    ( NONBLOCKING_COLL(Ialltoall)
+      ( const_cast<std::complex<R>*>(sbuf), sc, TypeMap<std::complex<R> >(),
+        rbuf,                          rc, TypeMap<std::complex<R> >(), comm, &request ) );
+#endif
+}
+
+template void IAllToAll( const byte* sbuf, int sc, byte* rbuf, int rc, Comm comm, Request& request );
+template void IAllToAll( const int* sbuf, int sc, int* rbuf, int rc, Comm comm, Request& request );
+template void IAllToAll( const unsigned* sbuf, int sc, unsigned* rbuf, int rc, Comm comm, Request& request );
+template void IAllToAll( const long int* sbuf, int sc, long int* rbuf, int rc, Comm comm, Request& request );
+template void IAllToAll( const unsigned long* sbuf, int sc, unsigned long* rbuf, int rc, Comm comm, Request& request );
+#ifdef HAVE_MPI_LONG_LONG
+template void IAllToAll( const long long int* sbuf, int sc, long long int* rbuf, int rc, Comm comm, Request& request );
+template void IAllToAll( const unsigned long long* sbuf, int sc, unsigned long long* rbuf, int rc, Comm comm, Request& request );
+#endif
+template void IAllToAll( const float* sbuf, int sc, float* rbuf, int rc, Comm comm, Request& request );
+template void IAllToAll( const double* sbuf, int sc, double* rbuf, int rc, Comm comm, Request& request );
+template void IAllToAll( const std::complex<float>* sbuf, int sc, std::complex<float>* rbuf, int rc, Comm comm, Request& request );
+template void IAllToAll( const std::complex<double>* sbuf, int sc, std::complex<double>* rbuf, int rc, Comm comm, Request& request );
+#endif // ifdef HAVE_NONBLOCKING_COLLECTIVES
+
 template<typename R>
 void AllToAll
 ( const R* sbuf, const int* scs, const int* sds,
@@ -1788,6 +1951,22 @@ template void AllToAll
 ( const std::complex<double>* sbuf, const int* scs, const int* sds,
         std::complex<double>* rbuf, const int* rcs, const int* rds, Comm comm );
 
+void AllToAll
+( const void* sbuf, const int* scs, const int* sds, const Datatype* sts,
+        void* rbuf, const int* rcs, const int* rds, const Datatype* rts,
+  Comm comm )
+{
+    SafeMpi
+    ( MPI_Alltoallw
+      ( const_cast<void*>(sbuf),
+        const_cast<int*>(scs), const_cast<int*>(sds),
+        const_cast<Datatype*>(sts),
+        rbuf,
+        const_cast<int*>(rcs), const_cast<int*>(rds),
+        const_cast<Datatype*>(rts),
+        comm ) );
+}
+
 template<typename T>
 void Reduce
 ( const T* sbuf, T* rbuf, int count, Op op, int root, Comm comm )
@@ -2403,6 +2582,63 @@ template void ReduceScatter( double* sbuf, double* rbuf, int rc, Comm comm );
 template void ReduceScatter( std::complex<float>* sbuf, std::complex<float>* rbuf, int rc, Comm comm );
 template void ReduceScatter( std::complex<double>* sbuf, std::complex<double>* rbuf, int rc, Comm comm );
 
+#ifdef HAVE_NONBLOCKING_COLLECTIVES
+template<typename R>
+void IReduceScatter( R* sbuf, R* rbuf, int rc, Op op, Comm comm, Request& request )
+{
+    SafeMpi
+    ( NONBLOCKING_COLL(Ireduce_scatter_block)
+      ( sbuf, rbuf, rc, TypeMap<R>(), op, comm, &request ) );
+}
+
+template<typename R>
+void IReduceScatter
+( std::complex<R>* sbuf, std::complex<R>* rbuf, int rc, Op op, Comm comm, Request& request )
+{
+#ifdef AVOID_COMPLEX_MPI
+    SafeMpi
+    ( NONBLOCKING_COLL(Ireduce_scatter_block)
+      ( sbuf, rbuf, 2*rc, TypeMap<R>(), op, comm, &request ) );
+#else
+    SafeMpi
+    ( NONBLOCKING_COLL(Ireduce_scatter_block)
+      ( sbuf, rbuf, rc, TypeMap<std::complex<R> >(), op, comm, &request ) );
+#endif
+}
+
+template void IReduceScatter( byte* sbuf, byte* rbuf, int rc, Op op, Comm comm, Request& request );
+template void IReduceScatter( int* sbuf, int* rbuf, int rc, Op op, Comm comm, Request& request );
+template void IReduceScatter( unsigned* sbuf, unsigned* rbuf, int rc, Op op, Comm comm, Request& request );
+template void IReduceScatter( long int* sbuf, long int* rbuf, int rc, Op op, Comm comm, Request& request );
+template void IReduceScatter( unsigned long* sbuf, unsigned long* rbuf, int rc, Op op, Comm comm, Request& request );
+#ifdef HAVE_MPI_LONG_LONG
+template void IReduceScatter( long long int* sbuf, long long int* rbuf, int rc, Op op, Comm comm, Request& request );
+template void IReduceScatter( unsigned long long* sbuf, unsigned long long* rbuf, int rc, Op op, Comm comm, Request& request );
+#endif
+template void IReduceScatter( float* sbuf, float* rbuf, int rc, Op op, Comm comm, Request& request );
+template void IReduceScatter( double* sbuf, double* rbuf, int rc, Op op, Comm comm, Request& request );
+template void IReduceScatter( std::complex<float>* sbuf, std::complex<float>* rbuf, int rc, Op op, Comm comm, Request& request );
+template void IReduceScatter( std::complex<double>* sbuf, std::complex<double>* rbuf, int rc, Op op, Comm comm, Request& request );
+
+template<typename T>
+void IReduceScatter( T* sbuf, T* rbuf, int rc, Comm comm, Request& request )
+{ IReduceScatter( sbuf, rbuf, rc, mpi::SUM, comm, request ); }
+
+template void IReduceScatter( byte* sbuf, byte* rbuf, int rc, Comm comm, Request& request );
+template void IReduceScatter( int* sbuf, int* rbuf, int rc, Comm comm, Request& request );
+template void IReduceScatter( unsigned* sbuf, unsigned* rbuf, int rc, Comm comm, Request& request );
+template void IReduceScatter( long int* sbuf, long int* rbuf, int rc, Comm comm, Request& request );
+template void IReduceScatter( unsigned long* sbuf, unsigned long* rbuf, int rc, Comm comm, Request& request );
+#ifdef HAVE_MPI_LONG_LONG
+template void IReduceScatter( long long int* sbuf, long long int* rbuf, int rc, Comm comm, Request& request );
+template void IReduceScatter( unsigned long long* sbuf, unsigned long long* rbuf, int rc, Comm comm, Request& request );
+#endif
+template void IReduceScatter( float* sbuf, float* rbuf, int rc, Comm comm, Request& request );
+template void IReduceScatter( double* sbuf, double* rbuf, int rc, Comm comm, Request& request );
+template void IReduceScatter( std::complex<float>* sbuf, std::complex<float>* rbuf, int rc, Comm comm, Request& request );
+template void IReduceScatter( std::complex<double>* sbuf, std::complex<double>* rbuf, int rc, Comm comm, Request& request );
+#endif // ifdef HAVE_NONBLOCKING_COLLECTIVES
+
 template<typename T>
 T ReduceScatter( T sb, Op op, Comm comm )
 { T rb; ReduceScatter( &sb, &rb, 1, op, comm ); return rb; }
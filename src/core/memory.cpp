@@ -7,9 +7,166 @@
    http://opensource.org/licenses/BSD-2-Clause
 */
 #include "rote.hpp"
+#include <mutex>
+
+namespace {
+
+// Free buffers by size class.  Buffers may be acquired and returned from
+// inside OpenMP regions, so every access holds poolMutex.
+std::map<std::size_t, std::vector<rote::byte*> > freeLists;
+std::size_t retainLimit = rote::Workspace::HighWaterMark;
+std::size_t inUseHighWater = 0;
+rote::WorkspaceStats stats = {0, 0, 0, 0, 0};
+std::mutex poolMutex;
+
+// Frees every retained buffer; poolMutex must be held
+void TrimFreeLists()
+{
+    std::map<std::size_t, std::vector<rote::byte*> >::iterator it;
+    for( it = freeLists.begin(); it != freeLists.end(); it++ )
+        for( std::size_t i = 0; i < it->second.size(); i++ )
+            ::operator delete( it->second[i] );
+    freeLists.clear();
+    stats.retainedBytes = 0;
+}
+
+// The bytes returned buffers may be kept up to; poolMutex must be held
+std::size_t RetainedBytesLimit()
+{
+    return retainLimit == rote::Workspace::HighWaterMark ? inUseHighWater
+                                                         : retainLimit;
+}
+
+// Rounds up to a multiple of a quarter of the largest power of two not
+// above bytes, so no request is padded by more than 25%
+std::size_t SizeClass( std::size_t bytes )
+{
+    const std::size_t minClass = 256;
+    if( bytes <= minClass )
+        return minClass;
+
+    std::size_t pow2 = minClass;
+    while( pow2 <= bytes / 2 )
+        pow2 *= 2;
+    const std::size_t step = pow2 / 4;
+    return ((bytes + step - 1) / step) * step;
+}
+
+} // anonymous namespace
 
 namespace rote {
 
+  const std::size_t Workspace::HighWaterMark;
+
+  byte*
+  Workspace::Acquire( std::size_t bytes, std::size_t& grantedBytes )
+  {
+      const std::size_t sizeClass = ::SizeClass( bytes );
+
+      // Reuse a retained buffer unless it is more than twice as large
+      {
+          std::lock_guard<std::mutex> lock( ::poolMutex );
+          std::map<std::size_t, std::vector<byte*> >::iterator it =
+            ::freeLists.lower_bound( sizeClass );
+          if( it != ::freeLists.end() && it->first <= 2*sizeClass )
+          {
+              byte* buffer = it->second.back();
+              grantedBytes = it->first;
+              it->second.pop_back();
+              if( it->second.empty() )
+                  ::freeLists.erase( it );
+
+              ::stats.hits++;
+              ::stats.retainedBytes -= grantedBytes;
+              ::stats.inUseBytes += grantedBytes;
+              ::inUseHighWater = std::max( ::inUseHighWater, ::stats.inUseBytes );
+              return buffer;
+          }
+      }
+
+      byte* buffer;
+  #ifndef RELEASE
+      try {
+  #endif
+      buffer = static_cast<byte*>( ::operator new( sizeClass ) );
+  #ifndef RELEASE
+      }
+      catch( std::bad_alloc& e )
+      {
+          std::ostringstream os;
+          os << "Failed to allocate " << sizeClass
+             << " bytes on process " << mpi::WorldRank() << std::endl;
+          std::cerr << os.str();
+          throw e;
+      }
+  #endif
+      grantedBytes = sizeClass;
+
+      std::lock_guard<std::mutex> lock( ::poolMutex );
+      ::stats.misses++;
+      ::stats.inUseBytes += grantedBytes;
+      ::inUseHighWater = std::max( ::inUseHighWater, ::stats.inUseBytes );
+      ::stats.peakBytes =
+        std::max( ::stats.peakBytes, ::stats.inUseBytes + ::stats.retainedBytes );
+      return buffer;
+  }
+
+  void
+  Workspace::Return( byte* buffer, std::size_t grantedBytes )
+  {
+      if( buffer == 0 )
+          return;
+
+      std::lock_guard<std::mutex> lock( ::poolMutex );
+      ::stats.inUseBytes -= grantedBytes;
+      if( ::stats.retainedBytes + grantedBytes > ::RetainedBytesLimit() )
+      {
+          ::operator delete( buffer );
+          return;
+      }
+      ::freeLists[grantedBytes].push_back( buffer );
+      ::stats.retainedBytes += grantedBytes;
+  }
+
+  void
+  Workspace::Trim()
+  {
+      std::lock_guard<std::mutex> lock( ::poolMutex );
+      ::TrimFreeLists();
+  }
+
+  std::size_t
+  Workspace::RetainLimit()
+  {
+      std::lock_guard<std::mutex> lock( ::poolMutex );
+      return ::RetainedBytesLimit();
+  }
+
+  void
+  Workspace::SetRetainLimit( std::size_t bytes )
+  {
+      std::lock_guard<std::mutex> lock( ::poolMutex );
+      ::retainLimit = bytes;
+      if( ::stats.retainedBytes > ::RetainedBytesLimit() )
+          ::TrimFreeLists();
+  }
+
+  WorkspaceStats
+  Workspace::Stats()
+  {
+      std::lock_guard<std::mutex> lock( ::poolMutex );
+      return ::stats;
+  }
+
+  void
+  Workspace::ResetStats()
+  {
+      std::lock_guard<std::mutex> lock( ::poolMutex );
+      ::stats.hits = 0;
+      ::stats.misses = 0;
+      ::stats.peakBytes = ::stats.inUseBytes + ::stats.retainedBytes;
+  }
+
   template<typename G>
   Memory<G>::Memory()
   : size_(0), buffer_(0)
@@ -30,7 +187,7 @@ namespace rote {
 
   template<typename G>
   Memory<G>::~Memory()
-  { delete[] buffer_; }
+  { Empty(); }
 
   template<typename G>
   G*
@@ -48,23 +205,11 @@ namespace rote {
   {
       if( size > size_ )
       {
-          delete[] buffer_;
-  #ifndef RELEASE
-          try {
-  #endif
-          buffer_ = new G[size];
-  #ifndef RELEASE
-          }
-          catch( std::bad_alloc& e )
-          {
-              std::ostringstream os;
-              os << "Failed to allocate " << size*sizeof(G)
-                 << " bytes on process " << mpi::WorldRank() << std::endl;
-              std::cerr << os.str();
-              throw e;
-          }
-  #endif
-          size_ = size;
+          Empty();
+          std::size_t grantedBytes;
+          buffer_ = reinterpret_cast<G*>
+            ( Workspace::Acquire( size*sizeof(G), grantedBytes ) );
+          size_ = grantedBytes / sizeof(G);
       }
       return buffer_;
   }
@@ -82,7 +227,7 @@ namespace rote {
   void
   Memory<G>::Empty()
   {
-      delete[] buffer_;
+      Workspace::Return( reinterpret_cast<byte*>(buffer_), size_*sizeof(G) );
       size_ = 0;
       buffer_ = 0;
   }
@@ -0,0 +1,251 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+
+#include "rote.hpp"
+#include <limits>
+
+namespace rote {
+
+NodeComm::NodeComm( mpi::Comm comm, Unsigned ranksPerNode )
+: segment_(0), segmentBytes_(0)
+{
+    mpi::CommDup(comm, comm_);
+    rank_ = mpi::CommRank(comm_);
+    const int p = mpi::CommSize(comm_);
+
+    mpi::CommSplitShared(comm_, rank_, nodeComm_);
+    if(ranksPerNode > 0){
+        mpi::Comm emulatedComm;
+        mpi::CommSplit(nodeComm_, mpi::WorldRank() / ranksPerNode, rank_, emulatedComm);
+        mpi::CommFree(nodeComm_);
+        nodeComm_ = emulatedComm;
+    }
+    nodeRank_ = mpi::CommRank(nodeComm_);
+    nodeSize_ = mpi::CommSize(nodeComm_);
+
+    // Leaders are ordered by their rank in comm_, which numbers the nodes
+    mpi::CommSplit(comm_, nodeRank_ == 0 ? 0 : mpi::UNDEFINED, rank_, leaderComm_);
+    node_ = nodeRank_ == 0 ? mpi::CommRank(leaderComm_) : 0;
+    mpi::Broadcast(node_, 0, nodeComm_);
+
+    int mine[2] = {node_, nodeRank_};
+    std::vector<int> all(2 * p);
+    mpi::AllGather(&(mine[0]), 2, &(all[0]), 2, comm_);
+
+    nodeOf_.resize(p);
+    localRankOf_.resize(p);
+    int numNodes = 0;
+    for(int r = 0; r < p; r++){
+        nodeOf_[r] = all[2*r];
+        localRankOf_[r] = all[2*r + 1];
+        numNodes = std::max(numNodes, nodeOf_[r] + 1);
+    }
+
+    nodeSizes_.assign(numNodes, 0);
+    for(int r = 0; r < p; r++)
+        nodeSizes_[nodeOf_[r]]++;
+    nodeOffsets_.assign(numNodes, 0);
+    for(int J = 1; J < numNodes; J++)
+        nodeOffsets_[J] = nodeOffsets_[J-1] + nodeSizes_[J-1];
+
+    pos_.resize(p);
+    for(int r = 0; r < p; r++)
+        pos_[r] = nodeOffsets_[nodeOf_[r]] + localRankOf_[r];
+}
+
+NodeComm::~NodeComm()
+{
+    if(mpi::Finalized())
+        return;
+    if(segment_ != 0){
+        mpi::WinUnlockAll(win_);
+        mpi::WinFree(win_);
+    }
+    if(leaderComm_ != mpi::COMM_NULL)
+        mpi::CommFree(leaderComm_);
+    mpi::CommFree(nodeComm_);
+    mpi::CommFree(comm_);
+}
+
+byte*
+NodeComm::Segment( std::size_t bytes )
+{
+    if(bytes <= segmentBytes_ && segment_ != 0)
+        return segment_;
+
+    // Every process of a node asks for the same size, so they agree on
+    // whether to reallocate.  The leader owns the whole segment.
+    if(segment_ != 0){
+        mpi::WinUnlockAll(win_);
+        mpi::WinFree(win_);
+    }
+    bytes = std::max(bytes, std::size_t(1));
+    mpi::WinAllocateShared(nodeRank_ == 0 ? bytes : 0, 1, nodeComm_, &segment_, win_);
+    mpi::WinSharedQuery(win_, 0, &segment_);
+    mpi::WinLockAll(win_);
+    segmentBytes_ = bytes;
+    return segment_;
+}
+
+void
+NodeComm::NodeSync()
+{
+    mpi::WinSync(win_);
+    mpi::Barrier(nodeComm_);
+    mpi::WinSync(win_);
+}
+
+// Every process writes its block into its slot of the node segment, the
+// leaders gather whole node blocks, and every process copies the result out
+template<typename T>
+void
+NodeComm::AllGather( const T* sbuf, int sc, T* rbuf )
+{
+    PROFILE_SECTION("NodeAllGather");
+    const int p = pos_.size();
+
+    // The leaders' displacements run up to p*sc, which must fit in an int
+    const std::size_t areaSize = std::size_t(p) * sc;
+    if(areaSize > std::size_t(std::numeric_limits<int>::max())){
+        mpi::AllGather(sbuf, sc, rbuf, sc, comm_);
+        PROFILE_RETURN;
+    }
+    T* slots = reinterpret_cast<T*>(Segment(sizeof(T) * areaSize));
+
+    MemCopy(&(slots[std::size_t(pos_[rank_]) * sc]), sbuf, sc);
+    NodeSync();
+
+    if(nodeRank_ == 0){
+        const Unsigned numNodes = NumNodes();
+        std::vector<int> rcs(numNodes), rds(numNodes);
+        for(Unsigned J = 0; J < numNodes; J++){
+            rcs[J] = nodeSizes_[J] * sc;
+            rds[J] = nodeOffsets_[J] * sc;
+        }
+        std::vector<T> nodeBlock(&(slots[std::size_t(nodeOffsets_[node_]) * sc]), &(slots[std::size_t(nodeOffsets_[node_] + nodeSize_) * sc]));
+        mpi::AllGather(&(nodeBlock[0]), nodeSize_ * sc, slots, &(rcs[0]), &(rds[0]), leaderComm_);
+    }
+    NodeSync();
+
+    for(int r = 0; r < p; r++)
+        MemCopy(&(rbuf[std::size_t(r) * sc]), &(slots[std::size_t(pos_[r]) * sc]), sc);
+    NodeSync();
+    PROFILE_STOP;
+}
+
+// The send area holds, for each destination node J, the blocks from every
+// local process l to every process m of J ([J][l][m]), so the leaders
+// exchange one contiguous message per node pair.  Received messages land
+// as [J][l][m] with m local, where process m picks up its blocks.
+template<typename T>
+void
+NodeComm::AllToAll( const T* sbuf, int sc, T* rbuf )
+{
+    PROFILE_SECTION("NodeAllToAll");
+    const int p = pos_.size();
+
+    // The leaders' counts and displacements run up to (node size)*p*sc.
+    // Every process falls back to the flat collective together if that
+    // overflows an int on any node.
+    const std::size_t maxNodeSize = *std::max_element(nodeSizes_.begin(), nodeSizes_.end());
+    if(maxNodeSize * p * sc > std::size_t(std::numeric_limits<int>::max())){
+        mpi::AllToAll(sbuf, sc, rbuf, sc, comm_);
+        PROFILE_RETURN;
+    }
+    const std::size_t areaSize = std::size_t(nodeSize_) * p * sc;
+    T* sendArea = reinterpret_cast<T*>(Segment(sizeof(T) * 2 * areaSize));
+    T* recvArea = &(sendArea[areaSize]);
+
+    for(int s = 0; s < p; s++){
+        const int J = nodeOf_[s];
+        const std::size_t offset = std::size_t(nodeSize_) * nodeOffsets_[J] + nodeRank_ * nodeSizes_[J] + localRankOf_[s];
+        MemCopy(&(sendArea[offset * sc]), &(sbuf[std::size_t(s) * sc]), sc);
+    }
+    NodeSync();
+
+    if(nodeRank_ == 0){
+        const Unsigned numNodes = NumNodes();
+        std::vector<int> counts(numNodes), displs(numNodes);
+        for(Unsigned J = 0; J < numNodes; J++){
+            counts[J] = nodeSize_ * nodeSizes_[J] * sc;
+            displs[J] = nodeSize_ * nodeOffsets_[J] * sc;
+        }
+        mpi::AllToAll(sendArea, &(counts[0]), &(displs[0]), recvArea, &(counts[0]), &(displs[0]), leaderComm_);
+    }
+    NodeSync();
+
+    for(int r = 0; r < p; r++){
+        const std::size_t offset = std::size_t(nodeSize_) * nodeOffsets_[nodeOf_[r]] + localRankOf_[r] * nodeSize_ + nodeRank_;
+        MemCopy(&(rbuf[std::size_t(r) * sc]), &(recvArea[offset * sc]), sc);
+    }
+    NodeSync();
+    PROFILE_STOP;
+}
+
+// Processes first sum their contributions within the node, each reducing an
+// interleaved share of the blocks, then the leaders reduce-scatter whole
+// node blocks and every process copies its own block out
+template<typename T>
+void
+NodeComm::ReduceScatter( const T* sbuf, T* rbuf, int rc )
+{
+    PROFILE_SECTION("NodeReduceScatter");
+    const int p = pos_.size();
+    T* sendArea = reinterpret_cast<T*>(Segment(sizeof(T) * (nodeSize_ * p + p + nodeSize_) * rc));
+    T* nodeSums = &(sendArea[nodeSize_ * p * rc]);
+    T* recvArea = &(nodeSums[p * rc]);
+
+    for(int s = 0; s < p; s++)
+        MemCopy(&(sendArea[(nodeRank_ * p + pos_[s]) * rc]), &(sbuf[s * rc]), rc);
+    NodeSync();
+
+    for(int q = nodeRank_; q < p; q += nodeSize_){
+        T* sum = &(nodeSums[q * rc]);
+        MemCopy(sum, &(sendArea[q * rc]), rc);
+        for(int l = 1; l < nodeSize_; l++){
+            const T* block = &(sendArea[(l * p + q) * rc]);
+            for(int i = 0; i < rc; i++)
+                sum[i] += block[i];
+        }
+    }
+    NodeSync();
+
+    if(nodeRank_ == 0){
+        const Unsigned numNodes = NumNodes();
+        std::vector<int> rcs(numNodes);
+        for(Unsigned J = 0; J < numNodes; J++)
+            rcs[J] = nodeSizes_[J] * rc;
+        mpi::ReduceScatter(nodeSums, recvArea, &(rcs[0]), leaderComm_);
+    }
+    NodeSync();
+
+    MemCopy(rbuf, &(recvArea[nodeRank_ * rc]), rc);
+    NodeSync();
+    PROFILE_STOP;
+}
+
+#define FULL(T) \
+  template void NodeComm::AllGather( const T* sbuf, int sc, T* rbuf ); \
+  template void NodeComm::AllToAll( const T* sbuf, int sc, T* rbuf ); \
+  template void NodeComm::ReduceScatter( const T* sbuf, T* rbuf, int rc );
+
+FULL(Int)
+#ifndef DISABLE_FLOAT
+FULL(float)
+#endif
+FULL(double)
+
+#ifndef DISABLE_COMPLEX
+#ifndef DISABLE_FLOAT
+FULL(std::complex<float>)
+#endif
+FULL(std::complex<double>)
+#endif
+
+} // namespace rote
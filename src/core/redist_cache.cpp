@@ -0,0 +1,285 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+
+#include "rote.hpp"
+
+namespace {
+
+typedef std::pair<std::vector<rote::ModeArray>, std::vector<rote::ModeArray> > DistPair;
+typedef std::pair<rote::ModeArray, rote::ObjShape> ReduceGridPair;
+typedef std::pair<rote::ObjShape, rote::Unsigned> SizePair;
+typedef std::pair<std::pair<DistPair, ReduceGridPair>, SizePair> RedistPlanKey;
+
+typedef std::pair<rote::CommPackKey, rote::Unsigned> CommDatatypesKey;
+
+// Plans are evicted least recently used first past maxCachedPlans; the other
+// caches are flushed wholesale once they grow past their bounds
+const std::size_t maxCachedPlans = 1024;
+const std::size_t maxCachedPackInfos = 4096;
+const std::size_t maxCachedDatatypes = 1024;
+
+// Most recently used first
+struct RedistPlanEntry
+{
+    std::shared_ptr<const rote::RedistPlan> plan;
+    std::list<RedistPlanKey>::iterator use;
+};
+std::list<RedistPlanKey> planUses;
+std::map<RedistPlanKey, RedistPlanEntry> planCache;
+std::map<rote::CommPackKey, std::shared_ptr<const rote::CommPackInfo> > packCache;
+std::map<CommDatatypesKey, std::shared_ptr<const rote::CommDatatypes> > typeCache;
+
+std::size_t lastTensorVersion = 0;
+
+// Most recently used first
+struct RedistResultEntry
+{
+    std::shared_ptr<const void> result;
+    std::size_t bytes;
+    std::list<rote::RedistResultKey>::iterator use;
+};
+std::list<rote::RedistResultKey> resultUses;
+std::map<rote::RedistResultKey, RedistResultEntry> resultCache;
+std::size_t resultBytes = 0;
+
+void EraseRedistResult(std::map<rote::RedistResultKey, RedistResultEntry>::iterator it){
+    ::resultBytes -= it->second.bytes;
+    ::resultUses.erase(it->second.use);
+    ::resultCache.erase(it);
+}
+
+} // anonymous namespace
+
+namespace rote {
+
+bool operator<(const CommPackKey& lhs, const CommPackKey& rhs){
+    if(lhs.kind != rhs.kind)
+        return lhs.kind < rhs.kind;
+    if(lhs.gridShape != rhs.gridShape)
+        return lhs.gridShape < rhs.gridShape;
+    if(lhs.gridLoc != rhs.gridLoc)
+        return lhs.gridLoc < rhs.gridLoc;
+    if(lhs.commModes != rhs.commModes)
+        return lhs.commModes < rhs.commModes;
+    if(lhs.reduceModes != rhs.reduceModes)
+        return lhs.reduceModes < rhs.reduceModes;
+    if(lhs.bufShape != rhs.bufShape)
+        return lhs.bufShape < rhs.bufShape;
+
+    if(lhs.distA != rhs.distA)
+        return lhs.distA < rhs.distA;
+    if(lhs.shapeA != rhs.shapeA)
+        return lhs.shapeA < rhs.shapeA;
+    if(lhs.alignA != rhs.alignA)
+        return lhs.alignA < rhs.alignA;
+    if(lhs.permA != rhs.permA)
+        return lhs.permA < rhs.permA;
+    if(lhs.stridesA != rhs.stridesA)
+        return lhs.stridesA < rhs.stridesA;
+
+    if(lhs.distB != rhs.distB)
+        return lhs.distB < rhs.distB;
+    if(lhs.shapeB != rhs.shapeB)
+        return lhs.shapeB < rhs.shapeB;
+    if(lhs.alignB != rhs.alignB)
+        return lhs.alignB < rhs.alignB;
+    if(lhs.permB != rhs.permB)
+        return lhs.permB < rhs.permB;
+    return lhs.stridesB < rhs.stridesB;
+}
+
+std::vector<ModeArray>
+DistEntries(const TensorDistribution& dist){
+    std::vector<ModeArray> ret(dist.size());
+    for(Unsigned i = 0; i < dist.size(); i++)
+        ret[i] = dist[i].Entries();
+    return ret;
+}
+
+std::shared_ptr<const RedistPlan>
+CachedRedistPlan(const TensorDistribution& dB, const TensorDistribution& dA, const ModeArray& reduceModes, const Grid& g, const ObjShape& shapeA, const Unsigned elemSize){
+    ModeArray sortedReduceModes = reduceModes;
+    SortVector(sortedReduceModes);
+    RedistPlanKey key(std::make_pair(DistPair(DistEntries(dB), DistEntries(dA)), ReduceGridPair(sortedReduceModes, g.Shape())), SizePair(shapeA, elemSize));
+
+    std::map<RedistPlanKey, ::RedistPlanEntry>::iterator it = ::planCache.find(key);
+    if(it != ::planCache.end()){
+        ::planUses.splice(::planUses.begin(), ::planUses, it->second.use);
+        return it->second.plan;
+    }
+
+    while(::planCache.size() >= ::maxCachedPlans){
+        ::planCache.erase(::planUses.back());
+        ::planUses.pop_back();
+    }
+
+    PROFILE_SECTION("RedistPlan");
+    std::shared_ptr<const RedistPlan> plan(new RedistPlan(dB, dA, reduceModes, g, shapeA, elemSize));
+    PROFILE_STOP;
+    ::planUses.push_front(key);
+    ::RedistPlanEntry& entry = ::planCache[key];
+    entry.plan = plan;
+    entry.use = ::planUses.begin();
+    return plan;
+}
+
+std::shared_ptr<const CommPackInfo>
+FindCommPackInfo(const CommPackKey& key){
+    std::map<CommPackKey, std::shared_ptr<const CommPackInfo> >::const_iterator it = ::packCache.find(key);
+    if(it == ::packCache.end())
+        return std::shared_ptr<const CommPackInfo>();
+    return it->second;
+}
+
+std::shared_ptr<const CommPackInfo>
+StoreCommPackInfo(const CommPackKey& key, const CommPackInfo& info){
+    if(::packCache.size() >= ::maxCachedPackInfos)
+        ::packCache.clear();
+
+    std::shared_ptr<const CommPackInfo> entry(new CommPackInfo(info));
+    ::packCache[key] = entry;
+    return entry;
+}
+
+CommDatatypes::CommDatatypes(const Unsigned nPeers)
+: counts(nPeers, 0), displs(nPeers, 0), types(nPeers, mpi::TypeMap<byte>())
+{ }
+
+CommDatatypes::~CommDatatypes(){
+    if(mpi::Finalized())
+        return;
+    for(Unsigned i = 0; i < types.size(); i++)
+        if(types[i] != mpi::TypeMap<byte>())
+            mpi::TypeFree(types[i]);
+}
+
+mpi::Datatype
+StridedBlockType(const ObjShape& loopShape, const std::vector<Unsigned>& strides, const std::size_t offset, const Unsigned elemSize){
+    mpi::Datatype type;
+    if(loopShape.size() == 0){
+        mpi::TypeCreateHVector(1, elemSize, 0, mpi::TypeMap<byte>(), type);
+    }else{
+        mpi::TypeCreateHVector(loopShape[0], elemSize, mpi::Aint(strides[0]) * elemSize, mpi::TypeMap<byte>(), type);
+        for(Unsigned i = 1; i < loopShape.size(); i++){
+            mpi::Datatype inner = type;
+            mpi::TypeCreateHVector(loopShape[i], 1, mpi::Aint(strides[i]) * elemSize, inner, type);
+            mpi::TypeFree(inner);
+        }
+    }
+
+    if(offset != 0){
+        const int blockLength = 1;
+        const mpi::Aint displ = mpi::Aint(offset) * elemSize;
+        mpi::Datatype inner = type;
+        mpi::TypeCreateHIndexed(1, &blockLength, &displ, inner, type);
+        mpi::TypeFree(inner);
+    }
+    mpi::TypeCommit(type);
+    return type;
+}
+
+std::shared_ptr<const CommDatatypes>
+FindCommDatatypes(const CommPackKey& key, const Unsigned elemSize){
+    std::map<CommDatatypesKey, std::shared_ptr<const CommDatatypes> >::const_iterator it = ::typeCache.find(CommDatatypesKey(key, elemSize));
+    if(it == ::typeCache.end())
+        return std::shared_ptr<const CommDatatypes>();
+    return it->second;
+}
+
+std::shared_ptr<const CommDatatypes>
+StoreCommDatatypes(const CommPackKey& key, const Unsigned elemSize, const std::shared_ptr<const CommDatatypes>& types){
+    if(::typeCache.size() >= ::maxCachedDatatypes)
+        ::typeCache.clear();
+
+    ::typeCache[CommDatatypesKey(key, elemSize)] = types;
+    return types;
+}
+
+std::size_t NewTensorVersion(){
+    return ++::lastTensorVersion;
+}
+
+bool operator<(const RedistResultKey& lhs, const RedistResultKey& rhs){
+    if(lhs.src != rhs.src)
+        return lhs.src < rhs.src;
+    if(lhs.version != rhs.version)
+        return lhs.version < rhs.version;
+    if(lhs.data != rhs.data)
+        return lhs.data < rhs.data;
+    if(lhs.srcShape != rhs.srcShape)
+        return lhs.srcShape < rhs.srcShape;
+    if(lhs.srcDist != rhs.srcDist)
+        return lhs.srcDist < rhs.srcDist;
+    if(lhs.srcAlign != rhs.srcAlign)
+        return lhs.srcAlign < rhs.srcAlign;
+    if(lhs.srcPerm != rhs.srcPerm)
+        return lhs.srcPerm < rhs.srcPerm;
+    if(lhs.grid != rhs.grid)
+        return lhs.grid < rhs.grid;
+    if(lhs.dist != rhs.dist)
+        return lhs.dist < rhs.dist;
+    if(lhs.align != rhs.align)
+        return lhs.align < rhs.align;
+    return lhs.perm < rhs.perm;
+}
+
+std::shared_ptr<const void>
+FindRedistResult(const RedistResultKey& key){
+    std::map<RedistResultKey, ::RedistResultEntry>::iterator it = ::resultCache.find(key);
+    if(it == ::resultCache.end())
+        return std::shared_ptr<const void>();
+    ::resultUses.splice(::resultUses.begin(), ::resultUses, it->second.use);
+    return it->second.result;
+}
+
+void
+StoreRedistResult(const RedistResultKey& key, const std::shared_ptr<const void>& result, const std::size_t bytes){
+    //Copies of other versions of the tensor can never be found again
+    RedistResultKey first;
+    first.src = key.src;
+    first.version = 0;
+    first.data = 0;
+    first.grid = 0;
+    std::map<RedistResultKey, ::RedistResultEntry>::iterator it = ::resultCache.lower_bound(first);
+    while(it != ::resultCache.end() && it->first.src == key.src){
+        if(it->first.version != key.version || !(it->first < key || key < it->first))
+            ::EraseRedistResult(it++);
+        else
+            it++;
+    }
+
+    const std::size_t limit = RedistResultCacheLimit();
+    if(bytes > limit)
+        return;
+    while(::resultBytes + bytes > limit)
+        ::EraseRedistResult(::resultCache.find(::resultUses.back()));
+
+    ::resultUses.push_front(key);
+    ::RedistResultEntry& entry = ::resultCache[key];
+    entry.result = result;
+    entry.bytes = bytes;
+    entry.use = ::resultUses.begin();
+    ::resultBytes += bytes;
+}
+
+void ClearRedistResults(){
+    ::resultCache.clear();
+    ::resultUses.clear();
+    ::resultBytes = 0;
+}
+
+void ClearRedistCache(){
+    ::planCache.clear();
+    ::planUses.clear();
+    ::packCache.clear();
+    ::typeCache.clear();
+    ClearRedistResults();
+}
+
+} // namespace rote
@@ -9,6 +9,66 @@
 */
 
 #include "rote.hpp"
+#include <limits>
+#include <set>
+
+namespace {
+
+// Bits selecting how RedistPlan::Build orders its passes
+enum PlanStrategy {
+  PlanMoveOpt = 1,        // Turn grid-view preserving moves into one Perm first
+  PlanRemoveFirst = 2,    // Gather removed modes before moving the others
+  PlanForceRS = 4,        // Reduce-scatter even when an all-reduce suffices
+  NumPlanStrategies = 8
+};
+
+// Number of processes along the given grid modes (1 for no modes)
+rote::Unsigned GridDim(const rote::ObjShape& gridShape, const rote::ModeArray& modes) {
+  rote::Unsigned ret = 1;
+  for (rote::Mode m: modes) {
+    ret *= gridShape[m];
+  }
+  return ret;
+}
+
+double CeilLog2(const rote::Unsigned p) {
+  return p <= 1 ? 0 : std::ceil(std::log2(double(p)));
+}
+
+// Permutation from dFrom to dTo, communicating over the grid modes past the
+// common prefix of each mode distribution
+rote::Redist PermRedist(const rote::TensorDistribution& dTo, const rote::TensorDistribution& dFrom) {
+  rote::ModeArray commModes;
+  rote::TensorDistribution diff = dTo - (dTo.GetCommonPrefix(dFrom));
+  for (int i = 0; i < dTo.size(); i++) {
+    rote::ModeArray diffModes = diff[i].Entries();
+    commModes.insert(commModes.end(), diffModes.begin(), diffModes.end());
+  }
+  return rote::Redist(dTo, dFrom, rote::Perm, commModes);
+}
+
+// dist with gModes moved to the end of the tensor modes distributed over
+// them, which AllGather and AllToAll expect of the grid modes they remove
+rote::TensorDistribution TrailingModes(const rote::TensorDistribution& dist, const rote::ModeArray& gModes) {
+  rote::TensorDistribution ret = dist;
+  for (rote::Mode gMode: gModes) {
+    const rote::Mode tMode = dist.TensorModeForGridMode(gMode);
+    ret[tMode] -= gMode;
+    ret[tMode] += gMode;
+  }
+  return ret;
+}
+
+// A distribution reached by the planner's search and the steps taken from
+// its parent to reach it
+struct SearchNode {
+  rote::TensorDistribution dist;
+  double cost;
+  rote::Unsigned parent;
+  std::vector<rote::Redist> steps;
+};
+
+} // anonymous namespace
 
 namespace rote {
 ////
@@ -254,14 +314,7 @@ RedistPlan::ShuffleTo(const TensorDistribution& dB) {
     return;
   }
 
-  ModeArray commModes;
-  TensorDistribution diff = dB - (dB.GetCommonPrefix(dCur_));
-  for(int i = 0; i < dB.size(); i++) {
-    commModes.insert(commModes.end(), diff[i].Entries().begin(), diff[i].Entries().end());
-  }
-
-  Redist redist(dB, dCur_, Perm, commModes);
-  plan_.push_back(redist);
+  plan_.push_back(PermRedist(dB, dCur_));
   dCur_ = dB;
 }
 
@@ -271,21 +324,21 @@ RedistPlan::MoveOpt() {
     return;
   }
 
-  int maxP = 0;
+  int maxP = 1;
   std::vector<unsigned> bestComm(info_.moved().size(), 0);
 
   // Optimization must retain grid view shape.  Initialize
   ObjShape shapeGV(dCur_.size(), 1);
   for(int i = 0; i < shapeGV.size(); i++) {
     for(int j = 0; j < dCur_[i].size(); j++) {
-      shapeGV[i] *= g_.Dimension(dCur_[i][j]);
+      shapeGV[i] *= gridShape_[dCur_[i][j]];
     }
   }
 
   // Initialize extra map to index linearly into grid mode map
   std::map<int, Mode> gModeMap;
   int count = 0;
-  for(auto const& kv: info_.removed()) {
+  for(auto const& kv: info_.moved()) {
     gModeMap[count++] = kv.first;
   }
 
@@ -293,14 +346,14 @@ RedistPlan::MoveOpt() {
   std::vector<unsigned> testComm(bestComm.size(), 0);
   std::vector<unsigned> end(bestComm.size(), 2);
   unsigned p = 0, o = end.size();
-  while(p != 0 && ElemwiseLessThan(testComm, end)) {
+  while(p != o) {
     int testCommProc = 1;
     ObjShape testShape(shapeGV);
     for(int i = 0; i < testComm.size(); i++) {
       if (testComm[i]) {
         Mode gMode = gModeMap[i];
         std::pair<Mode, Mode> moveInfo = info_.moved()[gMode];
-        int gDim = g_.Dimension(gMode);
+        int gDim = gridShape_[gMode];
 
         testShape[moveInfo.first] *= gDim;
         testShape[moveInfo.second] /= gDim;
@@ -309,11 +362,13 @@ RedistPlan::MoveOpt() {
     }
 
     // Update best optimization
-    if(AnyElemwiseNotEqual(testShape, shapeGV) && testCommProc > maxP) {
+    if(!AnyElemwiseNotEqual(testShape, shapeGV) && testCommProc > maxP) {
       maxP = testCommProc;
       bestComm = testComm;
     }
 
+    // Update
+    testComm[p]++;
     while(p < o && testComm[p] >= end[p]) {
       testComm[p] = 0;
       p++;
@@ -331,7 +386,7 @@ RedistPlan::MoveOpt() {
   TensorDistribution dB = dCur_;
   for(int i = 0; i < bestComm.size(); i++) {
     if (bestComm[i]) {
-      Mode gMode = gModeMap[bestComm[i]];
+      Mode gMode = gModeMap[i];
       std::pair<Mode, Mode> moveInfo = info_.moved()[gMode];
 
       dB[moveInfo.second] -= gMode;
@@ -490,25 +545,455 @@ RedistPlan::Move() {
   }
 }
 
+// Runs the greedy passes in the order selected by strategy.  Returns false
+// if the passes stall or do not produce a valid chain from dA to dB_.
+bool
+RedistPlan::Build(const TensorDistribution& dA, const Unsigned strategy) {
+  info_ = RedistPlanInfo(dB_, dA, reduceModes_);
+  plan_.clear();
+  dCur_ = dA;
+
+  Add();
+  RedistPlanInfo postAddInfo(dB_, dCur_, reduceModes_);
+  // PrintRedistPlanInfo(info_, "RedistPlanInfo");
+
+  info_ = postAddInfo;
+  if (strategy & PlanForceRS) {
+    ReduceScatter();
+  } else {
+    Reduce();
+  }
+
+  if (strategy & PlanRemoveFirst) {
+    Remove();
+  }
+  if (strategy & PlanMoveOpt) {
+    MoveOpt();
+  }
+  while (info_.moved().size() > 0) {
+    Unsigned nMoved = info_.moved().size();
+    MoveSimple();
+    MoveComplex();
+    if (info_.moved().size() == nMoved) {
+      return false;
+    }
+  }
+  Remove();
+  ShuffleTo(dB_);
+  return IsConsistent(dA);
+}
+
+// Checks that the steps chain from dA to dB_ and that each step is of a
+// form its communication routine accepts
+bool
+RedistPlan::IsConsistent(const TensorDistribution& dA) const {
+  TensorDistribution dPrev = dA;
+  for (const Redist& redist: plan_) {
+    if (redist.dA() != dPrev || redist.dB() == redist.dA()) {
+      return false;
+    }
+
+    const TensorDistribution& dFrom = redist.dA();
+    const TensorDistribution& dTo = redist.dB();
+    ModeArray usedFrom = dFrom.UsedModes().Entries();
+    ModeArray usedTo = dTo.UsedModes().Entries();
+    switch (redist.type()) {
+      case RS:
+      case AR:
+        if (dTo.size() + reduceModes_.size() != dFrom.size()) {
+          return false;
+        }
+        break;
+      case Perm:
+        if (dTo.size() != dFrom.size()) {
+          return false;
+        }
+        for (Unsigned i = 0; i < dTo.size() - 1; i++) {
+          if (GridDim(gridShape_, dTo[i].Entries()) != GridDim(gridShape_, dFrom[i].Entries())) {
+            return false;
+          }
+        }
+        break;
+      case A2A:
+        if (dTo.size() != dFrom.size() || DiffVector(usedTo, usedFrom).size() != 0 || DiffVector(usedFrom, usedTo).size() != 0) {
+          return false;
+        }
+        break;
+      case AG:
+        if (dTo.size() != dFrom.size() || DiffVector(usedTo, usedFrom).size() != 0) {
+          return false;
+        }
+        break;
+      case Local:
+        if (dTo.size() != dFrom.size() || DiffVector(usedFrom, usedTo).size() != 0) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+    dPrev = dTo;
+  }
+  return dPrev == dB_;
+}
+
+double
+RedistPlan::LocalBytes(const TensorDistribution& dist, const ObjShape& shape) const {
+  double bytes = elemSize_;
+  for (Unsigned i = 0; i < shape.size() && i + 1 < dist.size(); i++) {
+    bytes *= MaxLength(shape[i], GridDim(gridShape_, dist[i].Entries()));
+  }
+  return bytes;
+}
+
+double
+RedistPlan::ExactLocalBytes(const TensorDistribution& dist, const ObjShape& shape) const {
+  double bytes = elemSize_;
+  for (Unsigned i = 0; i < shape.size() && i + 1 < dist.size(); i++) {
+    bytes *= double(shape[i]) / GridDim(gridShape_, dist[i].Entries());
+  }
+  return bytes;
+}
+
+bool PreferExactCommCounts(const double paddedElems, const double exactElems) {
+  return exactElems > 0 && paddedElems > (1 + CommPaddingThreshold()) * exactElems;
+}
+
+// alpha-beta-gamma estimate using the per-process message sizes of each
+// step and the size of the communicator it runs over.  Communicators
+// calibrated by CalibrateCommModel use their fitted costs instead.
+double
+RedistPlan::EstimateCost(std::vector<double>& stepCosts) const {
+  ObjShape shape = shapeA_;
+  double total = 0;
+
+  stepCosts.resize(plan_.size());
+  for (Unsigned i = 0; i < plan_.size(); i++) {
+    stepCosts[i] = EstimateStepCost(plan_[i], shape);
+    total += stepCosts[i];
+  }
+  return total;
+}
+
+// Cost of a single step applied to a tensor of the given shape.  Reductions
+// remove the reduced modes from shape.
+double
+RedistPlan::EstimateStepCost(const Redist& redist, ObjShape& shape) const {
+  const CommCostModel& model = GetCommCostModel();
+  const ObjShape shapeBefore = shape;
+  double nA = LocalBytes(redist.dA(), shape);
+
+  ModeArray commModes = redist.modes();
+  if (redist.type() == RS || redist.type() == AR) {
+    commModes.clear();
+    for (Mode rMode: reduceModes_) {
+      ModeArray rGModes = redist.dA()[rMode].Entries();
+      commModes.insert(commModes.end(), rGModes.begin(), rGModes.end());
+    }
+    for (Unsigned j = reduceModes_.size() - 1; j < reduceModes_.size(); j--) {
+      if (reduceModes_[j] < shape.size()) {
+        shape.erase(shape.begin() + reduceModes_[j]);
+      }
+    }
+  }
+  const Unsigned p = GridDim(gridShape_, commModes);
+  double nB = LocalBytes(redist.dB(), shape);
+  if (redist.type() == AG || redist.type() == A2A || redist.type() == RS) {
+    const double exactA = ExactLocalBytes(redist.dA(), shapeBefore);
+    const double exactB = ExactLocalBytes(redist.dB(), shape);
+    nA = PreferExactCommCounts(nA, exactA) ? exactA : nA;
+    nB = PreferExactCommCounts(nB, exactB) ? exactB : nB;
+  }
+  const double frac = double(p - 1) / p;
+
+  // Prefer the calibrated costs of this communicator
+  double cost = model.gamma * (nA + nB);
+  CommFit fit;
+  if (redist.type() != Local && commModes.size() > 0 && FindCommFit(gridShape_, commModes, redist.type(), fit)) {
+    return cost + fit.alpha + fit.beta * nA;
+  }
+  switch (redist.type()) {
+    case AG:   cost += CeilLog2(p) * model.alpha + frac * nB * model.beta; break;
+    case A2A:  cost += (p - 1) * model.alpha + frac * nA * model.beta; break;
+    case Perm: cost += model.alpha + nA * model.beta; break;
+    case RS:   cost += CeilLog2(p) * model.alpha + frac * nA * (model.beta + model.gamma); break;
+    case AR:   cost += 2 * CeilLog2(p) * model.alpha + 2 * frac * nA * model.beta + frac * nA * model.gamma; break;
+    default: break;
+  }
+  return cost;
+}
+
+// Appends the steps that may leave dist, each as the short sequence the
+// communication routines accept (a Perm first when grid modes must be moved
+// to the end of their mode distributions), stopping at maxMoves.  Before the
+// reduction only Local steps and the reduction itself are considered.
+void
+RedistPlan::Expand(const TensorDistribution& dist, const Unsigned maxMoves, std::vector<std::vector<Redist> >& moves) const {
+  const Unsigned order = dist.size() - 1;
+  const bool reduced = reduceModes_.size() == 0 || dist.size() == dB_.size();
+
+  // Tensor modes grid modes may be appended to
+  ModeArray tModes;
+  for (Unsigned i = 0; i < order; i++) {
+    if (reduced || !Contains(reduceModes_, i)) {
+      tModes.push_back(i);
+    }
+  }
+  ModeArray used = dist.UsedModes().Entries();
+  SortVector(used);
+
+  // Local: distribute a tensor mode over a grid mode the target uses
+  for (Mode gMode: dB_.UsedModes().Entries()) {
+    if (Contains(used, gMode) || dist[order].Contains(gMode)) {
+      continue;
+    }
+    for (Mode tMode: tModes) {
+      if (moves.size() >= maxMoves) {
+        return;
+      }
+      TensorDistribution dTo = dist;
+      dTo[tMode] += gMode;
+      moves.push_back(std::vector<Redist>(1, Redist(dTo, dist, Local, ModeArray(1, gMode))));
+    }
+  }
+
+  if (!reduced) {
+    ModeArray rGModes;
+    for (Mode rMode: reduceModes_) {
+      ModeArray modes = dist[rMode].Entries();
+      rGModes.insert(rGModes.end(), modes.begin(), modes.end());
+    }
+    TensorDistribution dReduced = dist;
+    dReduced.RemoveUnitModeDists(reduceModes_);
+
+    // AR: drop the reduced grid modes
+    if (rGModes.size() > 0 && moves.size() < maxMoves) {
+      moves.push_back(std::vector<Redist>(1, Redist(dReduced, dist, AR, rGModes)));
+    }
+
+    // RS: scatter each reduced grid mode over a remaining tensor mode
+    const Unsigned nTo = dReduced.size() - 1;
+    if (rGModes.size() == 0 && moves.size() < maxMoves) {
+      moves.push_back(std::vector<Redist>(1, Redist(dReduced, dist, RS, ModeArray())));
+    }
+    std::vector<Unsigned> dst(rGModes.size(), 0);
+    while (rGModes.size() > 0 && nTo > 0) {
+      if (moves.size() >= maxMoves) {
+        return;
+      }
+      TensorDistribution dTo = dReduced;
+      for (Unsigned i = 0; i < rGModes.size(); i++) {
+        dTo[dst[i]] += rGModes[i];
+      }
+      moves.push_back(std::vector<Redist>(1, Redist(dTo, dist, RS, ModeArray())));
+
+      Unsigned i = 0;
+      for (; i < dst.size() && ++dst[i] == nTo; i++) {
+        dst[i] = 0;
+      }
+      if (i == dst.size()) {
+        break;
+      }
+    }
+    return;
+  }
+
+  // Perm: straight to the target if it views the grid the same way
+  if (dist.size() == dB_.size() && dist[order].SameModesAs(dB_[order]) && dist.UsedModes().SameModesAs(dB_.UsedModes())) {
+    bool sameView = true;
+    for (Unsigned i = 0; i < order; i++) {
+      sameView &= GridDim(gridShape_, dist[i].Entries()) == GridDim(gridShape_, dB_[i].Entries());
+    }
+    if (sameView && moves.size() < maxMoves) {
+      moves.push_back(std::vector<Redist>(1, PermRedist(dB_, dist)));
+    }
+  }
+
+  // Perm: exchange two equally sized grid modes between tensor modes
+  for (Unsigned a = 0; a < used.size(); a++) {
+    for (Unsigned b = a + 1; b < used.size(); b++) {
+      const Mode tModeA = dist.TensorModeForGridMode(used[a]);
+      const Mode tModeB = dist.TensorModeForGridMode(used[b]);
+      if (tModeA == tModeB || gridShape_[used[a]] != gridShape_[used[b]]) {
+        continue;
+      }
+      if (moves.size() >= maxMoves) {
+        return;
+      }
+      ModeArray entriesA = dist[tModeA].Entries();
+      ModeArray entriesB = dist[tModeB].Entries();
+      std::replace(entriesA.begin(), entriesA.end(), used[a], used[b]);
+      std::replace(entriesB.begin(), entriesB.end(), used[b], used[a]);
+      TensorDistribution dTo = dist;
+      dTo[tModeA] = ModeDistribution(entriesA);
+      dTo[tModeB] = ModeDistribution(entriesB);
+      moves.push_back(std::vector<Redist>(1, PermRedist(dTo, dist)));
+    }
+  }
+
+  // AG and A2A over each nonempty subset of the used grid modes
+  for (Unsigned mask = 1; mask < (1u << used.size()); mask++) {
+    ModeArray gModes;
+    ModeArray srcModes;
+    for (Unsigned i = 0; i < used.size(); i++) {
+      if (mask & (1u << i)) {
+        gModes.push_back(used[i]);
+        srcModes.push_back(dist.TensorModeForGridMode(used[i]));
+      }
+    }
+    const TensorDistribution dInt = TrailingModes(dist, gModes);
+    std::vector<Redist> steps;
+    if (dInt != dist) {
+      steps.push_back(PermRedist(dInt, dist));
+    }
+    TensorDistribution dRemoved = dInt;
+    for (Unsigned i = 0; i < gModes.size(); i++) {
+      dRemoved[srcModes[i]] -= gModes[i];
+    }
+
+    if (moves.size() >= maxMoves) {
+      return;
+    }
+    moves.push_back(steps);
+    moves.back().push_back(Redist(dRemoved, dInt, AG, gModes));
+
+    // Each grid mode moves to a tensor mode that loses none
+    const ModeArray dstModes = DiffVector(tModes, srcModes);
+    std::vector<Unsigned> dst(gModes.size(), 0);
+    while (dstModes.size() > 0) {
+      if (moves.size() >= maxMoves) {
+        return;
+      }
+      TensorDistribution dTo = dRemoved;
+      for (Unsigned i = 0; i < gModes.size(); i++) {
+        dTo[dstModes[dst[i]]] += gModes[i];
+      }
+      moves.push_back(steps);
+      moves.back().push_back(Redist(dTo, dInt, A2A, gModes));
+
+      Unsigned i = 0;
+      for (; i < dst.size() && ++dst[i] == dstModes.size(); i++) {
+        dst[i] = 0;
+      }
+      if (i == dst.size()) {
+        break;
+      }
+    }
+  }
+}
+
+// Best-first search from dA over intermediate distributions, with the
+// estimated step costs as edge weights.  Paths costing bound or more are
+// pruned, so the plan is only replaced by a strictly cheaper one.  Ties are
+// broken by discovery order, keeping the plan the same on every process.
+bool
+RedistPlan::Search(const TensorDistribution& dA, const double bound) {
+  ObjShape shapeReduced = shapeA_;
+  for (Unsigned j = reduceModes_.size() - 1; j < reduceModes_.size(); j--) {
+    if (reduceModes_[j] < shapeReduced.size()) {
+      shapeReduced.erase(shapeReduced.begin() + reduceModes_[j]);
+    }
+  }
+
+  std::vector<SearchNode> nodes;
+  std::map<std::vector<ModeArray>, double> bestCost;
+  std::set<std::pair<double, Unsigned> > open;
+  SearchNode start = {dA, 0, 0, std::vector<Redist>()};
+  nodes.push_back(start);
+  bestCost[DistEntries(dA)] = 0;
+  open.insert(std::make_pair(0.0, Unsigned(0)));
+
+  Unsigned budget = RedistPlanSearchLimit();
+  std::vector<std::vector<Redist> > moves;
+  while (!open.empty() && budget > 0) {
+    const Unsigned index = open.begin()->second;
+    open.erase(open.begin());
+    const TensorDistribution dist = nodes[index].dist;
+    const double cost = nodes[index].cost;
+    if (cost > bestCost[DistEntries(dist)]) {
+      continue;
+    }
+
+    if (dist == dB_) {
+      std::vector<Redist> plan;
+      for (Unsigned i = index; i != 0; i = nodes[i].parent) {
+        plan.insert(plan.begin(), nodes[i].steps.begin(), nodes[i].steps.end());
+      }
+      const std::vector<Redist> greedyPlan = plan_;
+      plan_ = plan;
+      if (!IsConsistent(dA)) {
+        plan_ = greedyPlan;
+        return false;
+      }
+      cost_ = EstimateCost(stepCosts_);
+      return true;
+    }
+
+    moves.clear();
+    Expand(dist, budget, moves);
+    budget -= moves.size();
+    const bool reduced = reduceModes_.size() == 0 || dist.size() == dB_.size();
+    for (const std::vector<Redist>& steps: moves) {
+      ObjShape shape = reduced ? shapeReduced : shapeA_;
+      double next = cost;
+      for (const Redist& redist: steps) {
+        next += EstimateStepCost(redist, shape);
+      }
+      const TensorDistribution& dTo = steps.back().dB();
+      const std::vector<ModeArray> key = DistEntries(dTo);
+      std::map<std::vector<ModeArray>, double>::const_iterator it = bestCost.find(key);
+      if (next >= bound || (it != bestCost.end() && it->second <= next)) {
+        continue;
+      }
+      bestCost[key] = next;
+      SearchNode node = {dTo, next, index, steps};
+      nodes.push_back(node);
+      open.insert(std::make_pair(next, Unsigned(nodes.size() - 1)));
+    }
+  }
+  return false;
+}
+
 RedistPlan::RedistPlan(
   const TensorDistribution& dB,
   const TensorDistribution& dA,
   const ModeArray& reduceModes,
-  const Grid& g
-): info_(dB, dA, reduceModes), plan_(), dCur_(dA), dB_(dB), g_(g) {
+  const Grid& g,
+  const ObjShape& shapeA,
+  const Unsigned elemSize
+): info_(dB, dA, reduceModes), plan_(), dCur_(dA), dB_(dB), reduceModes_(reduceModes), gridShape_(g.Shape()), shapeA_(shapeA), elemSize_(elemSize), cost_(0) {
+  SortVector(reduceModes_);
   if (dB_ == dCur_) {
     return;
   }
 
-  Add();
-  RedistPlanInfo postAddInfo(dB, dCur_, reduceModes);
-  // PrintRedistPlanInfo(info_, "RedistPlanInfo");
+  // The cheapest valid ordering of the greedy passes, ties going to
+  // strategy 0 (the original ordering), bounds the search
+  std::vector<Redist> bestPlan;
+  std::vector<double> bestCosts;
+  bool found = false;
+  for (Unsigned strategy = 0; strategy < NumPlanStrategies; strategy++) {
+    if (!Build(dA, strategy)) {
+      continue;
+    }
 
-  info_ = postAddInfo;
-  Reduce();
-  Move();
-  Remove();
-  ShuffleTo(dB_);
+    std::vector<double> costs;
+    double cost = EstimateCost(costs);
+    if (!found || cost < cost_) {
+      found = true;
+      cost_ = cost;
+      bestPlan = plan_;
+      bestCosts = costs;
+    }
+  }
+  plan_ = bestPlan;
+  stepCosts_ = bestCosts;
+
+  const double bound = found ? cost_ : std::numeric_limits<double>::infinity();
+  if (!Search(dA, bound) && !found) {
+    LogicError("RedistPlan: no plan reaches the target distribution");
+  }
+  dCur_ = dB_;
 }
 
 }
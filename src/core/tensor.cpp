@@ -149,6 +149,13 @@ Tensor<T>::Tensor( const Tensor<T>& A )
         LogicError("You just tried to construct a Tensor with itself!");
 }
 
+template<typename T>
+Tensor<T>::Tensor( Tensor<T>&& A )
+: shape_(), strides_(),
+  viewType_( OWNER ),
+  data_(0), memory_()
+{ Swap( A ); }
+
 template<typename T>
 void
 Tensor<T>::Swap( Tensor<T>& A )
@@ -533,6 +540,24 @@ Tensor<T>::operator=( const Tensor<T>& A )
     return *this;
 }
 
+template<typename T>
+const Tensor<T>&
+Tensor<T>::operator=( Tensor<T>&& A )
+{
+    if( &A == this )
+        return *this;
+    if( viewType_ != OWNER || A.viewType_ != OWNER )
+        return *this = static_cast<const Tensor<T>&>(A);
+
+    std::swap( shape_, A.shape_ );
+    std::swap( strides_, A.strides_ );
+    std::swap( data_, A.data_ );
+    memory_.Swap( A.memory_ );
+    A.Empty_();
+
+    return *this;
+}
+
 template<typename T>
 void
 Tensor<T>::Empty_()
@@ -288,8 +288,9 @@ PrintRedistPlan
      case BCast:    std::cout << "BCast: "; break;
      case Scatter:    std::cout << "Scatter: "; break;
    }
-   std::cout << redist.dB() << " <-- " << redist.dA() << std::endl;
+   std::cout << redist.dB() << " <-- " << redist.dA() << "  (" << redistPlan.StepCost(i) << " s)" << std::endl;
   }
+  std::cout << "Predicted cost: " << redistPlan.Cost() << " s" << std::endl;
   std::cout << std::endl;
 }
 
@@ -95,172 +95,172 @@ void InitCheckTensor(const std::string& data_path, int testIter, DistTensor<T>&
 }
 
 template<typename T>
-void ComputeTW(const DistTensor<T>& Twsa, const DistTensor<T>& Trsa, const DistTensor<T>& Tusa, const DistTensor<T>& Tvsa, const DistTensor<T>& Ttau2sa, const DistTensor<T>& Tt, DistTensor<T>& TW, Unsigned blkSize){
+void ComputeTW(const DistTensor<T>& Twsa, const DistTensor<T>& Trsa, const DistTensor<T>& Tusa, const DistTensor<T>& Tvsa, const DistTensor<T>& Ttau2sa, const DistTensor<T>& Tt, DistTensor<T>& TW, Unsigned blkSize, ExprGraph<T>& graph){
 	//W_bmje = (2w_amie - x_amei)
-	YAxpBy(1.0, Twsa, 0.0, TW);
+	graph.YAxpBy(1.0, Twsa, 0.0, TW);
 
 	//W_bmje += \sum_f (2r_bmfe - r_bmef)*t_fj
-	GenContract(1.0, Trsa, "bmfe", Tt, "fj", 1.0, TW, "bmje");
+	graph.GenContract(1.0, Trsa, "bmfe", Tt, "fj", 1.0, TW, "bmje");
 
 	//W_bmje += -\sum_n (2u_nmje - u_mnje) * t_bn
-	GenContract(-1.0, Tusa, "nmje", Tt, "bn", 1.0, TW, "bmje");
+	graph.GenContract(-1.0, Tusa, "nmje", Tt, "bn", 1.0, TW, "bmje");
 
 	const std::vector<Unsigned> blkSizes = {30*blkSize, 3*blkSize};
 	//W_bmje += \sum_fn (2v_fenm - v_femn)*(0.5T_bfnj - Tau_bfnj + T_bfjn)
-	GenContract(1.0, Tvsa, "fenm", Ttau2sa, "bfnj", 1.0, TW, "bmje", blkSizes);
+	graph.GenContract(1.0, Tvsa, "fenm", Ttau2sa, "bfnj", 1.0, TW, "bmje", blkSizes);
 }
 
 template<typename T>
-void ComputeTX(const DistTensor<T>& Tx, const DistTensor<T>& Tv, const DistTensor<T>& Ttau2, const DistTensor<T>& Tu, const DistTensor<T>& Tt, const DistTensor<T>& Tr, DistTensor<T>& TX, Unsigned blkSize){
+void ComputeTX(const DistTensor<T>& Tx, const DistTensor<T>& Tv, const DistTensor<T>& Ttau2, const DistTensor<T>& Tu, const DistTensor<T>& Tt, const DistTensor<T>& Tr, DistTensor<T>& TX, Unsigned blkSize, ExprGraph<T>& graph){
 	//X_bmej = x_bmej;
-	YAxpBy(1.0, Tx, 0.0, TX);
+	graph.YAxpBy(1.0, Tx, 0.0, TX);
 
 	const std::vector<Unsigned> blkSizes = {30*blkSize, 3*blkSize};
 	//X_bmej += -\sum_fn v_femn (tau_bfnj - 0.5 * T_bfnj)
-	GenContract(-1.0, Tv, "femn", Ttau2, "bfnj", 1.0, TX, "bmej", blkSizes);
+	graph.GenContract(-1.0, Tv, "femn", Ttau2, "bfnj", 1.0, TX, "bmej", blkSizes);
 
 	//X_bmej -= \sum_n u_mnje * t_bn
-	GenContract(-1.0, Tu, "mnje", Tt, "bn", 1.0, TX, "bmej");
+	graph.GenContract(-1.0, Tu, "mnje", Tt, "bn", 1.0, TX, "bmej");
 
 	//X_bmej += \sum_f r_bmef * t_fj
-	GenContract(1.0, Tr, "bmef", Tt, "fj", 1.0, TX, "bmej");
+	graph.GenContract(1.0, Tr, "bmef", Tt, "fj", 1.0, TX, "bmej");
 }
 
 template<typename T>
-void ComputeTU(const DistTensor<T>& Tu, const DistTensor<T>& Tv, const DistTensor<T>& Tt, DistTensor<T>& TU){
+void ComputeTU(const DistTensor<T>& Tu, const DistTensor<T>& Tv, const DistTensor<T>& Tt, DistTensor<T>& TU, ExprGraph<T>& graph){
 	//U_mnie = u_mnie;
-	YAxpBy(1.0, Tu, 0.0, TU);
+	graph.YAxpBy(1.0, Tu, 0.0, TU);
 
 	//U_mnie += \sum_f v_femn * t_fi
-	GenContract(1.0, Tv, "femn", Tt, "fi", 1.0, TU, "mnie");
+	graph.GenContract(1.0, Tv, "femn", Tt, "fi", 1.0, TU, "mnie");
 }
 
 template<typename T>
-void ComputeTQ(const DistTensor<T>& Tu, const DistTensor<T>& Tt, const DistTensor<T>& Tv, const DistTensor<T>& Ttau, const DistTensor<T>& Tq, DistTensor<T>& TQ, Unsigned blkSize){
-	DistTensor<double> TQtemp1( TQ.Shape(), "[(0),(1),(2),(3)]", TQ.Grid() );
+void ComputeTQ(const DistTensor<T>& Tu, const DistTensor<T>& Tt, const DistTensor<T>& Tv, const DistTensor<T>& Ttau, const DistTensor<T>& Tq, DistTensor<T>& TQ, Unsigned blkSize, ExprGraph<T>& graph){
+	DistTensor<T>& TQtemp1 = graph.Temporary(TQ.Shape(), StringToTensorDist("[(0),(1),(2),(3)]"), TQ.Grid());
 	Permutation perm_1_0_3_2 = {1,0,3,2};
 
 	//tmp = \sum_e u_mnie * t_ej
-	GenContract(1.0, Tu, "mnie", Tt, "ej", 0.0, TQtemp1, "mnij");
+	graph.GenContract(1.0, Tu, "mnie", Tt, "ej", 0.0, TQtemp1, "mnij");
 
 	//Q_mnij = (1 + P_mnij) (\sum_e u_mnie * t_ej)
-	GenYAxpPx(1.0, TQtemp1, 1.0, perm_1_0_3_2, TQ);
+	graph.GenYAxpPx(1.0, TQtemp1, 1.0, perm_1_0_3_2, TQ);
 
 	std::vector<Unsigned> blkSizes = {4*blkSize, 4*blkSize};
 	//Q_mnij += \sum_ef v_efmn * tau_efij
-	GenContract(1.0, Tv, "efmn", Ttau, "efij", 1.0, TQ, "mnij");
+	graph.GenContract(1.0, Tv, "efmn", Ttau, "efij", 1.0, TQ, "mnij");
 
 	//Q_mnij += q_mnij
-	YAxpBy(1.0, Tq, 1.0, TQ);
+	graph.YAxpBy(1.0, Tq, 1.0, TQ);
 }
 
 template<typename T>
-void ComputeTP(const DistTensor<T>& Tu, const DistTensor<T>& Tr, const DistTensor<T>& Ttau, const DistTensor<T>& Tw, const DistTensor<T>& Tt, const DistTensor<T>& Tx, DistTensor<T>& TP, Unsigned blkSize){
+void ComputeTP(const DistTensor<T>& Tu, const DistTensor<T>& Tr, const DistTensor<T>& Ttau, const DistTensor<T>& Tw, const DistTensor<T>& Tt, const DistTensor<T>& Tx, DistTensor<T>& TP, Unsigned blkSize, ExprGraph<T>& graph){
 	//P_jimb = u_jimb
-	YAxpBy(1.0, Tu, 0.0, TP);
+	graph.YAxpBy(1.0, Tu, 0.0, TP);
 
 	std::vector<Unsigned> blkSizes = {4*blkSize, 4*blkSize};
 	//P_jimb += \sum_ef r_bmef * tau_efij
-	GenContract(1.0, Tr, "bmef", Ttau, "efij", 1.0, TP, "jimb", blkSizes);
+	graph.GenContract(1.0, Tr, "bmef", Ttau, "efij", 1.0, TP, "jimb", blkSizes);
 
 	//P_jimb += \sum_e w_bmie * t_ej
-	GenContract(1.0, Tw, "bmie", Tt, "ej", 1.0, TP, "jimb");
+	graph.GenContract(1.0, Tw, "bmie", Tt, "ej", 1.0, TP, "jimb");
 
 	//P_jimb += \sum_e x_bmej * t_ei
-	GenContract(1.0, Tx, "bmej", Tt, "ei", 1.0, TP, "jimb");
+	graph.GenContract(1.0, Tx, "bmej", Tt, "ei", 1.0, TP, "jimb");
 }
 
 template<typename T>
-void ComputeTH(const DistTensor<T>& Tvsa, const DistTensor<T>& Tt, DistTensor<T>& TH){
+void ComputeTH(const DistTensor<T>& Tvsa, const DistTensor<T>& Tt, DistTensor<T>& TH, ExprGraph<T>& graph){
 	//H_me = \sum_fn (2v_efmn - v_efnm) * t_fn
-	GenContract(1.0, Tvsa, "efmn", Tt, "fn", 0.0, TH, "me");
+	graph.GenContract(1.0, Tvsa, "efmn", Tt, "fn", 0.0, TH, "me");
 }
 
 template<typename T>
-void ComputeTF(const DistTensor<T>& TH, const DistTensor<T>& Tt, const DistTensor<T>& Trsa, const DistTensor<T>& Tvsa, const DistTensor<T>& TT, DistTensor<T>& TF){
+void ComputeTF(const DistTensor<T>& TH, const DistTensor<T>& Tt, const DistTensor<T>& Trsa, const DistTensor<T>& Tvsa, const DistTensor<T>& TT, DistTensor<T>& TF, ExprGraph<T>& graph){
 	//F_ae = -\sum_m H_me * t_am
-	GenContract(-1.0, TH, "me", Tt, "am", 0.0, TF, "ae");
+	graph.GenContract(-1.0, TH, "me", Tt, "am", 0.0, TF, "ae");
 
 	//F_ae += \sum_fm (2r_amef - r_amfe) * t_fm
-	GenContract(1.0, Trsa, "amef", Tt, "fm", 1.0, TF, "ae");
+	graph.GenContract(1.0, Trsa, "amef", Tt, "fm", 1.0, TF, "ae");
 
 	//F_ae += -\sum_fmn (2v_efmn - v_efnm) * T_afmn
-	GenContract(-1.0, Tvsa, "efmn", TT, "afmn", 1.0, TF, "ae");
+	graph.GenContract(-1.0, Tvsa, "efmn", TT, "afmn", 1.0, TF, "ae");
 }
 
 template<typename T>
-void ComputeTG(const DistTensor<T>& TH, const DistTensor<T>& Tt, const DistTensor<T>& Tusa, const DistTensor<T>& Tvsa, const DistTensor<T>& TT, DistTensor<T>& TG){
+void ComputeTG(const DistTensor<T>& TH, const DistTensor<T>& Tt, const DistTensor<T>& Tusa, const DistTensor<T>& Tvsa, const DistTensor<T>& TT, DistTensor<T>& TG, ExprGraph<T>& graph){
 	//G_mi = \sum_e H_me * t_ei
-	GenContract(1.0, TH, "me", Tt, "ei", 0.0, TG, "mi");
+	graph.GenContract(1.0, TH, "me", Tt, "ei", 0.0, TG, "mi");
 
 	//G_mi += \sum_en (2u_mnie - u_nmie) * t_en
-	GenContract(1.0, Tusa, "mnie", Tt, "en", 1.0, TG, "mi");
+	graph.GenContract(1.0, Tusa, "mnie", Tt, "en", 1.0, TG, "mi");
 
 	//G_mi += \sum_efn (2v_efmn - v_efnm) * T_efin
-	GenContract(1.0, Tvsa, "efmn", TT, "efin", 1.0, TG, "mi");
+	graph.GenContract(1.0, Tvsa, "efmn", TT, "efin", 1.0, TG, "mi");
 }
 
 template<typename T>
-void ComputeTz(const DistTensor<T>& TG, const DistTensor<T>& Tt, const DistTensor<T>& TUsa, const DistTensor<T>& TT, const DistTensor<T>& Twsa, const DistTensor<T>& TTsa, const DistTensor<T>& TH, const DistTensor<T>& Trsa, const DistTensor<T>& Ttau, DistTensor<T>& Tz){
+void ComputeTz(const DistTensor<T>& TG, const DistTensor<T>& Tt, const DistTensor<T>& TUsa, const DistTensor<T>& TT, const DistTensor<T>& Twsa, const DistTensor<T>& TTsa, const DistTensor<T>& TH, const DistTensor<T>& Trsa, const DistTensor<T>& Ttau, DistTensor<T>& Tz, ExprGraph<T>& graph){
 	//z_ai = -\sum_m G_mi * t_am
-	GenContract(-1.0, TG, "mi", Tt, "am", 0.0, Tz, "ai");
+	graph.GenContract(-1.0, TG, "mi", Tt, "am", 0.0, Tz, "ai");
 
 	//z_ai += -\sum_emn (2U_mnie - U_nmie) * T_aemn
-	GenContract(-1.0, TUsa, "mnie", TT, "aemn", 1.0, Tz, "ai");
+	graph.GenContract(-1.0, TUsa, "mnie", TT, "aemn", 1.0, Tz, "ai");
 
 	//z_ai += \sum_em (2w_amie - x_amei) * t_em
-	GenContract(1.0, Twsa, "amie", Tt, "em", 1.0, Tz, "ai");
+	graph.GenContract(1.0, Twsa, "amie", Tt, "em", 1.0, Tz, "ai");
 
 	//z_ai += \sum_em (2T_aeim - T_aemi) * H_me
-	GenContract(1.0, TTsa, "aeim", TH, "me", 1.0, Tz, "ai");
+	graph.GenContract(1.0, TTsa, "aeim", TH, "me", 1.0, Tz, "ai");
 
 	//z_ai += \sum_efm (2r_amef - r_amfe) * tau_efim
-	GenContract(1.0, Trsa, "amef", Ttau, "efim", 1.0, Tz, "ai");
+	graph.GenContract(1.0, Trsa, "amef", Ttau, "efim", 1.0, Tz, "ai");
 }
 
 template<typename T>
-void ComputeTZ(const DistTensor<T>& TX, const DistTensor<T>& TT, const DistTensor<T>& TW, const DistTensor<T>& TTsa, const DistTensor<T>& TG, const DistTensor<T>& TF, const DistTensor<T>& TP, const DistTensor<T>& Tt, const DistTensor<T>& Tr, const DistTensor<T>& Ty, const DistTensor<T>& Ttau, const DistTensor<T>& TQ, const DistTensor<T>& Tv, DistTensor<T>& TZ, Unsigned blkSize){
-	DistTensor<T> TZtemp1(TZ.Shape(), TZ.TensorDist(), TZ.Grid());
-	DistTensor<T> TZaccum(TZ.Shape(), TZ.TensorDist(), TZ.Grid());
+void ComputeTZ(const DistTensor<T>& TX, const DistTensor<T>& TT, const DistTensor<T>& TW, const DistTensor<T>& TTsa, const DistTensor<T>& TG, const DistTensor<T>& TF, const DistTensor<T>& TP, const DistTensor<T>& Tt, const DistTensor<T>& Tr, const DistTensor<T>& Ty, const DistTensor<T>& Ttau, const DistTensor<T>& TQ, const DistTensor<T>& Tv, DistTensor<T>& TZ, Unsigned blkSize, ExprGraph<T>& graph){
+	DistTensor<T>& TZtemp1 = graph.Temporary(TZ.Shape(), TZ.TensorDist(), TZ.Grid());
+	DistTensor<T>& TZaccum = graph.Temporary(TZ.Shape(), TZ.TensorDist(), TZ.Grid());
 	Permutation perm_0_1_3_2 = {0,1,3,2};
 	Permutation perm_1_0_3_2 = {1,0,3,2};
 
 	std::vector<Unsigned> blkSizes = {1*blkSize, 10*blkSize};
 	//tmp = \sum_em X_bmej * T_aemi
-	GenContract(1.0, TX, "bmej", TT, "aemi", 0.0, TZtemp1, "abij", blkSizes);
+	graph.GenContract(1.0, TX, "bmej", TT, "aemi", 0.0, TZtemp1, "abij", blkSizes);
 
 	//tmpAccum = -(0.5 + P_ij) (\sum_em X_bmej * T_aemi)
-	GenYAxpPx(-0.5, TZtemp1, -1.0, perm_0_1_3_2, TZaccum);
+	graph.GenYAxpPx(-0.5, TZtemp1, -1.0, perm_0_1_3_2, TZaccum);
 
 	std::vector<Unsigned> blkSizes2 = {1*blkSize, 10*blkSize};
 	//tmpAccum += 0.5 * \sum_em W_bmje * (2T_aeim - T_aemi)
-	GenContract(0.5, TW, "bmje", TTsa, "aeim", 1.0, TZaccum, "abij", blkSizes2);
+	graph.GenContract(0.5, TW, "bmje", TTsa, "aeim", 1.0, TZaccum, "abij", blkSizes2);
 
 	//tmpAccum += -\sum_m G_mi * T_abmj
-	GenContract(-1.0, TG, "mi", TT, "abmj", 1.0, TZaccum, "abij");
+	graph.GenContract(-1.0, TG, "mi", TT, "abmj", 1.0, TZaccum, "abij");
 
 	//tmpAccum += \sum_e F_ae * T_ebij
-	GenContract(1.0, TF, "ae", TT, "ebij", 1.0, TZaccum, "abij");
+	graph.GenContract(1.0, TF, "ae", TT, "ebij", 1.0, TZaccum, "abij");
 
 	//tmpAccum += -\sum_m P_ijmb * t_am
-	GenContract(-1.0, TP, "ijmb", Tt, "am", 1.0, TZaccum, "abij");
+	graph.GenContract(-1.0, TP, "ijmb", Tt, "am", 1.0, TZaccum, "abij");
 
 	//tmpAccum += \sum_e r_ejab * t_ei
-	GenContract(1.0, Tr, "ejab", Tt, "ei", 1.0, TZaccum, "abij");
+	graph.GenContract(1.0, Tr, "ejab", Tt, "ei", 1.0, TZaccum, "abij");
 
 	//Z_abij = (1 + P_aibj) TZaccum
-	GenYAxpPx(1.0, TZaccum, 1.0, perm_1_0_3_2, TZ);
+	graph.GenYAxpPx(1.0, TZaccum, 1.0, perm_1_0_3_2, TZ);
 
 	std::vector<Unsigned> blkSizes3 = {3*blkSize, 3*blkSize};
 	//Z_abij = \sum_ef y_abef * tau_efij
-	GenContract(1.0, Ty, "abef", Ttau, "efij", 1.0, TZ, "abij", blkSizes3);
+	graph.GenContract(1.0, Ty, "abef", Ttau, "efij", 1.0, TZ, "abij", blkSizes3);
 
 	std::vector<Unsigned> blkSizes4 = {4*blkSize, 4*blkSize};
 	//Z_abij = \sum_mn Q_mnij * tau_abmn
-	GenContract(1.0, TQ, "mnij", Ttau, "abmn", 1.0, TZ, "abij", blkSizes4);
+	graph.GenContract(1.0, TQ, "mnij", Ttau, "abmn", 1.0, TZ, "abij", blkSizes4);
 
 	//Z_abij += v_abij
-	YAxpBy(1.0, Tv, 1.0, TZ);
+	graph.YAxpBy(1.0, Tv, 1.0, TZ);
 }
 
 template<typename T>
@@ -411,6 +411,9 @@ InitCheckTensor("ccsd_terms/term_Z_iter", testIter, check_Z);
     mpi::Barrier(g.OwningComm());
     startTime = mpi::Time();
 
+    //Operands such as Tt are redistributed the same way by many terms
+    SetRedistResultCacheLimit(1 << 28);
+
     //Setup temporaries
     //Tau_emfn = T_emfn + t_em*t_fn
 	Ttau = TT;
@@ -438,20 +441,23 @@ InitCheckTensor("ccsd_terms/term_Z_iter", testIter, check_Z);
 	GenZAxpBypPx(0.5, TT, -1.0, Ttau, perm_0_1_3_2, Ttau2sa );
 
 	//BEGIN COMPUTATION
-	ComputeTW(Twsa, Trsa, Tusa, Tvsa, Ttau2sa, Tt, TW, blkSize);
-	ComputeTX(Tx, Tv, Ttau2, Tu, Tt, Tr, TX, blkSize);
-	ComputeTU(Tu, Tv, Tt, TU);
+	ExprGraph<double> graph;
+	ComputeTW(Twsa, Trsa, Tusa, Tvsa, Ttau2sa, Tt, TW, blkSize, graph);
+	ComputeTX(Tx, Tv, Ttau2, Tu, Tt, Tr, TX, blkSize, graph);
+	ComputeTU(Tu, Tv, Tt, TU, graph);
 
 	//tmp = (2U_mnie - U_nmie)
-	GenYAxpPx(2.0, TU, -1.0, perm_1_0_2_3, TUsa);
-
-	ComputeTQ(Tu, Tt, Tv, Ttau, Tq, TQ, blkSize);
-	ComputeTP(Tu, Tr, Ttau, Tw, Tt, Tx, TP, blkSize);
-	ComputeTH(Tvsa, Tt, TH);
-	ComputeTF(TH, Tt, Trsa, Tvsa, TT, TF);
-	ComputeTG(TH, Tt, Tusa, Tvsa, TT, TG);
-	ComputeTz(TG, Tt, TUsa, TT, Twsa, TTsa, TH, Trsa, Ttau, Tz);
-	ComputeTZ(TX, TT, TW, TTsa, TG, TF, TP, Tt, Tr, Ty, Ttau, TQ, Tv, TZ, blkSize);
+	graph.GenYAxpPx(2.0, TU, -1.0, perm_1_0_2_3, TUsa);
+
+	ComputeTQ(Tu, Tt, Tv, Ttau, Tq, TQ, blkSize, graph);
+	ComputeTP(Tu, Tr, Ttau, Tw, Tt, Tx, TP, blkSize, graph);
+	ComputeTH(Tvsa, Tt, TH, graph);
+	ComputeTF(TH, Tt, Trsa, Tvsa, TT, TF, graph);
+	ComputeTG(TH, Tt, Tusa, Tvsa, TT, TG, graph);
+	ComputeTz(TG, Tt, TUsa, TT, Twsa, TTsa, TH, Trsa, Ttau, Tz, graph);
+	ComputeTZ(TX, TT, TW, TTsa, TG, TF, TP, Tt, Tr, Ty, Ttau, TQ, Tv, TZ, blkSize, graph);
+
+	graph.Evaluate();
 
 	//END COMPUTATION
 
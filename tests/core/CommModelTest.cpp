@@ -0,0 +1,173 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+// NOTE: It is possible to simply include "rote.hpp" instead
+#include "rote.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace rote;
+
+void Usage(){
+  std::cout << "./CommModelTest [filename]\n"
+    << "Calibrates the communication model over small messages, checks every\n"
+    << "fitted latency and bandwidth is finite and positive, and reads the\n"
+    << "saved model back, directly and through ROTE_COMM_MODEL.  The model is\n"
+    << "written to filename (default rote_comm_model_test.txt).\n";
+}
+
+const RedistType fittedTypes[] = {A2A, AG, RS, Perm, AR};
+const Unsigned numFittedTypes = 5;
+
+bool Positive(const double x) {
+  return std::isfinite(x) && x > 0;
+}
+
+// Every grid-mode communicator with more than one process
+std::vector<ModeArray> CommModeSets(const ObjShape& gridShape) {
+  std::vector<ModeArray> sets;
+  for (Unsigned mask = 1; mask < (1u << gridShape.size()); mask++) {
+    ModeArray commModes;
+    Unsigned p = 1;
+    for (Unsigned i = 0; i < gridShape.size(); i++) {
+      if (mask & (1u << i)) {
+        commModes.push_back(i);
+        p *= gridShape[i];
+      }
+    }
+    if (p > 1) {
+      sets.push_back(commModes);
+    }
+  }
+  return sets;
+}
+
+// Rewrites the saved model with every latency doubled
+void DoubleLatencies(const std::string& filename) {
+  std::ifstream in(filename.c_str());
+  std::ostringstream out;
+  out.precision(10);
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream fields(line);
+    std::vector<std::string> words;
+    std::string word;
+    while (fields >> word) {
+      words.push_back(word);
+    }
+    if (words.size() > 0 && words[0] == "default") {
+      out << "default " << 2 * atof(words[1].c_str()) << " " << words[2] << " " << words[3] << "\n";
+    } else if (words.size() > 2 && words[0] == "fit") {
+      for (Unsigned i = 0; i < words.size() - 2; i++) {
+        out << words[i] << " ";
+      }
+      out << 2 * atof(words[words.size() - 2].c_str()) << " " << words.back() << "\n";
+    } else {
+      out << line << "\n";
+    }
+  }
+  in.close();
+  std::ofstream rewritten(filename.c_str());
+  rewritten << out.str();
+}
+
+bool Report(const char* name, const bool test, mpi::Comm comm) {
+  Unsigned rL = test ? 1 : 0;
+  Unsigned rG;
+  mpi::AllReduce(&rL, &rG, 1, mpi::LOGICAL_AND, comm);
+  if (rG != 1 && mpi::CommRank(comm) == 0) {
+    std::cout << "CommModel " << name << " FAILURE\n";
+  }
+  return rG == 1;
+}
+
+bool Close(const double x, const double y) {
+  return Abs(x - y) <= 1e-8 * Abs(y);
+}
+
+int
+main( int argc, char* argv[] )
+{
+  bool test = true;
+  Initialize(argc, argv);
+  mpi::Comm comm = mpi::COMM_WORLD;
+  const int p = mpi::CommSize(comm);
+
+  try
+  {
+    if (argc > 2) {
+      Usage();
+      throw ArgException();
+    }
+    const std::string filename = argc > 1 ? argv[1] : "rote_comm_model_test.txt";
+
+    ObjShape gShape(2, 1);
+    gShape[0] = p % 2 == 0 ? 2 : p;
+    gShape[1] = p / gShape[0];
+    const Grid g(comm, gShape);
+    const std::vector<ModeArray> commModeSets = CommModeSets(gShape);
+
+    CalibrateCommModel(g, filename, 4096);
+    const CommCostModel model = GetCommCostModel();
+    bool fitted = Positive(model.alpha) && Positive(model.beta) && Positive(model.gamma);
+    std::vector<CommFit> fits;
+    for (Unsigned i = 0; i < commModeSets.size(); i++) {
+      for (Unsigned t = 0; t < numFittedTypes; t++) {
+        CommFit fit;
+        fitted &= FindCommFit(gShape, commModeSets[i], fittedTypes[t], fit);
+        fitted &= Positive(fit.alpha) && Positive(fit.beta);
+        fits.push_back(fit);
+      }
+    }
+    test &= Report("calibration", fitted, comm);
+
+    // The default model comes back from the file
+    CommCostModel other = {1, 1, 1};
+    SetCommCostModel(other);
+    bool loaded = LoadCommModel(filename);
+    const CommCostModel& read = GetCommCostModel();
+    loaded &= Close(read.alpha, model.alpha) && Close(read.beta, model.beta) && Close(read.gamma, model.gamma);
+    test &= Report("load", loaded, comm);
+
+    // So do the fits, edited on disk to tell them from the calibrated ones
+    if (mpi::CommRank(comm) == 0) {
+      DoubleLatencies(filename);
+    }
+    mpi::Barrier(comm);
+    setenv("ROTE_COMM_MODEL", filename.c_str(), 1);
+    bool fromEnv = CommModelFilename() == filename && LoadCommModelFromEnv();
+    fromEnv &= Close(GetCommCostModel().alpha, 2 * model.alpha);
+    for (Unsigned i = 0; i < commModeSets.size(); i++) {
+      for (Unsigned t = 0; t < numFittedTypes; t++) {
+        CommFit fit;
+        const CommFit& calibrated = fits[i * numFittedTypes + t];
+        fromEnv &= FindCommFit(gShape, commModeSets[i], fittedTypes[t], fit);
+        fromEnv &= Close(fit.alpha, 2 * calibrated.alpha) && Close(fit.beta, calibrated.beta);
+      }
+    }
+    unsetenv("ROTE_COMM_MODEL");
+    fromEnv &= !LoadCommModelFromEnv();
+    test &= Report("load from ROTE_COMM_MODEL", fromEnv, comm);
+    test &= Report("missing file", !LoadCommModel(filename + ".missing"), comm);
+
+    if (mpi::CommRank(comm) == 0) {
+      std::remove(filename.c_str());
+    }
+  } catch( std::exception& e ) {
+    test = false;
+    ReportException(e);
+  }
+  if (mpi::CommRank(comm) == 0) {
+    std::cout << "CommModelTest: " << (test ? "SUCCESS" : "FAILURE") << "\n";
+  }
+  Finalize();
+  return 0;
+}
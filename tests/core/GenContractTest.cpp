@@ -12,7 +12,12 @@
 using namespace rote;
 
 void Usage(){
-    std::cout << "./GenContractTest <gridShape> <distA> <indicesA> <distB> <indicesB> <distC> <indicesC> <m-dim> <k-dim> <n-dim>\n";
+    std::cout << "./GenContractTest <gridShape> <distA> <indicesA> <distB> <indicesB> <distC> <indicesC> <m-dim> <k-dim> <n-dim>\n"
+      << "./GenContractTest\n"
+      << "With no arguments, runs the built-in cases on a 2x2 grid (4 processes),\n"
+      << "with and without pipelining, and checks each against a naive\n"
+      << "contraction of replicated copies, then checks three-operand\n"
+      << "contractions, a ContractSum and an ExprGraph.\n";
 }
 
 template<typename T>
@@ -318,13 +323,537 @@ void RunTest(const Grid& g, const Params& args){
 	}
 }
 
+// Extents of every index used by the built-in cases
+std::map<Index, Unsigned> SuiteDims(){
+    std::map<Index, Unsigned> dims;
+    dims['a'] = 5;
+    dims['b'] = 4;
+    dims['c'] = 3;
+    dims['d'] = 6;
+    dims['e'] = 3;
+    dims['i'] = 3;
+    dims['j'] = 7;
+    dims['m'] = 2;
+    return dims;
+}
+
+// Every mode replicated over the whole grid
+TensorDistribution ReplicatedDist(Unsigned order){
+    std::string dist = "[";
+    for(Unsigned i = 0; i < order; i++)
+        dist += i == 0 ? "()" : ",()";
+    return StringToTensorDist(dist + "]");
+}
+
+ObjShape SuiteShape(const std::string& indices, std::map<Index, Unsigned>& dims){
+    ObjShape shape(indices.size());
+    for(Unsigned i = 0; i < indices.size(); i++)
+        shape[i] = dims[indices[i]];
+    return shape;
+}
+
+// C = alpha A*B + beta C by looping over every index, independent of the
+// Gemm/Gett paths under test.  Indices of C are batch indices if they
+// appear in both A and B.
+template<typename T>
+void
+RefContract(T alpha, const Tensor<T>& A, const std::string& indA,
+            const Tensor<T>& B, const std::string& indB,
+            T beta, Tensor<T>& C, const std::string& indC,
+            std::map<Index, Unsigned>& dims)
+{
+    Unsigned i;
+    std::string indK;
+    for(i = 0; i < indA.size(); i++)
+        if(indC.find(indA[i]) == std::string::npos)
+            indK += indA[i];
+
+    const ObjShape shapeC = SuiteShape(indC, dims);
+    const ObjShape shapeK = SuiteShape(indK, dims);
+    const Unsigned nElemC = prod(shapeC);
+    //prod() of no extents is 0, but an outer product still sums one term
+    const Unsigned nElemK = indK.size() == 0 ? 1 : prod(shapeK);
+    std::map<Index, Unsigned> loc;
+    Location locA(indA.size()), locB(indB.size());
+    for(Unsigned c = 0; c < nElemC; c++){
+        const Location locC = LinearLoc2Loc(c, shapeC);
+        for(i = 0; i < indC.size(); i++)
+            loc[indC[i]] = locC[i];
+
+        T sum = 0;
+        for(Unsigned k = 0; k < nElemK; k++){
+            const Location locK = LinearLoc2Loc(k, shapeK);
+            for(i = 0; i < indK.size(); i++)
+                loc[indK[i]] = locK[i];
+            for(i = 0; i < indA.size(); i++)
+                locA[i] = loc[indA[i]];
+            for(i = 0; i < indB.size(); i++)
+                locB[i] = loc[indB[i]];
+            sum += A.Get(locA) * B.Get(locB);
+        }
+        C.Set(locC, alpha*sum + beta*C.Get(locC));
+    }
+}
+
+struct ContractCase{
+  std::string indA, distA;
+  std::string indB, distB;
+  std::string indC, distC;
+  Permutation permC;
+};
+
+// Records the variant as the tuned choice for this signature so Contract
+// runs it instead of the one the cost model picks
+template<typename T>
+void
+ForceVariant(const Grid& g, const ContractCase& c,
+             const DistTensor<T>& A, const DistTensor<T>& B, const DistTensor<T>& C,
+             ContractVariant variant, const std::vector<Unsigned>& blkSizes)
+{
+    const IndexArray indA(c.indA.begin(), c.indA.end());
+    const IndexArray indB(c.indB.begin(), c.indB.end());
+    const IndexArray indC(c.indC.begin(), c.indC.end());
+    ContractTuning tuning;
+    tuning.variant = variant;
+    tuning.blkSizes = blkSizes;
+    StoreContractTuning(ContractTuningKey(indA, A.Shape(), A.TensorDist(),
+                                          indB, B.Shape(), B.TensorDist(),
+                                          indC, C.Shape(), C.TensorDist(),
+                                          g, sizeof(T)), g, tuning);
+}
+
+// Runs one case with the given block size, as the given variant or (if
+// negative) the one the cost model picks, and returns whether every
+// process's entries of C match the reference
+template<typename T>
+bool
+RunCase(const Grid& g, const ContractCase& c, Unsigned blkSize, Int variant)
+{
+    std::map<Index, Unsigned> dims = SuiteDims();
+    const ObjShape shapeA = SuiteShape(c.indA, dims);
+    const ObjShape shapeB = SuiteShape(c.indB, dims);
+    const ObjShape shapeC = SuiteShape(c.indC, dims);
+    DistTensor<T> A(shapeA, c.distA, g);
+    DistTensor<T> B(shapeB, c.distB, g);
+    DistTensor<T> C(c.distC, g);
+    if(c.permC.size() != 0)
+        C.SetLocalPermutation(c.permC);
+    C.ResizeTo(shapeC);
+    MakeUniform(A);
+    MakeUniform(B);
+    MakeUniform(C);
+
+    DistTensor<T> checkA(shapeA, ReplicatedDist(A.Order()), g);
+    DistTensor<T> checkB(shapeB, ReplicatedDist(B.Order()), g);
+    DistTensor<T> checkC(shapeC, ReplicatedDist(C.Order()), g);
+    checkA.RedistFrom(A);
+    checkB.RedistFrom(B);
+    checkC.RedistFrom(C);
+
+    const T alpha = 1.5;
+    const T beta = 0.5;
+    const std::vector<Unsigned> blkSizes(dims.size(), blkSize);
+    if(variant < 0){
+        Contract<T>::run(alpha, A, c.indA, B, c.indB, beta, C, c.indC, blkSizes);
+    }else{
+        const bool autotuning = ContractAutotuning();
+        ForceVariant(g, c, A, B, C, (ContractVariant)variant, blkSizes);
+        SetContractAutotuning(true);
+        Contract<T>::run(alpha, A, c.indA, B, c.indB, beta, C, c.indC, std::vector<Unsigned>());
+        SetContractAutotuning(autotuning);
+        ClearContractTuning();
+    }
+    RefContract(alpha, checkA.LockedTensor(), c.indA, checkB.LockedTensor(), c.indB,
+                beta, checkC.Tensor(), c.indC, dims);
+
+    DistTensor<T> finalC(shapeC, ReplicatedDist(C.Order()), g);
+    finalC.RedistFrom(C);
+    const Tensor<T>& out = finalC.LockedTensor();
+    const Tensor<T>& check = checkC.LockedTensor();
+    Unsigned rL = 1;
+    for(Unsigned i = 0; i < prod(shapeC); i++){
+        const Location loc = LinearLoc2Loc(i, shapeC);
+        if(Abs(out.Get(loc) - check.Get(loc)) > 1e-10 * (1 + Abs(check.Get(loc))))
+            rL = 0;
+    }
+    Unsigned rG;
+    mpi::AllReduce(&rL, &rG, 1, mpi::LOGICAL_AND, g.OwningComm());
+    if(rG != 1 && mpi::CommRank(g.OwningComm()) == 0)
+        std::cout << c.indC << "=" << c.indA << "*" << c.indB << " C" << c.distC
+                  << " A" << c.distA << " B" << c.distB << " blkSize " << blkSize
+                  << " variant " << variant
+                  << (ContractPipelining() ? " pipelined" : "") << " FAILURE\n";
+    return rG == 1;
+}
+
+// Runs the ExprGraph calls directly, for reference
+template<typename T>
+struct EagerOps{
+    std::vector<std::shared_ptr<DistTensor<T> > > temps;
+
+    DistTensor<T>& Temporary(const ObjShape& shape, const TensorDistribution& dist, const Grid& g){
+        temps.push_back(std::shared_ptr<DistTensor<T> >(new DistTensor<T>(shape, dist, g)));
+        return *temps.back();
+    }
+    void GenContract(T alpha, const DistTensor<T>& A, const std::string& indA,
+                     const DistTensor<T>& B, const std::string& indB,
+                     T beta, DistTensor<T>& C, const std::string& indC,
+                     const std::vector<Unsigned>& blkSizes = std::vector<Unsigned>(0)){
+        rote::GenContract(alpha, A, indA, B, indB, beta, C, indC, blkSizes);
+    }
+    void YAxpBy(T alpha, const DistTensor<T>& X, T beta, DistTensor<T>& Y){
+        rote::YAxpBy(alpha, X, beta, Y);
+    }
+};
+
+// Terms sharing operands with each other, updating the same output in a
+// row, reading an operand after it is updated, and writing a temporary
+template<typename T, typename Ops>
+void
+ExprSequence(Ops& ops, const DistTensor<T>& V, const DistTensor<T>& W, DistTensor<T>& U,
+             DistTensor<T>& X1, DistTensor<T>& X2, DistTensor<T>& X3)
+{
+    ops.GenContract(T(1), V, "ae", W, "eb", T(0), X1, "ab");
+    ops.GenContract(T(2), V, "ae", W, "eb", T(0), X2, "ab");
+    ops.GenContract(T(1), V, "ae", U, "eb", T(1), X1, "ab");
+    ops.YAxpBy(T(1), W, T(1), U);
+    ops.GenContract(T(-1), V, "ae", U, "eb", T(0.5), X3, "ab");
+    DistTensor<T>& t = ops.Temporary(X3.Shape(), X3.TensorDist(), X3.Grid());
+    ops.GenContract(T(1), V, "ae", W, "eb", T(0), t, "ab");
+    ops.YAxpBy(T(1), t, T(1), X3);
+    ops.GenContract(T(1), V, "ae", U, "eb", T(1), X2, "ab", std::vector<Unsigned>(1, 2));
+}
+
+// Checks an ExprGraph evaluation of ExprSequence against running it directly
+bool TestExprGraph(const Grid& g){
+    std::map<Index, Unsigned> dims = SuiteDims();
+    const ObjShape shapeAE = SuiteShape("ae", dims);
+    const ObjShape shapeEB = SuiteShape("eb", dims);
+    const ObjShape shapeAB = SuiteShape("ab", dims);
+    DistTensor<double> V(shapeAE, "[(0),(1)]", g);
+    DistTensor<double> W(shapeEB, "[(1),(0)]", g);
+    DistTensor<double> U(shapeEB, "[(1),(0)]", g);
+    MakeUniform(V);
+    MakeUniform(W);
+    MakeUniform(U);
+
+    std::vector<DistTensor<double> > eager(3, DistTensor<double>(shapeAB, "[(0),(1)]", g));
+    for(Unsigned i = 0; i < eager.size(); i++)
+        MakeUniform(eager[i]);
+    std::vector<DistTensor<double> > deferred(eager);
+    DistTensor<double> eagerU(U);
+
+    EagerOps<double> ops;
+    ExprSequence<double>(ops, V, W, eagerU, eager[0], eager[1], eager[2]);
+    ExprGraph<double> graph;
+    ExprSequence<double>(graph, V, W, U, deferred[0], deferred[1], deferred[2]);
+    graph.Evaluate();
+
+    bool test = true;
+    for(Unsigned i = 0; i < eager.size(); i++){
+        DistTensor<double> diff(eager[i]);
+        YAxpBy(-1.0, deferred[i], 1.0, diff);
+        test &= Norm(diff) <= 1e-10 * (1 + Norm(eager[i]));
+    }
+    DistTensor<double> diff(eagerU);
+    YAxpBy(-1.0, U, 1.0, diff);
+    test &= Norm(diff) <= 1e-10 * (1 + Norm(eagerU));
+    if(!test && mpi::CommRank(g.OwningComm()) == 0)
+        std::cout << "ExprGraph FAILURE\n";
+    return test;
+}
+
+struct SumTerm{
+    double alpha;
+    const DistTensor<double>* A;
+    std::string indA;
+    const DistTensor<double>* B;
+    std::string indB;
+};
+
+// Checks ContractSum against the equivalent GenContract calls, with terms
+// sharing an intermediate, terms needing their own, and no terms at all.
+// Under the memory limits, the k terms (or all terms) are contracted directly
+bool TestContractSum(const Grid& g){
+    std::map<Index, Unsigned> dims = SuiteDims();
+    dims['k'] = 64;
+    DistTensor<double> V(SuiteShape("ae", dims), "[(0),(1)]", g);
+    DistTensor<double> W(SuiteShape("eb", dims), "[(1),(0)]", g);
+    DistTensor<double> U(SuiteShape("eb", dims), "[(1),(0)]", g);
+    DistTensor<double> P(SuiteShape("aj", dims), "[(1),(0)]", g);
+    DistTensor<double> Q(SuiteShape("jb", dims), "[(0),(1)]", g);
+    DistTensor<double> K(SuiteShape("ak", dims), "[(0),(1)]", g);
+    DistTensor<double> L(SuiteShape("kb", dims), "[(1),(0)]", g);
+    MakeUniform(V);
+    MakeUniform(W);
+    MakeUniform(U);
+    MakeUniform(P);
+    MakeUniform(Q);
+    MakeUniform(K);
+    MakeUniform(L);
+
+    const SumTerm terms[] = {
+        {1.0, &K, "ak", &L, "kb"},
+        {2.0, &V, "ae", &W, "eb"},
+        {-1.0, &V, "ae", &U, "eb"},
+        {0.5, &P, "aj", &Q, "jb"},
+        {1.5, &L, "kb", &K, "ak"}
+    };
+    const Unsigned nTerms = sizeof(terms) / sizeof(terms[0]);
+    const double beta = 0.5;
+    const std::size_t limit = ContractMemoryLimit();
+    const std::size_t limits[] = {0, 512, 1};
+
+    bool test = true;
+    for(Unsigned l = 0; l < 3; l++){
+        SetContractMemoryLimit(limits[l]);
+        for(Unsigned n = 0; n <= nTerms; n += nTerms){
+            DistTensor<double> eager(SuiteShape("ab", dims), "[(0),(1)]", g);
+            MakeUniform(eager);
+            DistTensor<double> summed(eager);
+
+            ContractSum<double> sum(beta, summed, "ab");
+            for(Unsigned i = 0; i < n; i++){
+                const SumTerm& t = terms[i];
+                sum.Add(t.alpha, *t.A, t.indA, *t.B, t.indB);
+                GenContract(t.alpha, *t.A, t.indA, *t.B, t.indB, i == 0 ? beta : 1.0, eager, "ab");
+            }
+            sum.Finish();
+            if(n == 0)
+                Scal(beta, eager);
+
+            DistTensor<double> diff(eager);
+            YAxpBy(-1.0, summed, 1.0, diff);
+            const bool pass = Norm(diff) <= 1e-10 * (1 + Norm(eager));
+            if(!pass && mpi::CommRank(g.OwningComm()) == 0)
+                std::cout << "ContractSum of " << n << " terms, limit " << limits[l] << " FAILURE\n";
+            test &= pass;
+        }
+    }
+    SetContractMemoryLimit(limit);
+    return test;
+}
+
+struct PathCase{
+  std::string indA, distA;
+  std::string indB, distB;
+  std::string indC, distC;
+  std::string indD, distD;
+};
+
+// Checks D = alpha A*B*C + beta D, contracted in the order Contract picks,
+// against contracting A*B and then with C naively
+bool RunPathCase(const Grid& g, const PathCase& c){
+    std::map<Index, Unsigned> dims = SuiteDims();
+    const ObjShape shapeA = SuiteShape(c.indA, dims);
+    const ObjShape shapeB = SuiteShape(c.indB, dims);
+    const ObjShape shapeC = SuiteShape(c.indC, dims);
+    const ObjShape shapeD = SuiteShape(c.indD, dims);
+    DistTensor<double> A(shapeA, c.distA, g);
+    DistTensor<double> B(shapeB, c.distB, g);
+    DistTensor<double> C(shapeC, c.distC, g);
+    DistTensor<double> D(shapeD, c.distD, g);
+    MakeUniform(A);
+    MakeUniform(B);
+    MakeUniform(C);
+    MakeUniform(D);
+
+    DistTensor<double> checkA(shapeA, ReplicatedDist(A.Order()), g);
+    DistTensor<double> checkB(shapeB, ReplicatedDist(B.Order()), g);
+    DistTensor<double> checkC(shapeC, ReplicatedDist(C.Order()), g);
+    DistTensor<double> checkD(shapeD, ReplicatedDist(D.Order()), g);
+    checkA.RedistFrom(A);
+    checkB.RedistFrom(B);
+    checkC.RedistFrom(C);
+    checkD.RedistFrom(D);
+
+    const double alpha = 1.5;
+    const double beta = 0.5;
+    std::vector<ContractOperand<double> > operands;
+    operands.push_back(ContractOperand<double>(A, c.indA));
+    operands.push_back(ContractOperand<double>(B, c.indB));
+    operands.push_back(ContractOperand<double>(C, c.indC));
+    Contract<double>::run(alpha, operands, beta, D, c.indD);
+
+    //Every index is in exactly two tensors, so A*B keeps those of C and D
+    std::string indAB;
+    const std::string indAll = c.indA + c.indB;
+    for(Unsigned i = 0; i < indAll.size(); i++)
+        if((c.indC + c.indD).find(indAll[i]) != std::string::npos && indAB.find(indAll[i]) == std::string::npos)
+            indAB += indAll[i];
+    Tensor<double> AB(SuiteShape(indAB, dims));
+    Zero(AB);
+    RefContract(1.0, checkA.LockedTensor(), c.indA, checkB.LockedTensor(), c.indB,
+                0.0, AB, indAB, dims);
+    RefContract(alpha, AB, indAB, checkC.LockedTensor(), c.indC,
+                beta, checkD.Tensor(), c.indD, dims);
+
+    DistTensor<double> finalD(shapeD, ReplicatedDist(D.Order()), g);
+    finalD.RedistFrom(D);
+    const Tensor<double>& out = finalD.LockedTensor();
+    const Tensor<double>& check = checkD.LockedTensor();
+    Unsigned rL = 1;
+    for(Unsigned i = 0; i < prod(shapeD); i++){
+        const Location loc = LinearLoc2Loc(i, shapeD);
+        if(Abs(out.Get(loc) - check.Get(loc)) > 1e-10 * (1 + Abs(check.Get(loc))))
+            rL = 0;
+    }
+    Unsigned rG;
+    mpi::AllReduce(&rL, &rG, 1, mpi::LOGICAL_AND, g.OwningComm());
+    if(rG != 1 && mpi::CommRank(g.OwningComm()) == 0)
+        std::cout << c.indD << "=" << c.indA << "*" << c.indB << "*" << c.indC << " FAILURE\n";
+    return rG == 1;
+}
+
+bool RunSuite(const Grid& g){
+    std::vector<ContractCase> cases;
+    ContractCase c;
+
+    // A contracted index between two uncontracted ones (used to segfault)
+    c.indA = "aecb"; c.distA = "[(0),(),(1),()]";
+    c.indB = "ced";  c.distB = "[(),(1),(0)]";
+    c.indC = "abd";  c.distC = "[(0),(),(1)]";
+    cases.push_back(c);
+
+    // Batch index i, distributed and kept in A, B and C
+    c.indA = "aei";  c.distA = "[(0),(),(1)]";
+    c.indB = "ebi";  c.distB = "[(),(),(1)]";
+    c.indC = "abi";  c.distC = "[(0),(),(1)]";
+    cases.push_back(c);
+
+    // Two batch indices, one not distributed
+    c.indA = "aeij"; c.distA = "[(0),(),(1),()]";
+    c.indB = "ebij"; c.distB = "[(),(),(1),()]";
+    c.indC = "abij"; c.distC = "[(0),(),(1),()]";
+    cases.push_back(c);
+
+    // Operands whose index order is not a matrix layout, so the local
+    // contraction goes through Gett rather than Gemm
+    c.indA = "ca";   c.distA = "[(0,1),()]";
+    c.indB = "bc";   c.distB = "[(),(0)]";
+    c.indC = "ab";   c.distC = "[(1),(0)]";
+    cases.push_back(c);
+
+    c.indA = "jiae"; c.distA = "[(0,1),(),(),()]";
+    c.indB = "ebji"; c.distB = "[(),(),(1),(0)]";
+    c.indC = "aijb"; c.distC = "[(1),(),(0),()]";
+    cases.push_back(c);
+
+    // C stored in a local permutation of its own
+    c.indA = "aeim"; c.distA = "[(0),(),(1),()]";
+    c.indB = "ebmj"; c.distB = "[(),(),(),(1)]";
+    c.indC = "abij"; c.distC = "[(0),(),(1),()]";
+    c.permC = Permutation({2, 0, 1, 3});
+    cases.push_back(c);
+
+    // C replicated over one or both grid modes, which Stat25D splits a
+    // contracted index over
+    std::vector<ContractCase> replicatedCases;
+    c.permC = Permutation();
+    c.indA = "ae";   c.distA = "[(0),(1)]";
+    c.indB = "eb";   c.distB = "[(1),()]";
+    c.indC = "ab";   c.distC = "[(0),()]";
+    replicatedCases.push_back(c);
+
+    c.indA = "ae";   c.distA = "[(0),(1)]";
+    c.indB = "eb";   c.distB = "[(1),(0)]";
+    c.indC = "ab";   c.distC = "[(),()]";
+    replicatedCases.push_back(c);
+
+    c.indA = "aeim"; c.distA = "[(0),(),(),(1)]";
+    c.indB = "ebmj"; c.distB = "[(),(),(1),()]";
+    c.indC = "abij"; c.distC = "[(0),(),(),()]";
+    replicatedCases.push_back(c);
+
+    c.permC = Permutation({2, 0, 1, 3});
+    replicatedCases.push_back(c);
+
+    c.permC = Permutation();
+    c.indA = "aei";  c.distA = "[(0),(1),()]";
+    c.indB = "ebi";  c.distB = "[(1),(),()]";
+    c.indC = "abi";  c.distC = "[(0),(),()]";
+    replicatedCases.push_back(c);
+
+    // Every case runs as the modeled best variant and as each stationary
+    // variant, with the blocked loops both sequential and double-buffered
+    bool test = true;
+    const bool pipelining = ContractPipelining();
+    const Unsigned blkSizes[2] = {2, 32};
+    const Int variants[5] = {-1, StatA, StatB, StatC, Stat25D};
+    for(Unsigned p = 0; p < 2; p++){
+        SetContractPipelining(p == 1);
+        for(Unsigned j = 0; j < 2; j++){
+            for(Unsigned i = 0; i < cases.size(); i++)
+                for(Unsigned v = 0; v < 4; v++)
+                    test &= RunCase<double>(g, cases[i], blkSizes[j], variants[v]);
+            for(Unsigned i = 0; i < replicatedCases.size(); i++)
+                for(Unsigned v = 0; v < 5; v++)
+                    test &= RunCase<double>(g, replicatedCases[i], blkSizes[j], variants[v]);
+        }
+    }
+    SetContractPipelining(pipelining);
+
+    // Three operands: a chain, a chain whose cheapest first pair is not
+    // the first two operands, and higher-order operands
+    std::vector<PathCase> pathCases;
+    PathCase pc;
+    pc.indA = "ae";   pc.distA = "[(0),(1)]";
+    pc.indB = "ec";   pc.distB = "[(1),(0)]";
+    pc.indC = "cb";   pc.distC = "[(0),(1)]";
+    pc.indD = "ab";   pc.distD = "[(0),(1)]";
+    pathCases.push_back(pc);
+
+    pc.indA = "ad";   pc.distA = "[(0),(1)]";
+    pc.indB = "jb";   pc.distB = "[(1),(0)]";
+    pc.indC = "dj";   pc.distC = "[(0),(1)]";
+    pc.indD = "ab";   pc.distD = "[(1),(0)]";
+    pathCases.push_back(pc);
+
+    pc.indA = "ae";   pc.distA = "[(0),(1)]";
+    pc.indB = "ebmj"; pc.distB = "[(),(0),(1),()]";
+    pc.indC = "mi";   pc.distC = "[(1),(0)]";
+    pc.indD = "abij"; pc.distD = "[(0),(),(1),()]";
+    pathCases.push_back(pc);
+
+    for(Unsigned i = 0; i < pathCases.size(); i++)
+        test &= RunPathCase(g, pathCases[i]);
+
+    test &= TestContractSum(g);
+    test &= TestExprGraph(g);
+
+    //Every unblocked term over the limit runs as a blocked Contract
+    const std::size_t limit = ContractMemoryLimit();
+    SetContractMemoryLimit(1);
+    test &= TestExprGraph(g);
+    SetContractMemoryLimit(limit);
+    return test;
+}
+
 int
 main( int argc, char* argv[] )
 {
     Initialize( argc, argv );
+    mpi::Comm comm = mpi::COMM_WORLD;
+    if(argc == 1){
+        bool test = false;
+        try
+        {
+            if(mpi::CommSize(comm) != 4){
+                Usage();
+                throw ArgException();
+            }
+            const Grid g(comm, ObjShape(2, 2));
+            test = RunSuite(g);
+        }
+        catch( std::exception& e ) { ReportException(e); }
+        if(mpi::CommRank(comm) == 0)
+            std::cout << "GenContractTest: " << (test ? "SUCCESS" : "FAILURE") << "\n";
+        Finalize();
+        return 0;
+    }
+
     Params args;
     ProcessInput(argc, argv, args);
-    mpi::Comm comm = mpi::COMM_WORLD;
     try
     {
     	const Grid g(comm, args.gShape);
@@ -0,0 +1,127 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+// NOTE: It is possible to simply include "rote.hpp" instead
+#include "rote.hpp"
+#include <iostream>
+
+using namespace rote;
+
+void Usage(){
+  std::cout << "./LocalReduceTest\n"
+    << "Reduces local tensors large enough to be split across OpenMP threads\n"
+    << "in hybrid builds (run with OMP_NUM_THREADS > 1) and checks the sums\n"
+    << "against a serial reference on every process.\n";
+}
+
+struct ReduceCase {
+  ObjShape shape;
+  ModeArray reduceModes;
+};
+
+// B keeps A's order with the reduced modes of extent 1
+template<typename T>
+bool TestLocalReduce(const ReduceCase& c) {
+  const T alpha = T(3);
+  Tensor<T> A(c.shape);
+  T* bufA = A.Buffer();
+  const Unsigned nElemA = prod(c.shape);
+  for (Unsigned i = 0; i < nElemA; i++) {
+    bufA[i] = T(i % 7 + 1);
+  }
+
+  ObjShape shapeB = c.shape;
+  for (Unsigned i = 0; i < c.reduceModes.size(); i++) {
+    shapeB[c.reduceModes[i]] = 1;
+  }
+  Tensor<T> B(shapeB);
+  Zero(B);
+  LocalReduce(alpha, A, B, c.reduceModes);
+
+  // Serial reference, walking A in storage order
+  const std::vector<Unsigned> stridesB = Dimensions2Strides(shapeB);
+  std::vector<T> check(prod(shapeB), T(0));
+  Location loc(c.shape.size(), 0);
+  for (Unsigned i = 0; i < nElemA; i++) {
+    Unsigned offB = 0;
+    for (Unsigned j = 0; j < loc.size(); j++) {
+      if (shapeB[j] > 1) {
+        offB += loc[j] * stridesB[j];
+      }
+    }
+    check[offB] += alpha * bufA[i];
+
+    for (Unsigned j = 0; j < loc.size(); j++) {
+      if (++loc[j] < c.shape[j]) {
+        break;
+      }
+      loc[j] = 0;
+    }
+  }
+
+  // Lost updates drop whole partial sums, far above float rounding
+  const T* bufB = B.LockedBuffer();
+  for (Unsigned i = 0; i < check.size(); i++) {
+    if (Abs(double(bufB[i]) - double(check[i])) > 1e-4 * Abs(double(check[i]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int
+main( int argc, char* argv[] )
+{
+  bool test = true;
+  Initialize(argc, argv);
+  mpi::Comm comm = mpi::COMM_WORLD;
+
+  try
+  {
+    if (argc > 1) {
+      Usage();
+      throw ArgException();
+    }
+
+    // Whole-tensor sums (the destination has stride 0 in every loop mode),
+    // partial sums along inner and outer modes, and several reduced modes
+    std::vector<ReduceCase> cases(5);
+    cases[0].shape = {1 << 24, 1};
+    cases[0].reduceModes = {0};
+    cases[1].shape = {256, 4096};
+    cases[1].reduceModes = {0};
+    cases[2].shape = {4096, 256};
+    cases[2].reduceModes = {1};
+    cases[3].shape = {16, 16, 4096};
+    cases[3].reduceModes = {0, 1};
+    cases[4].shape = {64, 3, 512, 2};
+    cases[4].reduceModes = {0, 2, 3};
+
+    for (Unsigned i = 0; i < cases.size(); i++) {
+      bool caseTest = TestLocalReduce<double>(cases[i]);
+      caseTest &= TestLocalReduce<float>(cases[i]);
+      caseTest &= TestLocalReduce<Int>(cases[i]);
+
+      Unsigned rL = caseTest ? 1 : 0;
+      Unsigned rG;
+      mpi::AllReduce(&rL, &rG, 1, mpi::LOGICAL_AND, comm);
+      if (rG != 1 && mpi::CommRank(comm) == 0) {
+        std::cout << "LocalReduce case " << i << " FAILURE\n";
+      }
+      test &= rG == 1;
+    }
+  } catch( std::exception& e ) {
+    test = false;
+    ReportException(e);
+  }
+  if (mpi::CommRank(comm) == 0) {
+    std::cout << "LocalReduceTest: " << (test ? "SUCCESS" : "FAILURE") << "\n";
+  }
+  Finalize();
+  return 0;
+}
@@ -0,0 +1,110 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+// NOTE: It is possible to simply include "rote.hpp" instead
+#include "rote.hpp"
+#include <iostream>
+
+using namespace rote;
+
+void Usage(){
+  std::cout << "./NodeCommTest <ranksPerNode> [maxCount] [reps]\n"
+    << "Checks the node-aware AllToAll and AllGather against the flat\n"
+    << "collectives over MPI_COMM_WORLD and times both for per-process\n"
+    << "counts 1, 4, 16, ... up to maxCount (default 65536) doubles.\n"
+    << "ranksPerNode > 0 emulates nodes of that many consecutive ranks.\n";
+}
+
+// Seconds per call of the flat (node == 0) or node-aware collective, the
+// slowest process's time
+double TimeAllToAll(NodeComm* node, const std::vector<double>& sbuf, const int sc, std::vector<double>& rbuf, const int reps){
+  mpi::Barrier(mpi::COMM_WORLD);
+  const double start = mpi::Time();
+  for(int rep = 0; rep < reps; rep++){
+    if(node)
+      node->AllToAll(&(sbuf[0]), sc, &(rbuf[0]));
+    else
+      mpi::AllToAll(&(sbuf[0]), sc, &(rbuf[0]), sc, mpi::COMM_WORLD);
+  }
+  return mpi::AllReduce((mpi::Time() - start) / reps, mpi::MAX, mpi::COMM_WORLD);
+}
+
+double TimeAllGather(NodeComm* node, const std::vector<double>& sbuf, const int sc, std::vector<double>& rbuf, const int reps){
+  mpi::Barrier(mpi::COMM_WORLD);
+  const double start = mpi::Time();
+  for(int rep = 0; rep < reps; rep++){
+    if(node)
+      node->AllGather(&(sbuf[0]), sc, &(rbuf[0]));
+    else
+      mpi::AllGather(&(sbuf[0]), sc, &(rbuf[0]), sc, mpi::COMM_WORLD);
+  }
+  return mpi::AllReduce((mpi::Time() - start) / reps, mpi::MAX, mpi::COMM_WORLD);
+}
+
+bool Agree(const std::vector<double>& flat, const std::vector<double>& node){
+  Unsigned rL = flat == node ? 1 : 0;
+  Unsigned rG;
+  mpi::AllReduce(&rL, &rG, 1, mpi::LOGICAL_AND, mpi::COMM_WORLD);
+  return rG == 1;
+}
+
+int
+main( int argc, char* argv[] )
+{
+  bool test = true;
+  Initialize(argc, argv);
+  mpi::Comm comm = mpi::COMM_WORLD;
+  const int rank = mpi::CommRank(comm);
+  const int p = mpi::CommSize(comm);
+
+  try
+  {
+    if (argc < 2) {
+      Usage();
+      throw ArgException();
+    }
+    const int ranksPerNode = atoi(argv[1]);
+    const int maxCount = argc > 2 ? atoi(argv[2]) : 65536;
+    const int reps = argc > 3 ? atoi(argv[3]) : 10;
+
+    NodeComm node(comm, ranksPerNode);
+    if (rank == 0) {
+      std::cout << "NodeCommTest: " << p << " processes on " << node.NumNodes() << " nodes\n";
+      std::cout << "op\tcount\tflat(s)\tnode(s)\tspeedup\n";
+    }
+
+    for (int sc = 1; sc <= maxCount; sc *= 4) {
+      std::vector<double> sbuf(std::size_t(p) * sc);
+      for (std::size_t i = 0; i < sbuf.size(); i++) {
+        sbuf[i] = double(rank) * sbuf.size() + i;
+      }
+      std::vector<double> flatBuf(sbuf.size()), nodeBuf(sbuf.size());
+
+      const double flatA2A = TimeAllToAll(0, sbuf, sc, flatBuf, reps);
+      const double nodeA2A = TimeAllToAll(&node, sbuf, sc, nodeBuf, reps);
+      test &= Agree(flatBuf, nodeBuf);
+
+      const double flatAG = TimeAllGather(0, sbuf, sc, flatBuf, reps);
+      const double nodeAG = TimeAllGather(&node, sbuf, sc, nodeBuf, reps);
+      test &= Agree(flatBuf, nodeBuf);
+
+      if (rank == 0) {
+        std::cout << "A2A\t" << sc << "\t" << flatA2A << "\t" << nodeA2A << "\t" << flatA2A / nodeA2A << "\n";
+        std::cout << "AG\t" << sc << "\t" << flatAG << "\t" << nodeAG << "\t" << flatAG / nodeAG << "\n";
+      }
+    }
+  } catch( std::exception& e ) {
+    test = false;
+    ReportException(e);
+  }
+  if (rank == 0) {
+    std::cout << "NodeCommTest: " << (test ? "SUCCESS" : "FAILURE") << "\n";
+  }
+  Finalize();
+  return 0;
+}
@@ -0,0 +1,228 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+// NOTE: It is possible to simply include "rote.hpp" instead
+#include "rote.hpp"
+#include <iostream>
+
+using namespace rote;
+
+void Usage(){
+  std::cout << "./RedistCacheTest\n"
+    << "Redistributes with the result cache on, writing the source in every\n"
+    << "way that must invalidate the kept copies, and checks each result.\n"
+    << "Also checks that views, and the partition views redistributed by a\n"
+    << "repeated blocked GenContract, are served from the kept copies.\n";
+}
+
+// Entry of the source at l after it has been written gen times
+double Entry(const Location& l, const ObjShape& s, const Unsigned gen) {
+  return Loc2LinearLoc(l, s) + 1000.0 * gen;
+}
+
+void Fill(DistTensor<double>& A, const Unsigned gen) {
+  const ObjShape s = A.Shape();
+  for (Unsigned i = 0; i < prod(s); i++) {
+    const Location l = LinearLoc2Loc(i, s);
+    A.Set(l, Entry(l, s, gen));
+  }
+}
+
+// Whether B holds the entries of a source written gen times, except (if
+// given) the entry at loc, which must be u
+bool Check(const DistTensor<double>& B, const Unsigned gen, const Location& loc = Location(), const double u = 0) {
+  bool test = true;
+  const ObjShape s = B.Shape();
+  for (Unsigned i = 0; i < prod(s); i++) {
+    const Location l = LinearLoc2Loc(i, s);
+    const double check = l == loc ? u : Entry(l, s, gen);
+    test &= B.Get(l) == check;
+  }
+  return test;
+}
+
+// Whether B holds the part of a source of shape s written gen times that
+// starts at offset
+bool CheckPart(const DistTensor<double>& B, const Unsigned gen, const ObjShape& s, const Location& offset) {
+  bool test = true;
+  const ObjShape sB = B.Shape();
+  for (Unsigned i = 0; i < prod(sB); i++) {
+    const Location l = LinearLoc2Loc(i, sB);
+    Location lA = l;
+    for (Unsigned j = 0; j < l.size(); j++) {
+      lA[j] += offset[j];
+    }
+    test &= B.Get(l) == Entry(lA, s, gen);
+  }
+  return test;
+}
+
+// Get is collective, so every process visits every entry
+bool Equal(const DistTensor<double>& X, const DistTensor<double>& Y) {
+  bool test = true;
+  const ObjShape s = X.Shape();
+  for (Unsigned i = 0; i < prod(s); i++) {
+    const Location l = LinearLoc2Loc(i, s);
+    test &= Abs(X.Get(l) - Y.Get(l)) <= 1e-12 * (1 + Abs(Y.Get(l)));
+  }
+  return test;
+}
+
+bool Report(const char* name, const bool test, mpi::Comm comm) {
+  Unsigned rL = test ? 1 : 0;
+  Unsigned rG;
+  mpi::AllReduce(&rL, &rG, 1, mpi::LOGICAL_AND, comm);
+  if (rG != 1 && mpi::CommRank(comm) == 0) {
+    std::cout << "RedistCache " << name << " FAILURE\n";
+  }
+  return rG == 1;
+}
+
+int
+main( int argc, char* argv[] )
+{
+  bool test = true;
+  Initialize(argc, argv);
+  mpi::Comm comm = mpi::COMM_WORLD;
+  const int rank = mpi::CommRank(comm);
+  const int p = mpi::CommSize(comm);
+
+  try
+  {
+    if (argc > 1) {
+      Usage();
+      throw ArgException();
+    }
+
+    ObjShape gShape(2, 1);
+    gShape[0] = p % 2 == 0 ? 2 : p;
+    gShape[1] = p / gShape[0];
+    const Grid g(comm, gShape);
+    const ObjShape shape = {7, 6};
+    const Location loc = {3, 4};
+    SetRedistResultCacheLimit(1 << 20);
+
+    DistTensor<double> A(shape, "[(0),(1)]", g);
+    DistTensor<double> B(shape, "[(1),(0)]", g);
+    Fill(A, 0);
+    B.RedistFrom(A);
+    test &= Report("first redistribution", Check(B, 0), comm);
+
+    // Repeats are served from the cache
+    DistTensor<double> B2(shape, "[(1),(0)]", g);
+    B2.RedistFrom(A);
+    B.RedistFrom(A);
+    test &= Report("repeat", Check(B, 0) && Check(B2, 0), comm);
+
+    // Writing B must not touch the kept copy
+    Fill(B, 5);
+    B.RedistFrom(A);
+    test &= Report("written target", Check(B, 0), comm);
+
+    // Set changes only the owner's version
+    A.Set(loc, -1);
+    B.RedistFrom(A);
+    test &= Report("Set", Check(B, 0, loc, -1), comm);
+
+    // A write through the local tensor of one process
+    Fill(A, 1);
+    B.RedistFrom(A);
+    if (rank == 0 && A.Participating()) {
+      Tensor<double>& local = A.Tensor();
+      local.Set(Location(2, 0), -2);
+    }
+    B.RedistFrom(A);
+    test &= Report("local write", Check(B, 1, Location(2, 0), -2), comm);
+
+    // A write through a view shares the source's version
+    Fill(A, 2);
+    B.RedistFrom(A);
+    {
+      DistTensor<double> V(A.TensorDist(), g);
+      View(V, A);
+      V.Set(loc, -3);
+    }
+    B.RedistFrom(A);
+    test &= Report("view write", Check(B, 2, loc, -3), comm);
+
+    // Targets laid out differently get their own copies
+    Fill(A, 3);
+    B.RedistFrom(A);
+    DistTensor<double> BP(B.TensorDist(), g);
+    BP.SetLocalPermutation(Permutation({1, 0}));
+    BP.ResizeTo(shape);
+    BP.RedistFrom(A);
+    const std::vector<Unsigned> aligns = {1 % gShape[1], 1 % gShape[0]};
+    DistTensor<double> BA(shape, "[(1),(0)]", aligns, g);
+    BA.RedistFrom(A);
+    test &= Report("other layouts", Check(BP, 3) && Check(BA, 3), comm);
+
+    // A new source, possibly at a freed source's address
+    for (Unsigned gen = 4; gen < 6; gen++) {
+      DistTensor<double> S(shape, "[(0),(1)]", g);
+      Fill(S, gen);
+      B.RedistFrom(S);
+      test &= Report("new source", Check(B, gen), comm);
+    }
+
+    // Views are kept by the part of the source they cover
+    Fill(A, 7);
+    const ObjShape partShape = {4, 6};
+    const Location top = {0, 0}, bottom = {3, 0};
+    DistTensor<double> BT(partShape, "[(1),(0)]", g), BB(partShape, "[(1),(0)]", g);
+    {
+      DistTensor<double> V(A.TensorDist(), g);
+      LockedView(V, A, top, partShape);
+      BT.RedistFrom(V);
+      LockedView(V, A, bottom, partShape);
+      BB.RedistFrom(V);
+    }
+    bool views = CheckPart(BT, 7, shape, top) && CheckPart(BB, 7, shape, bottom);
+    std::size_t hits = RedistResultHits();
+    {
+      DistTensor<double> V(A.TensorDist(), g);
+      LockedView(V, A, bottom, partShape);
+      BB.RedistFrom(V);
+      views &= RedistResultHits() == hits + 1 && CheckPart(BB, 7, shape, bottom);
+      // A write to the viewed tensor reaches the view's copies
+      A.Set(Location({4, 1}), -4);
+      BB.RedistFrom(V);
+      views &= RedistResultHits() == hits + 1 && BB.Get(Location({1, 1})) == -4;
+    }
+    test &= Report("views", views, comm);
+
+    // Contracting the same operand again redistributes the same partition
+    // views of it, which are served from the cache
+    DistTensor<double> X(ObjShape({6, 8}), "[(0),(1)]", g);
+    DistTensor<double> Y(ObjShape({8, 10}), "[(0),(1)]", g);
+    DistTensor<double> Z1(ObjShape({6, 10}), "[(0),(1)]", g), Z2(ObjShape({6, 10}), "[(0),(1)]", g);
+    MakeUniform(X);
+    MakeUniform(Y);
+    const std::vector<Unsigned> blkSizes(1, 2);
+    GenContract(1.0, X, "ab", Y, "bc", 0.0, Z1, "ac", blkSizes);
+    hits = RedistResultHits();
+    GenContract(1.0, X, "ab", Y, "bc", 0.0, Z2, "ac", blkSizes);
+    test &= Report("GenContract", RedistResultHits() > hits && Equal(Z1, Z2), comm);
+
+    // Copies larger than the limit are not kept
+    SetRedistResultCacheLimit(1);
+    Fill(A, 6);
+    B.RedistFrom(A);
+    B.RedistFrom(A);
+    test &= Report("small limit", Check(B, 6), comm);
+    SetRedistResultCacheLimit(0);
+  } catch( std::exception& e ) {
+    test = false;
+    ReportException(e);
+  }
+  if (rank == 0) {
+    std::cout << "RedistCacheTest: " << (test ? "SUCCESS" : "FAILURE") << "\n";
+  }
+  Finalize();
+  return 0;
+}
@@ -0,0 +1,134 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+// NOTE: It is possible to simply include "rote.hpp" instead
+#include "rote.hpp"
+#include <iostream>
+
+using namespace rote;
+
+void Usage(){
+  std::cout << "./RedistHandleTest\n"
+    << "Executes planned redistributions repeatedly, with fresh source data\n"
+    << "each time, and checks each result against RedistFrom.  Also checks\n"
+    << "that a handle refuses tensors laid out differently than planned.\n";
+}
+
+void Fill(DistTensor<double>& A, const Unsigned gen) {
+  const ObjShape s = A.Shape();
+  for (Unsigned i = 0; i < prod(s); i++) {
+    const Location l = LinearLoc2Loc(i, s);
+    A.Set(l, Loc2LinearLoc(l, s) % 17 + 100.0 * gen);
+  }
+}
+
+// Get is collective, so every process visits every entry
+bool Equal(const DistTensor<double>& X, const DistTensor<double>& Y) {
+  bool test = true;
+  const ObjShape s = X.Shape();
+  for (Unsigned i = 0; i < prod(s); i++) {
+    const Location l = LinearLoc2Loc(i, s);
+    test &= Abs(X.Get(l) - Y.Get(l)) <= 1e-12 * (1 + Abs(Y.Get(l)));
+  }
+  return test;
+}
+
+bool Report(const char* name, const bool test, mpi::Comm comm) {
+  Unsigned rL = test ? 1 : 0;
+  Unsigned rG;
+  mpi::AllReduce(&rL, &rG, 1, mpi::LOGICAL_AND, comm);
+  if (rG != 1 && mpi::CommRank(comm) == 0) {
+    std::cout << "RedistHandle " << name << " FAILURE\n";
+  }
+  return rG == 1;
+}
+
+// Runs the handle and RedistFrom side by side over several generations of
+// A, starting both targets from the same data so beta is checked too
+bool TestRepeated(const Grid& g, DistTensor<double>& A, DistTensor<double>& B, const ModeArray& reduceModes, const double alpha, const double beta) {
+  bool test = true;
+  DistTensor<double> check(B.TensorDist(), g);
+  check.SetLocalPermutation(B.LocalPermutation());
+  check.ResizeTo(B.Shape());
+  Fill(B, 7);
+  Fill(check, 7);
+
+  const RedistHandle<double> handle(B, A, reduceModes);
+  for (Unsigned gen = 0; gen < 3; gen++) {
+    Fill(A, gen);
+    handle.Execute(B, A, alpha, beta);
+    check.RedistFrom(A, reduceModes, alpha, beta);
+    test &= Equal(B, check);
+  }
+  return test;
+}
+
+int
+main( int argc, char* argv[] )
+{
+  bool test = true;
+  Initialize(argc, argv);
+  mpi::Comm comm = mpi::COMM_WORLD;
+  const int p = mpi::CommSize(comm);
+
+  try
+  {
+    if (argc > 1) {
+      Usage();
+      throw ArgException();
+    }
+
+    ObjShape gShape(2, 1);
+    gShape[0] = p % 2 == 0 ? 2 : p;
+    gShape[1] = p / gShape[0];
+    const Grid g(comm, gShape);
+
+    // A transpose of the grid modes, into a permuted target
+    DistTensor<double> A(ObjShape({7, 6}), "[(0),(1)]", g);
+    DistTensor<double> B("[(1),(0)]", g);
+    B.SetLocalPermutation(Permutation({1, 0}));
+    B.ResizeTo(A.Shape());
+    test &= Report("transpose", TestRepeated(g, A, B, ModeArray(), 1.0, 0.0), comm);
+    test &= Report("transpose with alpha and beta", TestRepeated(g, A, B, ModeArray(), 2.0, 3.0), comm);
+
+    // A gather of the whole tensor
+    DistTensor<double> R(ObjShape({7, 6}), "[(),()]", g);
+    test &= Report("gather", TestRepeated(g, A, R, ModeArray(), 1.0, 0.0), comm);
+
+    // A reduction over a mode
+    DistTensor<double> A3(ObjShape({5, 4, 6}), "[(),(),(0,1)]", g);
+    DistTensor<double> B2(ObjShape({5, 4}), "[(0,1),()]", g);
+    test &= Report("reduction", TestRepeated(g, A3, B2, ModeArray({2}), 1.0, 0.5), comm);
+
+    // Tensors laid out differently than planned are refused by the handle
+    // itself, before any step of the plan runs
+    const RedistHandle<double> handle(B, A);
+    DistTensor<double> other(ObjShape({7, 6}), "[(0,1),()]", g);
+    Unsigned refused = 0;
+    for (Unsigned i = 0; i < 2; i++) {
+      try {
+        if (i == 0) {
+          handle.Execute(other, A);
+        } else {
+          handle.Execute(B, other);
+        }
+      } catch (std::logic_error& e) {
+        refused += std::string(e.what()).find("RedistHandle") == 0 ? 1 : 0;
+      }
+    }
+    test &= Report("mismatch", refused == 2, comm);
+  } catch( std::exception& e ) {
+    test = false;
+    ReportException(e);
+  }
+  if (mpi::CommRank(comm) == 0) {
+    std::cout << "RedistHandleTest: " << (test ? "SUCCESS" : "FAILURE") << "\n";
+  }
+  Finalize();
+  return 0;
+}
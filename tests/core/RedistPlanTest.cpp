@@ -0,0 +1,123 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+// NOTE: It is possible to simply include "rote.hpp" instead
+#include "rote.hpp"
+#include <iostream>
+
+using namespace rote;
+
+void Usage(){
+  std::cout << "./RedistPlanTest\n"
+    << "Checks that the search over intermediate distributions finds plans\n"
+    << "cheaper than the greedy passes where the greedy passes need an extra\n"
+    << "Perm, and that every searched plan gives the greedy plan's result.\n";
+}
+
+void Fill(DistTensor<double>& A) {
+  const ObjShape s = A.Shape();
+  for (Unsigned i = 0; i < prod(s); i++) {
+    const Location l = LinearLoc2Loc(i, s);
+    A.Set(l, Loc2LinearLoc(l, s) % 17 + 1.0);
+  }
+}
+
+// Get is collective, so every process visits every entry
+bool Equal(const DistTensor<double>& X, const DistTensor<double>& Y) {
+  bool test = true;
+  const ObjShape s = X.Shape();
+  for (Unsigned i = 0; i < prod(s); i++) {
+    const Location l = LinearLoc2Loc(i, s);
+    test &= Abs(X.Get(l) - Y.Get(l)) <= 1e-12 * (1 + Abs(Y.Get(l)));
+  }
+  return test;
+}
+
+bool Report(const char* name, const bool test, mpi::Comm comm) {
+  Unsigned rL = test ? 1 : 0;
+  Unsigned rG;
+  mpi::AllReduce(&rL, &rG, 1, mpi::LOGICAL_AND, comm);
+  if (rG != 1 && mpi::CommRank(comm) == 0) {
+    std::cout << "RedistPlan " << name << " FAILURE\n";
+  }
+  return rG == 1;
+}
+
+// Plans dA -> dB with and without the search, requiring the searched plan
+// to cost no more (strictly less if cheaper) and to give the same result
+bool TestSearch(const Grid& g, const ObjShape& shapeA, const std::string& distA, const std::string& distB, const ModeArray& reduceModes, const bool cheaper) {
+  const TensorDistribution dA(distA);
+  const TensorDistribution dB(distB);
+  const Unsigned limit = RedistPlanSearchLimit();
+  ObjShape shapeB = shapeA;
+  for (Unsigned i = reduceModes.size() - 1; i < reduceModes.size(); i--) {
+    shapeB.erase(shapeB.begin() + reduceModes[i]);
+  }
+  DistTensor<double> A(shapeA, dA, g);
+  Fill(A);
+
+  SetRedistPlanSearchLimit(0);
+  const RedistPlan greedy(dB, dA, reduceModes, g, shapeA, sizeof(double));
+  DistTensor<double> greedyB(shapeB, dB, g);
+  greedyB.RedistFrom(A, reduceModes, 1.0, 0.0);
+
+  SetRedistPlanSearchLimit(limit);
+  const RedistPlan searched(dB, dA, reduceModes, g, shapeA, sizeof(double));
+  DistTensor<double> searchedB(shapeB, dB, g);
+  searchedB.RedistFrom(A, reduceModes, 1.0, 0.0);
+
+  bool test = cheaper ? searched.Cost() < greedy.Cost() : searched.Cost() <= greedy.Cost();
+  test &= Equal(searchedB, greedyB);
+  return test;
+}
+
+int
+main( int argc, char* argv[] )
+{
+  bool test = true;
+  Initialize(argc, argv);
+  mpi::Comm comm = mpi::COMM_WORLD;
+  const int p = mpi::CommSize(comm);
+
+  try
+  {
+    if (argc > 1) {
+      Usage();
+      throw ArgException();
+    }
+
+    ObjShape gShape(2, 1);
+    gShape[0] = p % 2 == 0 ? 2 : p;
+    gShape[1] = p / gShape[0];
+    const Grid g(comm, gShape);
+    const ObjShape shape2({13, 10});
+    const ModeArray noReduce;
+
+    // The greedy passes add both grid modes in one Local step and then
+    // reorder them with a Perm; adding them one at a time needs no Perm
+    test &= Report("ordered adds", TestSearch(g, shape2, "[(),()]", "[(1,0),()]", noReduce, true), comm);
+
+    // The greedy passes move both grid modes in one AllToAll and then
+    // reorder them with a Perm; two AllToAlls over one grid mode each are
+    // cheaper than that under the default model
+    test &= Report("ordered moves", TestSearch(g, shape2, "[(),(0,1)]", "[(1,0),()]", noReduce, true), comm);
+
+    // Elsewhere the searched plans only have to match the greedy results
+    test &= Report("transpose", TestSearch(g, shape2, "[(0),(1)]", "[(1),(0)]", noReduce, false), comm);
+    test &= Report("gather", TestSearch(g, shape2, "[(1),(0)]", "[(),(1)]", noReduce, false), comm);
+    test &= Report("reduction", TestSearch(g, ObjShape({7, 6, 5}), "[(),(0),(1)]", "[(1,0),()]", ModeArray({2}), false), comm);
+  } catch( std::exception& e ) {
+    test = false;
+    ReportException(e);
+  }
+  if (mpi::CommRank(comm) == 0) {
+    std::cout << "RedistPlanTest: " << (test ? "SUCCESS" : "FAILURE") << "\n";
+  }
+  Finalize();
+  return 0;
+}
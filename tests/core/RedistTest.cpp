@@ -16,7 +16,16 @@
 using namespace rote;
 
 void Usage(){
-  std::cout << "./testRedist <cfg>\n"
+  std::cout << "./testRedist <cfg> [ranksPerNode] [zeroCopy]\n"
+    << "Each redistribution runs into B in its default local permutation with\n"
+    << "alpha = 2, beta = 0 and into B in a rotated local permutation with\n"
+    << "alpha = 2, beta = 3\n"
+    << "Unless zeroCopy is set, the rotated runs are repeated under a memory\n"
+    << "  limit of four entries, so AllToAll/AllGather steps run in rounds,\n"
+    << "  and those with such steps again with B realigned\n"
+    << "ranksPerNode > 0 routes collectives through nodes of that many ranks\n"
+    << "zeroCopy != 0 sends AllToAll/AllGather steps of any size straight\n"
+    << "  between the tensor buffers (tests then use alpha = 1, beta = 0)\n"
     << "<cfg> format:\n"
     << "<orderG> <shapeG> <orderT> <shapeT> <distB> <distA>\n";
 }
@@ -154,6 +163,21 @@ T Sum(const DistTensor<T>& A, const Location& lA, const ModeArray& modes) {
   return sum;
 }
 
+// Initial value of B, the same on every process holding the entry
+template<typename T>
+T InitialB(const Location& l, const ObjShape& s) {
+  return T(Loc2LinearLoc(l, s) % 13 + 1);
+}
+
+template<typename T>
+void SetInitialB(DistTensor<T>& B) {
+  const ObjShape sB = B.Shape();
+  for(Unsigned i = 0; i < prod(sB); i++) {
+    const Location l = LinearLoc2Loc(i, sB);
+    B.Set(l, InitialB<T>(l, sB));
+  }
+}
+
 template<typename T>
 bool Test(const DistTensor<T>& B, const DistTensor<T>& A, const ModeArray& reduceModes, const T alpha, const T beta) {
   bool test = true;
@@ -168,11 +192,11 @@ bool Test(const DistTensor<T>& B, const DistTensor<T>& A, const ModeArray& reduc
   while(mB != oB) {
     Location lA = InsertUnitModes(lB, reduceModes);
 
-    T check = alpha * (reduceModes.empty() ? A.Get(lA) : Sum(A, lA, reduceModes));
+    T check = alpha * (reduceModes.empty() ? A.Get(lA) : Sum(A, lA, reduceModes)) + beta * InitialB<T>(lB, sB);
     T vB = B.Get(lB);
     // std::cout << "check: " << check << " vB: " << vB << std::endl;
-    double epsilon = 1E-6;
-    if (vB - check > epsilon) {
+    double epsilon = 1E-4;
+    if (Abs(double(vB) - double(check)) > epsilon * (1 + Abs(double(check)))) {
       test = false;
       break;
     }
@@ -208,18 +232,79 @@ int nElem(const ObjShape& s) {
   return n;
 }
 
+// Rotates the local modes of B one place, or keeps the default permutation
 template<typename T>
-bool TestRedist(const Grid& g, const Params& params) {
+bool TestRedist(const Grid& g, const Params& params, const bool rotateB, const T alpha, const T beta) {
   ObjShape shapeB(params.sT.size() - params.reduceModes.size(), params.sT[0]);
-  DistTensor<T> B(shapeB, params.dB, g), A(params.sT, params.dA, g);
+  DistTensor<T> B(params.dB, g), A(params.sT, params.dA, g);
+  if (rotateB) {
+    std::vector<Unsigned> perm(shapeB.size());
+    for(Unsigned i = 0; i < perm.size(); i++) {
+      perm[i] = (i + 1) % perm.size();
+    }
+    B.SetLocalPermutation(Permutation(perm));
+  }
+  B.ResizeTo(shapeB);
   MakeUniform(A);
+  SetInitialB(B);
 
-  T alpha = T(2);
-  T beta = T(0);
   B.RedistFrom(A, params.reduceModes, alpha, beta);
   return Test<T>(B, A, params.reduceModes, alpha, beta);
 }
 
+// Whether the plan from A to B has a step that RedistMemoryLimit() may split
+bool HasChunkableStep(const Grid& g, const Params& params, const Unsigned elemSize) {
+  std::shared_ptr<const RedistPlan> plan = CachedRedistPlan(params.dB, params.dA, params.reduceModes, g, params.sT, elemSize);
+  for(Unsigned i = 0; i < plan->size(); i++) {
+    if ((*plan)[i].type() == A2A || (*plan)[i].type() == AG) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Runs the redistribution into a rotated B twice, once as is and once under
+// a memory limit of a few entries, and checks both against A and each other.
+// With realign, B is aligned one process along every distributed mode, so
+// each chunk also goes through the realignment buffers.
+template<typename T>
+bool TestChunkedRedist(const Grid& g, const Params& params, const bool realign, const T alpha, const T beta) {
+  const Unsigned order = params.sT.size() - params.reduceModes.size();
+  ObjShape shapeB(order, params.sT[0]);
+  std::vector<Unsigned> aligns(order, 0);
+  std::vector<Unsigned> perm(order);
+  for(Unsigned i = 0; i < order; i++) {
+    const ModeArray gridModes = params.dB[i].Entries();
+    const Unsigned n = gridModes.empty() ? 1 : prod(FilterVector(g.Shape(), gridModes));
+    aligns[i] = realign ? 1 % n : 0;
+    perm[i] = (i + 1) % order;
+  }
+  DistTensor<T> A(params.sT, params.dA, g);
+  DistTensor<T> B(shapeB, params.dB, aligns, g), chunkedB(shapeB, params.dB, aligns, g);
+  B.SetLocalPermutation(Permutation(perm));
+  chunkedB.SetLocalPermutation(Permutation(perm));
+  MakeUniform(A);
+  SetInitialB(B);
+  SetInitialB(chunkedB);
+
+  B.RedistFrom(A, params.reduceModes, alpha, beta);
+  const std::size_t rounds = RedistChunkRounds();
+  PushRedistMemoryLimit(4 * sizeof(T));
+  chunkedB.RedistFrom(A, params.reduceModes, alpha, beta);
+  PopRedistMemoryLimit();
+
+  // Get is collective, so every process visits every entry
+  bool test = !HasChunkableStep(g, params, sizeof(T)) || RedistChunkRounds() - rounds > 1;
+  for(Unsigned i = 0; i < prod(shapeB); i++) {
+    const Location l = LinearLoc2Loc(i, shapeB);
+    test &= B.Get(l) == chunkedB.Get(l);
+  }
+  Unsigned rL = test ? 1 : 0;
+  Unsigned rG;
+  mpi::AllReduce(&rL, &rG, 1, mpi::LOGICAL_AND, mpi::COMM_WORLD);
+  return rG == 1 && Test<T>(chunkedB, A, params.reduceModes, alpha, beta);
+}
+
 std::vector<std::string> SplitLine(const std::string& s, char delim='\t') {
   std::vector<std::string> items;
 
@@ -246,6 +331,11 @@ main( int argc, char* argv[] )
     }
 
     std::ifstream cfg(argv[1]);
+    const int ranksPerNode = argc > 2 ? atoi(argv[2]) : 0;
+    const bool zeroCopy = argc > 3 && atoi(argv[3]) != 0;
+    if (zeroCopy) {
+      SetZeroCopyRedistThreshold(0);
+    }
     std::string line;
 
     int testNum = 0;
@@ -274,10 +364,25 @@ main( int argc, char* argv[] )
         throw ArgException();
       }
 
-      const Grid g(comm, params.sG);
-      test &= TestRedist<double>(g, params);
-      test &= TestRedist<float>(g, params);
-      test &= TestRedist<int>(g, params);
+      Grid g(comm, params.sG);
+      if (ranksPerNode > 0)
+        g.SetNodeAwareCollectives(true, ranksPerNode);
+      const int alpha = zeroCopy ? 1 : 2;
+      const int beta = zeroCopy ? 0 : 3;
+      test &= TestRedist<double>(g, params, false, alpha, 0);
+      test &= TestRedist<float>(g, params, false, alpha, 0);
+      test &= TestRedist<int>(g, params, false, alpha, 0);
+      test &= TestRedist<double>(g, params, true, alpha, beta);
+      test &= TestRedist<float>(g, params, true, alpha, beta);
+      test &= TestRedist<int>(g, params, true, alpha, beta);
+      if (!zeroCopy) {
+        test &= TestChunkedRedist<double>(g, params, false, alpha, beta);
+        // Reductions with nothing to communicate do not realign B
+        if (HasChunkableStep(g, params, sizeof(double))) {
+          test &= TestChunkedRedist<double>(g, params, true, alpha, beta);
+          test &= TestChunkedRedist<int>(g, params, true, alpha, beta);
+        }
+      }
 
       if (testNum % 100 == 0 && mpi::CommRank(comm) == 0) {
         std::cout << "Finished " << testNum << " tests\n";
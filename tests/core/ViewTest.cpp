@@ -0,0 +1,125 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+// NOTE: It is possible to simply include "rote.hpp" instead
+#include "rote.hpp"
+#include <iostream>
+
+using namespace rote;
+
+void Usage(){
+  std::cout << "./ViewTest\n"
+    << "Takes views, partitions and 2x1 merges of DistTensors stored in every\n"
+    << "local permutation and checks each entry against the viewed tensor.\n";
+}
+
+double Entry(const Location& l, const ObjShape& s) {
+  return Loc2LinearLoc(l, s) + 1;
+}
+
+// Whether V holds the entries of A starting at offset
+bool CheckView(const DistTensor<double>& V, const DistTensor<double>& A, const Location& offset) {
+  bool test = true;
+  const ObjShape s = V.Shape();
+  for (Unsigned i = 0; i < prod(s); i++) {
+    const Location l = LinearLoc2Loc(i, s);
+    test &= V.Get(l) == A.Get(ElemwiseSum(l, offset));
+  }
+  return test;
+}
+
+bool Report(const std::string& name, const bool test, mpi::Comm comm) {
+  Unsigned rL = test ? 1 : 0;
+  Unsigned rG;
+  mpi::AllReduce(&rL, &rG, 1, mpi::LOGICAL_AND, comm);
+  if (rG != 1 && mpi::CommRank(comm) == 0) {
+    std::cout << "View " << name << " FAILURE\n";
+  }
+  return rG == 1;
+}
+
+bool TestPermutation(const Grid& g, const Permutation& perm, mpi::Comm comm) {
+  bool test = true;
+  const ObjShape shape = {7, 6, 5};
+  DistTensor<double> A("[(0),(1),()]", g);
+  A.SetLocalPermutation(perm);
+  A.ResizeTo(shape);
+  for (Unsigned i = 0; i < prod(shape); i++) {
+    const Location l = LinearLoc2Loc(i, shape);
+    A.Set(l, Entry(l, shape));
+  }
+
+  // Offsets that shift every mode by a different amount than its extent
+  const Location loc = {3, 1, 2};
+  const ObjShape viewShape = {4, 4, 2};
+  DistTensor<double> V(A.TensorDist(), g);
+  View(V, A, loc, viewShape);
+  DistTensor<double> LV(A.TensorDist(), g);
+  LockedView(LV, A, loc, viewShape);
+  test &= Report("offset", CheckView(V, A, loc) && CheckView(LV, A, loc), comm);
+
+  // Writes through a view land in the viewed entries
+  V.Set(Location(3, 0), -1);
+  test &= Report("write", A.Get(loc) == -1, comm);
+  A.Set(loc, Entry(loc, shape));
+
+  // Partitioning a mode and merging the halves gives A back
+  for (Mode mode = 0; mode < A.Order(); mode++) {
+    DistTensor<double> AT(A.TensorDist(), g), AB(A.TensorDist(), g);
+    LockedPartitionDown(A, AT, AB, mode, 3);
+    Location offsetB(A.Order(), 0);
+    offsetB[mode] = 3;
+    bool parts = CheckView(AT, A, Location(A.Order(), 0)) && CheckView(AB, A, offsetB);
+
+    DistTensor<double> M(A.TensorDist(), g), LM(A.TensorDist(), g);
+    View2x1(M, AT, AB, mode);
+    LockedView2x1(LM, AT, AB, mode);
+    parts &= M.Shape() == shape && CheckView(M, A, Location(A.Order(), 0));
+    parts &= CheckView(LM, A, Location(A.Order(), 0));
+    test &= Report("2x1 merge along mode " + std::to_string(mode), parts, comm);
+  }
+  return test;
+}
+
+int
+main( int argc, char* argv[] )
+{
+  bool test = true;
+  Initialize(argc, argv);
+  mpi::Comm comm = mpi::COMM_WORLD;
+  const int p = mpi::CommSize(comm);
+
+  try
+  {
+    if (argc > 1) {
+      Usage();
+      throw ArgException();
+    }
+
+    ObjShape gShape(2, 1);
+    gShape[0] = p % 2 == 0 ? 2 : p;
+    gShape[1] = p / gShape[0];
+    const Grid g(comm, gShape);
+
+    const std::vector<Permutation> perms = {
+      Permutation({0, 1, 2}), Permutation({2, 0, 1}),
+      Permutation({1, 2, 0}), Permutation({2, 1, 0})
+    };
+    for (Unsigned i = 0; i < perms.size(); i++) {
+      test &= TestPermutation(g, perms[i], comm);
+    }
+  } catch( std::exception& e ) {
+    test = false;
+    ReportException(e);
+  }
+  if (mpi::CommRank(comm) == 0) {
+    std::cout << "ViewTest: " << (test ? "SUCCESS" : "FAILURE") << "\n";
+  }
+  Finalize();
+  return 0;
+}
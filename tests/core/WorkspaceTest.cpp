@@ -0,0 +1,124 @@
+/*
+   Copyright (c) 2009-2013, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+// NOTE: It is possible to simply include "rote.hpp" instead
+#include "rote.hpp"
+#include <iostream>
+
+using namespace rote;
+
+void Usage(){
+  std::cout << "./WorkspaceTest\n"
+    << "Checks the hits, misses and retained bytes of the workspace pool\n"
+    << "under a fixed retention limit, after Trim, and under the default\n"
+    << "limit, which must keep a working set larger than 64 MiB.\n";
+}
+
+bool Report(const char* name, const bool test, mpi::Comm comm) {
+  Unsigned rL = test ? 1 : 0;
+  Unsigned rG;
+  mpi::AllReduce(&rL, &rG, 1, mpi::LOGICAL_AND, comm);
+  if (rG != 1 && mpi::CommRank(comm) == 0) {
+    std::cout << "Workspace " << name << " FAILURE\n";
+  }
+  return rG == 1;
+}
+
+std::size_t Bytes(const Memory<double>& m) {
+  return m.Size() * sizeof(double);
+}
+
+bool Counts(const std::size_t hits, const std::size_t misses, const std::size_t retainedBytes) {
+  const WorkspaceStats stats = Workspace::Stats();
+  return stats.hits == hits && stats.misses == misses && stats.retainedBytes == retainedBytes;
+}
+
+int
+main( int argc, char* argv[] )
+{
+  bool test = true;
+  Initialize(argc, argv);
+  mpi::Comm comm = mpi::COMM_WORLD;
+
+  try
+  {
+    if (argc > 1) {
+      Usage();
+      throw ArgException();
+    }
+
+    // Nothing is kept without retention
+    Workspace::SetRetainLimit(0);
+    Workspace::ResetStats();
+    Memory<double> a(1000);
+    a.Empty();
+    test &= Report("no retention", Counts(0, 1, 0) && Workspace::RetainLimit() == 0, comm);
+
+    // A returned buffer serves smaller requests of up to half its size
+    Workspace::SetRetainLimit(std::size_t(1) << 20);
+    a.Require(1000);
+    const std::size_t aBytes = Bytes(a);
+    a.Empty();
+    bool fixed = Counts(0, 2, aBytes);
+    Memory<double> b(900);
+    fixed &= Counts(1, 2, 0) && Bytes(b) == aBytes;
+    Memory<double> c(4000);
+    const std::size_t cBytes = Bytes(c);
+    fixed &= Counts(1, 3, 0);
+    b.Empty();
+    c.Empty();
+    fixed &= Counts(1, 3, aBytes + cBytes) && Workspace::Stats().inUseBytes == 0;
+    test &= Report("fixed limit", fixed, comm);
+
+    // Trim frees everything retained, so the next request misses
+    Workspace::Trim();
+    bool trimmed = Counts(1, 3, 0);
+    a.Require(1000);
+    trimmed &= Counts(1, 4, 0);
+    a.Empty();
+    test &= Report("trim", trimmed, comm);
+
+    // By default a working set of any size is kept for the next iteration
+    const Unsigned nBuffers = 3;
+    const std::size_t bufferSize = (std::size_t(24) << 20) / sizeof(double);
+    std::vector<Memory<double> > buffers(nBuffers);
+    for (Unsigned i = 0; i < nBuffers; i++) {
+      buffers[i].Empty();
+    }
+    Workspace::SetRetainLimit(Workspace::HighWaterMark);
+    Workspace::Trim();
+    Workspace::ResetStats();
+    std::size_t workingSet = 0;
+    for (Unsigned iter = 0; iter < 2; iter++) {
+      for (Unsigned i = 0; i < nBuffers; i++) {
+        buffers[i].Require(bufferSize);
+      }
+      workingSet = 0;
+      for (Unsigned i = 0; i < nBuffers; i++) {
+        workingSet += Bytes(buffers[i]);
+        buffers[i].Empty();
+      }
+    }
+    bool highWater = Counts(nBuffers, nBuffers, workingSet);
+    highWater &= workingSet > (std::size_t(64) << 20) && Workspace::RetainLimit() >= workingSet;
+    test &= Report("high-water retention", highWater, comm);
+
+    // Lowering the limit below what is kept frees it
+    Workspace::SetRetainLimit(workingSet / 2);
+    test &= Report("lowered limit", Workspace::Stats().retainedBytes == 0, comm);
+    Workspace::SetRetainLimit(Workspace::HighWaterMark);
+  } catch( std::exception& e ) {
+    test = false;
+    ReportException(e);
+  }
+  if (mpi::CommRank(comm) == 0) {
+    std::cout << "WorkspaceTest: " << (test ? "SUCCESS" : "FAILURE") << "\n";
+  }
+  Finalize();
+  return 0;
+}